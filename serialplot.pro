@@ -23,7 +23,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui serialport network svg
+QT       += core gui serialport network svg concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -42,6 +42,7 @@ SOURCES += \
     src/mainwindow.cpp \
     src/portcontrol.cpp \
     src/plot.cpp \
+    src/plotcurve.cpp \
     src/zoomer.cpp \
     src/scrollzoomer.cpp \
     src/scrollbar.cpp \
@@ -96,7 +97,38 @@ SOURCES += \
     src/samplecounter.cpp \
     src/ledwidget.cpp \
     src/datatextview.cpp \
-    src/bpslabel.cpp
+    src/bpslabel.cpp \
+    src/trigger.cpp \
+    src/triggerpanel.cpp \
+    src/fft.cpp \
+    src/spectrum.cpp \
+    src/spectrumview.cpp \
+    src/waterfall.cpp \
+    src/channelstats.cpp \
+    src/filter.cpp \
+    src/expression.cpp \
+    src/mathchannels.cpp \
+    src/calibration.cpp \
+    src/merger.cpp \
+    src/threadrelay.cpp \
+    src/inputport.cpp \
+    src/portspanel.cpp \
+    src/udpdevice.cpp \
+    src/pipedevice.cpp \
+    src/bufferedinputdevice.cpp \
+    src/mappedbuffer.cpp \
+    src/sessioncheckpoint.cpp \
+    src/checksum.cpp \
+    src/framelayout.cpp \
+    src/framelayoutedit.cpp \
+    src/bytestuffing.cpp \
+    src/packetreader.cpp \
+    src/packetreadersettings.cpp \
+    src/alignmentdetector.cpp \
+    src/keyvalueparser.cpp \
+    src/networkcontrol.cpp \
+    src/headless.cpp \
+    src/filterpanel.cpp
 
 HEADERS += \
     src/mainwindow.h \
@@ -104,6 +136,7 @@ HEADERS += \
     src/portcontrol.h \
     src/byteswap.h \
     src/plot.h \
+    src/plotcurve.h \
     src/hidabletabwidget.h \
     src/framebuffer.h \
     src/scalepicker.h \
@@ -140,6 +173,37 @@ HEADERS += \
     src/demoreadersettings.h \
     src/datatextview.h \
     src/bpslabel.h \
+    src/trigger.h \
+    src/triggerpanel.h \
+    src/fft.h \
+    src/spectrum.h \
+    src/spectrumview.h \
+    src/waterfall.h \
+    src/channelstats.h \
+    src/filter.h \
+    src/expression.h \
+    src/mathchannels.h \
+    src/calibration.h \
+    src/merger.h \
+    src/threadrelay.h \
+    src/inputport.h \
+    src/portspanel.h \
+    src/udpdevice.h \
+    src/pipedevice.h \
+    src/bufferedinputdevice.h \
+    src/mappedbuffer.h \
+    src/sessioncheckpoint.h \
+    src/checksum.h \
+    src/framelayout.h \
+    src/framelayoutedit.h \
+    src/bytestuffing.h \
+    src/packetreader.h \
+    src/packetreadersettings.h \
+    src/alignmentdetector.h \
+    src/keyvalueparser.h \
+    src/networkcontrol.h \
+    src/headless.h \
+    src/filterpanel.h \
     src/barchart.h \
     src/barplot.h \
     src/barscaledraw.h \
@@ -181,7 +245,10 @@ FORMS += \
     src/recordpanel.ui \
     src/updatecheckdialog.ui \
     src/demoreadersettings.ui \
-    src/datatextview.ui
+    src/datatextview.ui \
+    src/triggerpanel.ui \
+    src/filterpanel.ui \
+    src/packetreadersettings.ui
 
 INCLUDEPATH += qmake/ src/
 
@@ -24,6 +24,7 @@ AbstractReader::AbstractReader(QIODevice* device, QObject* parent) :
 {
     _device = device;
     bytesRead = 0;
+    _enabled = false;
 }
 
 void AbstractReader::pause(bool enabled)
@@ -33,6 +34,7 @@ void AbstractReader::pause(bool enabled)
 
 void AbstractReader::enable(bool enabled)
 {
+    _enabled = enabled;
     if (enabled)
     {
         QObject::connect(_device, &QIODevice::readyRead,
@@ -45,6 +47,17 @@ void AbstractReader::enable(bool enabled)
     }
 }
 
+void AbstractReader::setDevice(QIODevice* device)
+{
+    if (_enabled)
+    {
+        QObject::disconnect(_device, 0, this, 0);
+        QObject::connect(device, &QIODevice::readyRead,
+                         this, &AbstractReader::onDataReady);
+    }
+    _device = device;
+}
+
 void AbstractReader::onDataReady()
 {
     bytesRead += readData();
@@ -46,6 +46,12 @@ public:
     /// 'disabled'.
     virtual void enable(bool enabled = true);
 
+    /**
+     * Changes the device that reader reads from. Can be called while
+     * reader is enabled.
+     */
+    virtual void setDevice(QIODevice* device);
+
     /// None of the current readers support X channel at the moment
     bool hasX() const final { return false; };
 
@@ -82,6 +88,7 @@ protected:
 
 private:
     unsigned bytesRead;
+    bool _enabled;
 
 private slots:
     void onDataReady();
@@ -0,0 +1,147 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <QVector>
+#include <algorithm>
+
+#include "alignmentdetector.h"
+
+/// Minimum confidence to change the alignment or lock
+const double MIN_CONFIDENCE = 0.5;
+/// Current alignment must be this much rougher than best to change it
+const double SWITCH_MARGIN = 1.5;
+/// Roughness limit, about twice of random data
+const double MAX_ROUGHNESS = 2.0;
+
+AlignmentDetector::AlignmentDetector()
+{
+    reset();
+}
+
+void AlignmentDetector::reset()
+{
+    locked = false;
+    _confidence = 0;
+    lastCheck.invalidate();
+}
+
+bool AlignmentDetector::isCheckDue() const
+{
+    return !locked || !lastCheck.isValid() || lastCheck.hasExpired(RECHECK_INTERVAL);
+}
+
+bool AlignmentDetector::isLocked() const
+{
+    return locked;
+}
+
+double AlignmentDetector::confidence() const
+{
+    return _confidence;
+}
+
+unsigned AlignmentDetector::check(const FrameLayout& layout, const uchar* data, unsigned size)
+{
+    unsigned psize = layout.size();
+    size = std::min(size, MAX_WINDOW + psize - 1);
+    if (size < psize - 1) return 0;
+    // same number of packages for all offsets
+    unsigned n = (size - (psize - 1)) / psize;
+    if (n < MIN_PACKAGES) return 0;
+
+    lastCheck.start();
+
+    // nothing to detect
+    if (psize == 1)
+    {
+        locked = true;
+        _confidence = 1;
+        return 0;
+    }
+
+    SamplePack samples(n * layout.setsPerPackage(), layout.numChannels());
+    QVector<double> scores(psize);
+    for (unsigned offset = 0; offset < psize; offset++)
+    {
+        scores[offset] = roughness(layout, data + offset, n, &samples);
+    }
+
+    unsigned best = std::min_element(scores.begin(), scores.end()) - scores.begin();
+
+    // typical offset is misaligned, compare with it
+    QVector<double> sorted = scores;
+    std::sort(sorted.begin(), sorted.end());
+    double median = sorted[psize / 2];
+    _confidence = median > 0 ? 1 - scores[best] / median : 0;
+
+    if (_confidence < MIN_CONFIDENCE)
+    {
+        // keep the lock if signal became hard to judge (ex: flat)
+        return 0;
+    }
+
+    // channel rotations score about the same, don't switch for those
+    if (best != 0 && scores[0] > scores[best] * SWITCH_MARGIN)
+    {
+        locked = true;
+        return best;
+    }
+
+    locked = scores[0] <= scores[best] * SWITCH_MARGIN;
+    return 0;
+}
+
+double AlignmentDetector::roughness(const FrameLayout& layout, const uchar* data,
+                                    unsigned n, SamplePack* samples)
+{
+    Q_ASSERT(n >= 2);
+    Q_ASSERT(samples->numSamples() >= n * layout.setsPerPackage());
+
+    layout.decode(data, n, samples);
+    n *= layout.setsPerPackage();
+
+    unsigned nc = layout.numChannels();
+    double total = 0;
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        const double* x = samples->data(ci);
+        double sum = 0, sumSq = 0, sumDiff = 0;
+        for (unsigned i = 0; i < n; i++)
+        {
+            sum += x[i];
+            sumSq += x[i] * x[i];
+            if (i) sumDiff += fabs(x[i] - x[i-1]);
+        }
+
+        // mean difference relative to standard deviation, ~1.13 for
+        // random data and close to 0 for smooth signals
+        double mean = sum / n;
+        double var = sumSq / n - mean * mean;
+        double r = sumDiff / (n - 1) / sqrt(var);
+        if (!std::isfinite(r))
+        {
+            // garbage floats are the roughest, constant is smooth
+            r = std::isfinite(sumSq) && var <= 0 ? 0 : MAX_ROUGHNESS;
+        }
+        total += std::min(r, MAX_ROUGHNESS);
+    }
+
+    return total / nc;
+}
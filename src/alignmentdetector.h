@@ -0,0 +1,89 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ALIGNMENTDETECTOR_H
+#define ALIGNMENTDETECTOR_H
+
+#include <QElapsedTimer>
+
+#include "framelayout.h"
+#include "samplepack.h"
+
+/**
+ * Detects the package alignment of an un-framed binary stream.
+ *
+ * Every byte offset in a package is tried as the package start on a
+ * window of data and scored for smoothness: mean absolute difference
+ * of consecutive samples relative to the standard deviation of the
+ * samples, averaged over channels. Misaligned integers mix high and
+ * low bytes of different samples and misaligned floats produce
+ * garbage, both of which are much rougher than real signals.
+ *
+ * Offsets that only rotate channels of the same type score about the
+ * same, so channel order is changed only if channels are
+ * distinguishable (ex: different number types).
+ */
+class AlignmentDetector
+{
+public:
+    /// Minimum number of packages needed for a check
+    static const unsigned MIN_PACKAGES = 16;
+    /// Window size limit in bytes, keeps checks cheap
+    static const unsigned MAX_WINDOW = 4096;
+    /// Interval of checks once locked, in milliseconds
+    static const int RECHECK_INTERVAL = 1000;
+
+    AlignmentDetector();
+
+    /// Forgets the lock, next check is done immediately
+    void reset();
+
+    /// Returns true if a check should be done
+    bool isCheckDue() const;
+
+    /**
+     * Checks the alignment of `data` which starts at an assumed
+     * package start.
+     *
+     * @return number of bytes to skip for correct alignment, 0 if
+     * already aligned or not confident
+     */
+    unsigned check(const FrameLayout& layout, const uchar* data, unsigned size);
+
+    /// True if current alignment is detected as correct
+    bool isLocked() const;
+    /// Confidence of last check between 0 and 1
+    double confidence() const;
+
+    /**
+     * Returns roughness score of `n` packages, lower is smoother.
+     *
+     * @param samples used as work area, must be sized for `n` packages
+     * (`n * layout.setsPerPackage()` samples)
+     */
+    static double roughness(const FrameLayout& layout, const uchar* data,
+                            unsigned n, SamplePack* samples);
+
+private:
+    bool locked;
+    double _confidence;
+    QElapsedTimer lastCheck;
+};
+
+#endif // ALIGNMENTDETECTOR_H
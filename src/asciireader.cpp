@@ -18,14 +18,17 @@
 */
 
 #include <QtDebug>
+#include <algorithm>
 
+#include "defines.h"
 #include "asciireader.h"
 
 /// If set to this value number of channels is determined from input
 #define NUMOFCHANNELS_AUTO   (0)
 
 AsciiReader::AsciiReader(QIODevice* device, QObject* parent) :
-    AbstractReader(device, parent)
+    AbstractReader(device, parent),
+    kvParser(MAX_NUM_CHANNELS)
 {
     paused = false;
 
@@ -33,10 +36,14 @@ AsciiReader::AsciiReader(QIODevice* device, QObject* parent) :
     autoNumOfChannels = (_numChannels == NUMOFCHANNELS_AUTO);
     delimiter = _settingsWidget.delimiter();
     isHexData = _settingsWidget.isHex();
+    isKeyValue = _settingsWidget.isKeyValue();
+    kvParser.setHex(isHexData);
+    kvParser.setKeys(_settingsWidget.keys());
 
     connect(&_settingsWidget, &AsciiReaderSettings::numOfChannelsChanged,
             [this](unsigned value)
             {
+                if (isKeyValue) return; // channels are determined by keys
                 _numChannels = value;
                 updateNumChannels(); // TODO: setting numchannels = 0, should remove all buffers
                                      // do we want this?
@@ -62,9 +69,27 @@ AsciiReader::AsciiReader(QIODevice* device, QObject* parent) :
             [this](bool hexData)
             {
                 isHexData = hexData;
+                kvParser.setHex(hexData);
+            });
+    connect(&_settingsWidget, &AsciiReaderSettings::keyValueChanged,
+            [this](bool enabled)
+            {
+                isKeyValue = enabled;
+                resetKeyValue();
+            });
+    connect(&_settingsWidget, &AsciiReaderSettings::keysChanged,
+            [this](QStringList keys)
+            {
+                kvParser.setKeys(keys);
+                if (isKeyValue) resetKeyValue();
             });
 }
 
+AsciiReader::~AsciiReader()
+{
+    delete kvSamples;
+}
+
 QWidget* AsciiReader::settingsWidget()
 {
     return &_settingsWidget;
@@ -87,6 +112,14 @@ void AsciiReader::enable(bool enabled)
     AbstractReader::enable(enabled);
 }
 
+void AsciiReader::setDevice(QIODevice* device)
+{
+    // first line from new device may be partial
+    firstReadAfterEnable = true;
+
+    AbstractReader::setDevice(device);
+}
+
 unsigned AsciiReader::readData()
 {
     unsigned numBytesRead = 0;
@@ -136,6 +169,12 @@ unsigned AsciiReader::readData()
                 break;
         }
 
+        if (isKeyValue)
+        {
+            readKeyValueLine(line);
+            continue;
+        }
+
         const SamplePack* samples = parseLine(line);
         if (samples != nullptr) {
             // update number of channels if in auto mode
@@ -160,6 +199,65 @@ unsigned AsciiReader::readData()
     return numBytesRead;
 }
 
+void AsciiReader::resetKeyValue()
+{
+    delete kvSamples;
+    kvSamples = nullptr;
+
+    unsigned nc = isKeyValue ? kvParser.numChannels() : _settingsWidget.numOfChannels();
+    autoNumOfChannels = !isKeyValue && (nc == NUMOFCHANNELS_AUTO);
+    if (nc != _numChannels)
+    {
+        _numChannels = nc;
+        updateNumChannels();
+        if (nc != NUMOFCHANNELS_AUTO) emit numOfChannelsChanged(nc);
+    }
+}
+
+void AsciiReader::readKeyValueLine(const QString& line)
+{
+    int n = kvParser.parse(line);
+    if (n < 0)
+    {
+        qWarning() << "Line parsing error: invalid key/value pairs!";
+        qWarning() << "Read line: " << line;
+        return;
+    }
+    if (n == 0) return;
+
+    // new keys add channels, keep last values of existing ones
+    unsigned nc = kvParser.numChannels();
+    if (kvSamples == nullptr || kvSamples->numChannels() != nc)
+    {
+        auto samples = new SamplePack(1, nc);
+        if (kvSamples != nullptr)
+        {
+            unsigned keep = std::min(nc, kvSamples->numChannels());
+            for (unsigned ci = 0; ci < keep; ci++)
+            {
+                samples->data(ci)[0] = kvSamples->data(ci)[0];
+            }
+            delete kvSamples;
+        }
+        kvSamples = samples;
+    }
+
+    if (nc != _numChannels)
+    {
+        _numChannels = nc;
+        updateNumChannels();
+        emit numOfChannelsChanged(nc);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        auto& v = kvParser.value(i);
+        kvSamples->data(v.channel)[0] = v.value;
+    }
+
+    feedOut(*kvSamples);
+}
+
 SamplePack* AsciiReader::parseLine(const QString& line) const
 {
     auto separatedValues = line.split(delimiter, QString::SkipEmptyParts);
@@ -26,6 +26,7 @@
 #include "samplepack.h"
 #include "abstractreader.h"
 #include "asciireadersettings.h"
+#include "keyvalueparser.h"
 
 class AsciiReader : public AbstractReader
 {
@@ -33,9 +34,11 @@ class AsciiReader : public AbstractReader
 
 public:
     explicit AsciiReader(QIODevice* device, QObject *parent = 0);
+    ~AsciiReader();
     QWidget* settingsWidget();
     unsigned numChannels() const;
     void enable(bool enabled) override;
+    void setDevice(QIODevice* device) override;
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
@@ -50,11 +53,22 @@ private:
     bool isHexData; ///< use hex encoding instead of decimal
     AsciiReaderSettings::FilterMode filterMode;
     QString filterPrefix; ///< selected ASCII mode filter prefix
+    bool isKeyValue; ///< read lines as key/value pairs
+    KeyValueParser kvParser;
+    /// Last values of all channels in key/value mode, re-allocated
+    /// only when a new channel is added
+    SamplePack* kvSamples = nullptr;
 
     bool firstReadAfterEnable = false;
 
     unsigned readData() override;
 
+    /// Parses a key/value line and feeds out, missing channels keep
+    /// their last value
+    void readKeyValueLine(const QString& line);
+    /// Updates number of channels after key/value mode or keys changed
+    void resetKeyValue();
+
 private slots:
 
     /**
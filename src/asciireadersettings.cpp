@@ -81,6 +81,26 @@ AsciiReaderSettings::AsciiReaderSettings(QWidget *parent) :
                 emit filterChanged(filterMode(), text);
             });
 
+    // key/value mode determines channels from keys
+    connect(ui->cbKeyValue, &QCheckBox::toggled,
+            [this](bool checked)
+            {
+                ui->leKeys->setEnabled(checked);
+                ui->spNumOfChannels->setDisabled(checked);
+                ui->rbComma->setDisabled(checked);
+                ui->rbSpace->setDisabled(checked);
+                ui->rbTab->setDisabled(checked);
+                ui->rbOtherDelimiter->setDisabled(checked);
+                ui->leDelimiter->setDisabled(checked);
+                emit keyValueChanged(checked);
+            });
+
+    connect(ui->leKeys, &QLineEdit::editingFinished,
+            [this]()
+            {
+                emit keysChanged(keys());
+            });
+
     // Note: if directly connected we get a runtime warning on incompatible signal arguments
     connect(ui->spNumOfChannels, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
             [this](int value)
@@ -129,6 +149,22 @@ bool AsciiReaderSettings::isHex() const
     return ui->cbHex->isChecked();
 }
 
+bool AsciiReaderSettings::isKeyValue() const
+{
+    return ui->cbKeyValue->isChecked();
+}
+
+QStringList AsciiReaderSettings::keys() const
+{
+    QStringList r;
+    for (auto key : ui->leKeys->text().split(',', QString::SkipEmptyParts))
+    {
+        key = key.trimmed();
+        if (!key.isEmpty()) r << key;
+    }
+    return r;
+}
+
 void AsciiReaderSettings::delimiterToggled(bool checked)
 {
     if (!checked) return;
@@ -194,6 +230,10 @@ void AsciiReaderSettings::saveSettings(QSettings* settings)
     settings->setValue(SG_ASCII_FilterMode, filterModeS);
     settings->setValue(SG_ASCII_FilterPrefix, ui->leFilterPrefix->text());
 
+    // save key/value mode
+    settings->setValue(SG_ASCII_KeyValue, isKeyValue());
+    settings->setValue(SG_ASCII_Keys, ui->leKeys->text());
+
     settings->endGroup();
 }
 
@@ -262,5 +302,14 @@ void AsciiReaderSettings::loadSettings(QSettings* settings)
     auto filterPrefixS = settings->value(SG_ASCII_FilterPrefix, ui->leFilterPrefix->text()).toString();
     ui->leFilterPrefix->setText(filterPrefixS);
 
+    // load key/value mode, keys first so that they are used when enabled
+    auto keysS = settings->value(SG_ASCII_Keys, ui->leKeys->text()).toString();
+    if (keysS != ui->leKeys->text())
+    {
+        ui->leKeys->setText(keysS);
+        emit keysChanged(keys());
+    }
+    ui->cbKeyValue->setChecked(settings->value(SG_ASCII_KeyValue, isKeyValue()).toBool());
+
     settings->endGroup();
 }
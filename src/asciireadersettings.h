@@ -24,6 +24,7 @@
 #include <QSettings>
 #include <QChar>
 #include <QButtonGroup>
+#include <QStringList>
 
 namespace Ui {
 class AsciiReaderSettings;
@@ -46,6 +47,10 @@ public:
     unsigned numOfChannels() const;
     QString delimiter() const;
     bool isHex() const;
+    /// Returns true if lines are read as key/value pairs
+    bool isKeyValue() const;
+    /// Returns predefined keys for key/value mode
+    QStringList keys() const;
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
@@ -57,6 +62,8 @@ signals:
     void delimiterChanged(QString);
     void hexChanged(bool);
     void filterChanged(FilterMode, QString);
+    void keyValueChanged(bool enabled);
+    void keysChanged(QStringList keys);
 
 private:
     Ui::AsciiReaderSettings *ui;
@@ -17,11 +17,10 @@
   along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <QtEndian>
 #include <QtDebug>
+#include <algorithm>
 
 #include "binarystreamreader.h"
-#include "byteswap.h"
 
 BinaryStreamReader::BinaryStreamReader(QIODevice* device, QObject* parent) :
     AbstractReader(device, parent)
@@ -29,16 +28,30 @@ BinaryStreamReader::BinaryStreamReader(QIODevice* device, QObject* parent) :
     paused = false;
     skipByteRequested = false;
     skipSampleRequested = false;
+    autoAlign = _settingsWidget.autoAlign();
+    alignSkip = 0;
 
     _numChannels = _settingsWidget.numOfChannels();
     connect(&_settingsWidget, &BinaryStreamReaderSettings::numOfChannelsChanged,
                      this, &BinaryStreamReader::onNumOfChannelsChanged);
 
     // initial number format selection
-    onNumberFormatChanged(_settingsWidget.numberFormat());
+    updateLayout();
     connect(&_settingsWidget, &BinaryStreamReaderSettings::numberFormatChanged,
             this, &BinaryStreamReader::onNumberFormatChanged);
 
+    connect(&_settingsWidget, &BinaryStreamReaderSettings::endiannessChanged,
+            [this](Endianness endianness)
+            {
+                layout.setEndianness(endianness);
+                alignment.reset();
+            });
+    connect(&_settingsWidget, &BinaryStreamReaderSettings::layoutChanged,
+            [this]()
+            {
+                updateLayout();
+            });
+
     // enable skip byte and sample buttons
     connect(&_settingsWidget, &BinaryStreamReaderSettings::skipByteRequested,
             [this]()
@@ -50,6 +63,16 @@ BinaryStreamReader::BinaryStreamReader(QIODevice* device, QObject* parent) :
             {
                 skipSampleRequested = true;
             });
+
+    connect(&_settingsWidget, &BinaryStreamReaderSettings::autoAlignChanged,
+            [this](bool enabled)
+            {
+                autoAlign = enabled;
+                alignment.reset();
+                alignSkip = 0;
+            });
+    connect(this, &BinaryStreamReader::alignmentChecked,
+            &_settingsWidget, &BinaryStreamReaderSettings::showAlignment);
 }
 
 QWidget* BinaryStreamReader::settingsWidget()
@@ -64,57 +87,42 @@ unsigned BinaryStreamReader::numChannels() const
 
 void BinaryStreamReader::onNumberFormatChanged(NumberFormat numberFormat)
 {
-    switch(numberFormat)
-    {
-        case NumberFormat_uint8:
-            sampleSize = sizeof(quint8);
-            readSample = &BinaryStreamReader::readSampleAs<quint8>;
-            break;
-        case NumberFormat_int8:
-            sampleSize = sizeof(qint8);
-            readSample = &BinaryStreamReader::readSampleAs<qint8>;
-            break;
-        case NumberFormat_uint16:
-            sampleSize = sizeof(quint16);
-            readSample = &BinaryStreamReader::readSampleAs<quint16>;
-            break;
-        case NumberFormat_int16:
-            sampleSize = sizeof(qint16);
-            readSample = &BinaryStreamReader::readSampleAs<qint16>;
-            break;
-        case NumberFormat_uint32:
-            sampleSize = sizeof(quint32);
-            readSample = &BinaryStreamReader::readSampleAs<quint32>;
-            break;
-        case NumberFormat_int32:
-            sampleSize = sizeof(qint32);
-            readSample = &BinaryStreamReader::readSampleAs<qint32>;
-            break;
-        case NumberFormat_float:
-            sampleSize = sizeof(float);
-            readSample = &BinaryStreamReader::readSampleAs<float>;
-            break;
-        case NumberFormat_double:
-            sampleSize = sizeof(double);
-            readSample = &BinaryStreamReader::readSampleAs<double>;
-            break;
-        case NumberFormat_INVALID:
-            Q_ASSERT(1); // never
-            break;
-    }
+    Q_UNUSED(numberFormat);
+    updateLayout();
 }
 
 void BinaryStreamReader::onNumOfChannelsChanged(unsigned value)
 {
-    _numChannels = value;
-    updateNumChannels();
-    emit numOfChannelsChanged(value);
+    Q_UNUSED(value);
+    updateLayout();
+}
+
+void BinaryStreamReader::updateLayout()
+{
+    QString desc = _settingsWidget.layoutDescription();
+    if (desc.isEmpty() || !layout.parse(desc))
+    {
+        layout = FrameLayout(_settingsWidget.numOfChannels(),
+                             _settingsWidget.numberFormat());
+    }
+    layout.setEndianness(_settingsWidget.endianness());
+    alignment.reset();
+    alignSkip = 0;
+
+    unsigned nc = layout.numChannels();
+    if (nc != _numChannels)
+    {
+        _numChannels = nc;
+        updateNumChannels();
+        emit numOfChannelsChanged(nc);
+    }
 }
 
 unsigned BinaryStreamReader::readData()
 {
     // a package is a set of channel data like {CHAN0_SAMPLE, CHAN1_SAMPLE...}
-    unsigned packageSize = sampleSize * _numChannels;
+    unsigned packageSize = layout.size();
+    unsigned sampleSize = layout.fieldSize(0);
     unsigned bytesAvailable = _device->bytesAvailable();
     unsigned totalRead = 0;
 
@@ -136,6 +144,16 @@ unsigned BinaryStreamReader::readData()
         bytesAvailable -= sampleSize;
     }
 
+    // skip bytes to correct detected misalignment
+    if (alignSkip && bytesAvailable > 0)
+    {
+        unsigned n = std::min(alignSkip, bytesAvailable);
+        _device->read(n);
+        totalRead += n;
+        alignSkip -= n;
+        bytesAvailable -= n;
+    }
+
     if (bytesAvailable < packageSize) return totalRead;
 
     unsigned numOfPackagesToRead =
@@ -151,38 +169,34 @@ unsigned BinaryStreamReader::readData()
         return totalRead;
     }
 
-    // actual reading
-    SamplePack samples(numOfPackagesToRead, _numChannels);
-    for (unsigned i = 0; i < numOfPackagesToRead; i++)
+    // actual reading, all packages are decoded at once
+    readBuffer.resize(numBytesToRead);
+    _device->read(readBuffer.data(), numBytesToRead);
+
+    const uchar* data = (const uchar*) readBuffer.constData();
+
+    if (autoAlign && alignment.isCheckDue() &&
+        numOfPackagesToRead > AlignmentDetector::MIN_PACKAGES)
     {
-        for (unsigned ci = 0; ci < _numChannels; ci++)
+        unsigned offset = alignment.check(layout, data, numBytesToRead);
+        emit alignmentChecked(alignment.isLocked(), alignment.confidence());
+        if (offset)
         {
-            samples.data(ci)[i] = (this->*readSample)();
+            // decode realigned packages, skip rest of the partial last
+            // package on next read
+            data += offset;
+            numOfPackagesToRead--;
+            alignSkip = offset;
         }
     }
+
+    SamplePack samples(numOfPackagesToRead * layout.setsPerPackage(), _numChannels);
+    layout.decode(data, numOfPackagesToRead, &samples);
     feedOut(samples);
 
     return totalRead;
 }
 
-template<typename T> double BinaryStreamReader::readSampleAs()
-{
-    T data;
-
-    _device->read((char*) &data, sizeof(data));
-
-    if (_settingsWidget.endianness() == LittleEndian)
-    {
-        data = qFromLittleEndian(data);
-    }
-    else
-    {
-        data = qFromBigEndian(data);
-    }
-
-    return double(data);
-}
-
 void BinaryStreamReader::saveSettings(QSettings* settings)
 {
     _settingsWidget.saveSettings(settings);
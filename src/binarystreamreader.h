@@ -24,11 +24,14 @@
 
 #include "abstractreader.h"
 #include "binarystreamreadersettings.h"
+#include "framelayout.h"
+#include "alignmentdetector.h"
 
 /**
  * Reads a simple stream of samples in binary form from the
- * device. There is no means of synchronization other than a button
- * that should be manually triggered by user.
+ * device. There is no means of synchronization other than buttons
+ * that should be manually triggered by user or optional automatic
+ * alignment detection (see `AlignmentDetector`).
  */
 class BinaryStreamReader : public AbstractReader
 {
@@ -42,23 +45,24 @@ public:
     /// Loads settings from a `QSettings`.
     void loadSettings(QSettings* settings);
 
+signals:
+    /// Emitted after each alignment check
+    void alignmentChecked(bool locked, double confidence);
+
 private:
     BinaryStreamReaderSettings _settingsWidget;
     unsigned _numChannels;
-    unsigned sampleSize;
+    FrameLayout layout;         ///< layout of a package
+    QByteArray readBuffer;
     bool skipByteRequested;
     bool skipSampleRequested;
+    bool autoAlign;
+    AlignmentDetector alignment;
+    unsigned alignSkip;         ///< bytes to skip to fix alignment
 
-    /// points to the readSampleAs function for currently selected number format
-    double (BinaryStreamReader::*readSample)();
-
-    /**
-     * Reads 1 sample from the device in given format.
-     *
-     * @note Device should already have enough bytes present before
-     * calling this function.
-     */
-    template<typename T> double readSampleAs();
+    /// Updates `layout` from settings, also updates number of
+    /// channels if changed
+    void updateLayout();
 
     unsigned readData() override;
 
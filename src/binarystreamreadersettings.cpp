@@ -42,8 +42,27 @@ BinaryStreamReaderSettings::BinaryStreamReaderSettings(QWidget *parent) :
     connect(ui->nfBox, SIGNAL(selectionChanged(NumberFormat)),
             this, SIGNAL(numberFormatChanged(NumberFormat)));
 
+    connect(ui->endiBox, SIGNAL(selectionChanged(Endianness)),
+            this, SIGNAL(endiannessChanged(Endianness)));
+
+    // layout overrides number format and number of channels
+    connect(ui->leLayout, &FrameLayoutEdit::descriptionChanged,
+            [this](QString desc)
+            {
+                ui->nfBox->setEnabled(desc.isEmpty());
+                ui->spNumOfChannels->setEnabled(desc.isEmpty());
+                emit layoutChanged(desc);
+            });
+
     connect(ui->pbSkipByte, SIGNAL(clicked()), this, SIGNAL(skipByteRequested()));
     connect(ui->pbSkipSample, SIGNAL(clicked()), this, SIGNAL(skipSampleRequested()));
+
+    connect(ui->cbAutoAlign, &QCheckBox::toggled,
+            [this](bool checked)
+            {
+                ui->lAlignment->clear();
+                emit autoAlignChanged(checked);
+            });
 }
 
 BinaryStreamReaderSettings::~BinaryStreamReaderSettings()
@@ -66,6 +85,26 @@ Endianness BinaryStreamReaderSettings::endianness()
     return ui->endiBox->currentSelection();
 }
 
+QString BinaryStreamReaderSettings::layoutDescription()
+{
+    return ui->leLayout->description();
+}
+
+bool BinaryStreamReaderSettings::autoAlign()
+{
+    return ui->cbAutoAlign->isChecked();
+}
+
+void BinaryStreamReaderSettings::showAlignment(bool locked, double confidence)
+{
+    if (!autoAlign()) return; // late result
+
+    QString text = QString("%1 (%2%)")
+        .arg(locked ? "Locked" : "Searching")
+        .arg(qRound(confidence * 100));
+    ui->lAlignment->setText(text);
+}
+
 void BinaryStreamReaderSettings::saveSettings(QSettings* settings)
 {
     settings->beginGroup(SettingGroup_Binary);
@@ -73,6 +112,8 @@ void BinaryStreamReaderSettings::saveSettings(QSettings* settings)
     settings->setValue(SG_Binary_NumberFormat, numberFormatToStr(numberFormat()));
     settings->setValue(SG_Binary_Endianness,
                        endianness() == LittleEndian ? "little" : "big");
+    settings->setValue(SG_Binary_Layout, ui->leLayout->text());
+    settings->setValue(SG_Binary_AutoAlign, autoAlign());
     settings->endGroup();
 }
 
@@ -103,5 +144,13 @@ void BinaryStreamReaderSettings::loadSettings(QSettings* settings)
         ui->endiBox->setSelection(BigEndian);
     } // else don't change
 
+    // load layout
+    ui->leLayout->setText(
+        settings->value(SG_Binary_Layout, ui->leLayout->text()).toString());
+
+    // load auto alignment
+    ui->cbAutoAlign->setChecked(
+        settings->value(SG_Binary_AutoAlign, autoAlign()).toBool());
+
     settings->endGroup();
 }
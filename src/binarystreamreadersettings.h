@@ -41,6 +41,10 @@ public:
     unsigned numOfChannels();
     NumberFormat numberFormat();
     Endianness endianness();
+    /// Returns layout description, empty if not set or invalid
+    QString layoutDescription();
+    /// Returns true if automatic alignment is enabled
+    bool autoAlign();
 
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
@@ -50,8 +54,16 @@ public:
 signals:
     void numOfChannelsChanged(unsigned);
     void numberFormatChanged(NumberFormat);
+    void endiannessChanged(Endianness);
+    /// Signaled with a valid layout description or empty string
+    void layoutChanged(QString);
     void skipByteRequested();
     void skipSampleRequested();
+    void autoAlignChanged(bool enabled);
+
+public slots:
+    /// Displays the result of an alignment check
+    void showAlignment(bool locked, double confidence);
 
 private:
     Ui::BinaryStreamReaderSettings *ui;
@@ -0,0 +1,104 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+
+#include "bufferedinputdevice.h"
+
+BufferedInputDevice::BufferedInputDevice(QObject* parent) :
+    QIODevice(parent)
+{
+    readPos = 0;
+    appendPos = 0;
+}
+
+bool BufferedInputDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 BufferedInputDevice::bytesAvailable() const
+{
+    return bufferedSize() + QIODevice::bytesAvailable();
+}
+
+bool BufferedInputDevice::canReadLine() const
+{
+    // base implementation only looks at the QIODevice buffer which
+    // isn't used in unbuffered mode
+    return buffer.indexOf('\n', readPos) >= 0 || QIODevice::canReadLine();
+}
+
+int BufferedInputDevice::bufferedSize() const
+{
+    return buffer.size() - readPos;
+}
+
+void BufferedInputDevice::resetBuffer(int capacity)
+{
+    buffer.clear();
+    if (capacity) buffer.reserve(capacity);
+    readPos = 0;
+}
+
+void BufferedInputDevice::compactBuffer()
+{
+    if (readPos > 0)
+    {
+        buffer.remove(0, readPos);
+        readPos = 0;
+    }
+}
+
+char* BufferedInputDevice::beginAppend(int maxSize)
+{
+    appendPos = buffer.size();
+    buffer.resize(appendPos + maxSize);
+    return buffer.data() + appendPos;
+}
+
+void BufferedInputDevice::endAppend(qint64 size)
+{
+    buffer.resize(appendPos + qMax(size, qint64(0)));
+}
+
+qint64 BufferedInputDevice::readData(char* data, qint64 maxSize)
+{
+    qint64 n = qMin(maxSize, qint64(bufferedSize()));
+    memcpy(data, buffer.constData() + readPos, n);
+    readPos += n;
+    dataConsumed();
+    return n;
+}
+
+qint64 BufferedInputDevice::readLineData(char* data, qint64 maxSize)
+{
+    // default implementation reads one byte at a time
+    qint64 available = qMin(maxSize, qint64(bufferedSize()));
+    const char* start = buffer.constData() + readPos;
+    const char* newline = (const char*) memchr(start, '\n', available);
+    return readData(data, newline ? newline - start + 1 : available);
+}
+
+qint64 BufferedInputDevice::writeData(const char* data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
@@ -0,0 +1,76 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BUFFEREDINPUTDEVICE_H
+#define BUFFEREDINPUTDEVICE_H
+
+#include <QIODevice>
+#include <QByteArray>
+
+/**
+ * Base class for sequential read only devices that collect incoming
+ * data in an internal buffer and serve `read()` from it.
+ *
+ * Implementations receive data directly at the end of the buffer (see
+ * `beginAppend()`) and open the device as `QIODevice::Unbuffered`, so
+ * data isn't copied into the `QIODevice` buffer too. Line reading is
+ * served from the internal buffer as well.
+ */
+class BufferedInputDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit BufferedInputDevice(QObject* parent = 0);
+
+    // reimplemented from QIODevice
+    bool isSequential() const override;
+    qint64 bytesAvailable() const override;
+    bool canReadLine() const override;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 readLineData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override;
+
+    /// Number of bytes waiting to be read
+    int bufferedSize() const;
+    /// Clears the buffer and reserves `capacity` bytes
+    void resetBuffer(int capacity = 0);
+    /// Drops data that is already read, should be called before appending
+    void compactBuffer();
+    /**
+     * Makes room for `maxSize` bytes at the end of the buffer. Must be
+     * followed by `endAppend()`.
+     *
+     * @return start of the appended area
+     */
+    char* beginAppend(int maxSize);
+    /// Finishes appending, `size` bytes are kept (negative means none)
+    void endAppend(qint64 size);
+    /// Called after data is read from the buffer
+    virtual void dataConsumed() {}
+
+private:
+    QByteArray buffer;
+    int readPos;                ///< start of unread data in `buffer`
+    int appendPos;              ///< end of data before `beginAppend()`
+};
+
+#endif // BUFFEREDINPUTDEVICE_H
@@ -0,0 +1,145 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+
+#include "bytestuffing.h"
+
+int cobsDecode(uchar* data, unsigned size)
+{
+    unsigned r = 0;             // read index
+    unsigned w = 0;             // write index, always behind `r`
+
+    while (r < size)
+    {
+        unsigned code = data[r++];
+        if (code == COBS_DELIMITER) return -1;
+
+        // copy the block of non-zero bytes
+        unsigned len = code - 1;
+        if (r + len > size) return -1;
+        memmove(data + w, data + r, len);
+        w += len;
+        r += len;
+
+        // a block shorter than maximum ends with a zero, unless it's the last one
+        if (code != 0xFF && r < size) data[w++] = 0;
+    }
+
+    return w;
+}
+
+int slipDecode(uchar* data, unsigned size)
+{
+    unsigned r = 0;
+    unsigned w = 0;
+
+    while (r < size)
+    {
+        // copy up to the next escape byte at once
+        const uchar* esc = (const uchar*) memchr(data + r, SLIP_ESC, size - r);
+        unsigned len = (esc ? unsigned(esc - data) : size) - r;
+        memmove(data + w, data + r, len);
+        w += len;
+        r += len;
+
+        if (esc)
+        {
+            if (r + 1 >= size) return -1;
+            uchar c = data[r + 1];
+            if (c == SLIP_ESC_END)
+            {
+                data[w++] = SLIP_END;
+            }
+            else if (c == SLIP_ESC_ESC)
+            {
+                data[w++] = SLIP_ESC;
+            }
+            else
+            {
+                return -1;
+            }
+            r += 2;
+        }
+    }
+
+    return w;
+}
+
+QByteArray cobsEncode(const QByteArray& data)
+{
+    QByteArray result;
+    result.reserve(data.size() + data.size() / 254 + 2);
+
+    int codeIndex = 0;
+    result.append(char(0)); // placeholder for the first code
+    uchar code = 1;
+    for (int i = 0; i < data.size(); i++)
+    {
+        if (data[i] == char(COBS_DELIMITER))
+        {
+            result[codeIndex] = char(code);
+            codeIndex = result.size();
+            result.append(char(0));
+            code = 1;
+        }
+        else
+        {
+            result.append(data[i]);
+            // start a new block when full, unless it's the end
+            if (++code == 0xFF && i + 1 < data.size())
+            {
+                result[codeIndex] = char(code);
+                codeIndex = result.size();
+                result.append(char(0));
+                code = 1;
+            }
+        }
+    }
+    result[codeIndex] = char(code);
+    result.append(char(COBS_DELIMITER));
+
+    return result;
+}
+
+QByteArray slipEncode(const QByteArray& data)
+{
+    QByteArray result;
+    result.reserve(data.size() + 2);
+
+    for (int i = 0; i < data.size(); i++)
+    {
+        uchar c = data[i];
+        if (c == SLIP_END)
+        {
+            result.append(char(SLIP_ESC)).append(char(SLIP_ESC_END));
+        }
+        else if (c == SLIP_ESC)
+        {
+            result.append(char(SLIP_ESC)).append(char(SLIP_ESC_ESC));
+        }
+        else
+        {
+            result.append(char(c));
+        }
+    }
+    result.append(char(SLIP_END));
+
+    return result;
+}
@@ -0,0 +1,64 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BYTESTUFFING_H
+#define BYTESTUFFING_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+/**
+ * @file bytestuffing.h
+ *
+ * COBS (Consistent Overhead Byte Stuffing) and SLIP (RFC 1055)
+ * encoding. Both remove the delimiter byte from the packet so packet
+ * boundaries are never ambiguous. Decoded data is never longer than
+ * encoded data so decoding is done in place.
+ */
+
+const uchar COBS_DELIMITER = 0x00;
+
+const uchar SLIP_END = 0xC0;
+const uchar SLIP_ESC = 0xDB;
+const uchar SLIP_ESC_END = 0xDC;
+const uchar SLIP_ESC_ESC = 0xDD;
+
+/**
+ * Decodes a COBS encoded packet in place.
+ *
+ * @param data encoded packet without the delimiter
+ * @return decoded size or -1 if packet is invalid
+ */
+int cobsDecode(uchar* data, unsigned size);
+
+/**
+ * Decodes a SLIP encoded packet in place.
+ *
+ * @param data encoded packet without the END bytes
+ * @return decoded size or -1 if packet is invalid
+ */
+int slipDecode(uchar* data, unsigned size);
+
+/// Encodes a packet with COBS, delimiter is appended
+QByteArray cobsEncode(const QByteArray& data);
+
+/// Encodes a packet with SLIP, END byte is appended
+QByteArray slipEncode(const QByteArray& data);
+
+#endif // BYTESTUFFING_H
@@ -0,0 +1,257 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <QStringList>
+
+#include "calibration.h"
+
+/// Number of samples evaluated together by polynomial calibration
+const unsigned POLY_BLOCK_SIZE = 256;
+
+Calibration::Calibration()
+{
+    _type = None;
+    lutStart = 0;
+}
+
+Calibration Calibration::polynomial(const QVector<double>& coeffs)
+{
+    Q_ASSERT(coeffs.size() > 0);
+
+    Calibration cal;
+    cal._type = Polynomial;
+    cal.coeffs = coeffs;
+    return cal;
+}
+
+Calibration Calibration::table(const QVector<double>& x, const QVector<double>& y)
+{
+    Q_ASSERT(x.size() >= 2 && x.size() == y.size());
+
+    Calibration cal;
+    cal._type = Table;
+    cal.xs = x;
+    cal.ys = y;
+    cal.slopes.resize(x.size() - 1);
+    for (int i = 0; i < cal.slopes.size(); i++)
+    {
+        Q_ASSERT(x[i+1] > x[i]);
+        cal.slopes[i] = (y[i+1] - y[i]) / (x[i+1] - x[i]);
+    }
+    cal.buildLut();
+    return cal;
+}
+
+void Calibration::buildLut()
+{
+    double lo = ceil(xs.first());
+    double hi = floor(xs.last());
+    if (hi < lo || hi - lo + 1 > MAX_LUT_SIZE) return;
+
+    lutStart = lo;
+    lut.resize(hi - lo + 1);
+    int seg = 0;
+    for (int i = 0; i < lut.size(); i++)
+    {
+        double x = lo + i;
+        seg = segment(x, seg);
+        lut[i] = ys[seg] + (x - xs[seg]) * slopes[seg];
+    }
+}
+
+int Calibration::segment(double x, int hint) const
+{
+    if (x >= xs[hint] && x < xs[hint+1]) return hint;
+
+    int i = std::upper_bound(xs.begin(), xs.end(), x) - xs.begin() - 1;
+    // outside of the table: extrapolate with first/last segment
+    return std::max(0, std::min(i, (int) slopes.size() - 1));
+}
+
+double Calibration::value(double x) const
+{
+    apply(&x, 1);
+    return x;
+}
+
+void Calibration::apply(double* data, unsigned ns) const
+{
+    if (_type == Polynomial)
+    {
+        applyPolynomial(data, ns);
+    }
+    else if (_type == Table)
+    {
+        applyTable(data, ns);
+    }
+}
+
+void Calibration::applyPolynomial(double* data, unsigned ns) const
+{
+    const double* c = coeffs.constData();
+    const int n = coeffs.size();
+    double x[POLY_BLOCK_SIZE];
+
+    // Horner's method, one coefficient at a time over a block of
+    // samples so that inner loops are simple and vectorizable
+    for (unsigned start = 0; start < ns; start += POLY_BLOCK_SIZE)
+    {
+        unsigned bs = std::min(POLY_BLOCK_SIZE, ns - start);
+        double* d = data + start;
+        memcpy(x, d, bs * sizeof(double));
+
+        std::fill(d, d + bs, c[n-1]);
+        for (int k = n - 2; k >= 0; k--)
+        {
+            const double ck = c[k];
+            for (unsigned i = 0; i < bs; i++)
+            {
+                d[i] = d[i] * x[i] + ck;
+            }
+        }
+    }
+}
+
+void Calibration::applyTable(double* data, unsigned ns) const
+{
+    const double* l = lut.constData();
+    const double lutSize = lut.size();
+    int seg = 0;
+
+    for (unsigned i = 0; i < ns; i++)
+    {
+        double x = data[i];
+
+        // fast path for integer inputs
+        double r = x - lutStart;
+        if (r >= 0 && r < lutSize)
+        {
+            unsigned k = (unsigned) r;
+            if (k == r)
+            {
+                data[i] = l[k];
+                continue;
+            }
+        }
+
+        // consecutive samples are likely to be in the same segment
+        seg = segment(x, seg);
+        data[i] = ys[seg] + (x - xs[seg]) * slopes[seg];
+    }
+}
+
+bool Calibration::operator==(const Calibration& other) const
+{
+    return _type == other._type && coeffs == other.coeffs &&
+        xs == other.xs && ys == other.ys;
+}
+
+QString Calibration::toString() const
+{
+    QStringList items;
+    if (_type == Polynomial)
+    {
+        for (auto c : coeffs)
+        {
+            items << QString::number(c, 'g', 17);
+        }
+        return "poly: " + items.join(", ");
+    }
+    else if (_type == Table)
+    {
+        for (int i = 0; i < xs.size(); i++)
+        {
+            items << QString::number(xs[i], 'g', 17) + "=" + QString::number(ys[i], 'g', 17);
+        }
+        return "table: " + items.join(", ");
+    }
+    return QString();
+}
+
+bool Calibration::parse(const QString& text, Calibration* cal, QString* error)
+{
+    QString err;
+    QString t = text.trimmed();
+    if (t.isEmpty())
+    {
+        *cal = Calibration();
+        return true;
+    }
+
+    int colon = t.indexOf(':');
+    QString kind = t.left(colon).trimmed().toLower();
+    QStringList items = t.mid(colon + 1).split(',');
+    bool ok = true;
+
+    if (colon < 0)
+    {
+        err = "Missing type, expected \"poly:\" or \"table:\"";
+    }
+    else if (kind == "poly")
+    {
+        QVector<double> c;
+        for (auto& item : items)
+        {
+            c.append(item.trimmed().toDouble(&ok));
+            if (!ok)
+            {
+                err = QString("Invalid coefficient '%1'").arg(item.trimmed());
+                break;
+            }
+        }
+        if (err.isEmpty()) *cal = polynomial(c);
+    }
+    else if (kind == "table")
+    {
+        QVector<double> x, y;
+        for (auto& item : items)
+        {
+            QStringList pair = item.split('=');
+            if (pair.size() == 2)
+            {
+                bool okY;
+                x.append(pair[0].trimmed().toDouble(&ok));
+                y.append(pair[1].trimmed().toDouble(&okY));
+                ok = ok && okY;
+            }
+            if (pair.size() != 2 || !ok)
+            {
+                err = QString("Invalid point '%1', expected x=y").arg(item.trimmed());
+                break;
+            }
+            if (x.size() > 1 && !(x[x.size()-1] > x[x.size()-2]))
+            {
+                err = "Table x values must be increasing";
+                break;
+            }
+        }
+        if (err.isEmpty() && x.size() < 2) err = "Table needs at least 2 points";
+        if (err.isEmpty()) *cal = table(x, y);
+    }
+    else
+    {
+        err = QString("Unknown type '%1', expected \"poly\" or \"table\"").arg(kind);
+    }
+
+    if (!err.isEmpty() && error != nullptr) *error = err;
+    return err.isEmpty();
+}
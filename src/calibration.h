@@ -0,0 +1,108 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <QVector>
+#include <QString>
+
+/**
+ * Nonlinear calibration of a channel.
+ *
+ * Either a piecewise-linear lookup table or a polynomial. Tables are
+ * extrapolated with their first/last segments. Polynomials are
+ * evaluated with Horner's method over blocks of samples.
+ *
+ * Tables with an integer span up to `MAX_LUT_SIZE` also get a dense
+ * table with one entry per integer input, so that integer samples (ex:
+ * from 8/16 bit number formats) are calibrated with a single load.
+ *
+ * Text representation (also used for settings):
+ *
+ *     poly: c0, c1, c2, ...        c0 + c1*x + c2*x^2 + ...
+ *     table: x0=y0, x1=y1, ...     x values strictly increasing
+ *
+ * Empty text means no calibration.
+ */
+class Calibration
+{
+public:
+    enum Type
+    {
+        None,
+        Table,
+        Polynomial
+    };
+
+    /// Maximum number of entries of the integer input lookup table
+    static const unsigned MAX_LUT_SIZE = 1 << 16;
+
+    /// Creates a disabled calibration
+    Calibration();
+
+    /// @param coeffs coefficients starting from the constant term, not empty
+    static Calibration polynomial(const QVector<double>& coeffs);
+    /**
+     * @param x input points, strictly increasing, at least 2
+     * @param y output values, same size as `x`
+     */
+    static Calibration table(const QVector<double>& x, const QVector<double>& y);
+
+    /**
+     * Parses text representation.
+     *
+     * @param text see class description
+     * @param cal set to parsed calibration on success
+     * @param error set to an error message on failure, can be null
+     * @return false if text is not valid
+     */
+    static bool parse(const QString& text, Calibration* cal, QString* error = nullptr);
+
+    Type type() const {return _type;};
+    bool isEnabled() const {return _type != None;};
+    /// Text representation, `parse()` accepts it back
+    QString toString() const;
+
+    /// Calibrates a single value
+    double value(double x) const;
+    /// Calibrates `ns` samples in place
+    void apply(double* data, unsigned ns) const;
+
+    bool operator==(const Calibration& other) const;
+    bool operator!=(const Calibration& other) const {return !(*this == other);};
+
+private:
+    Type _type;
+    QVector<double> coeffs;         ///< polynomial coefficients
+    QVector<double> xs, ys, slopes; ///< table points and segment slopes
+    double lutStart;                ///< input value of `lut[0]`
+    QVector<double> lut;            ///< table output for integer inputs
+
+    /// Returns index of the table segment containing `x`, `hint` is tried first
+    int segment(double x, int hint) const;
+    /// Applies polynomial in place
+    void applyPolynomial(double* data, unsigned ns) const;
+    /// Applies table in place
+    void applyTable(double* data, unsigned ns) const;
+    /// Fills `lut` if table span is small enough
+    void buildLut();
+};
+
+#endif // CALIBRATION_H
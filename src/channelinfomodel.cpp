@@ -62,6 +62,8 @@ ChannelInfoModel::ChannelInfoModel(unsigned numberOfChannels, QObject* parent) :
     QAbstractTableModel(parent)
 {
     _numOfChannels = 0;
+    _gainOrOffsetEn = false;
+    _calibrationEn = false;
     setNumOfChannels(numberOfChannels);
 }
 
@@ -153,6 +155,11 @@ double ChannelInfoModel::offset (unsigned i) const
     return infos[i].offset;
 }
 
+const Calibration& ChannelInfoModel::calibration (unsigned i) const
+{
+    return infos[i].calibration;
+}
+
 QStringList ChannelInfoModel::channelNames() const
 {
     QStringList r;
@@ -163,6 +170,11 @@ QStringList ChannelInfoModel::channelNames() const
     return r;
 }
 
+bool ChannelInfoModel::isStatsColumn(int column)
+{
+    return column >= COLUMN_NUM_SAMPLES && column < COLUMN_COUNT;
+}
+
 int ChannelInfoModel::rowCount(const QModelIndex &parent) const
 {
     return _numOfChannels;
@@ -187,6 +199,14 @@ Qt::ItemFlags ChannelInfoModel::flags(const QModelIndex &index) const
     {
         return Qt::ItemIsEditable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren | Qt::ItemIsSelectable;
     }
+    else if (index.column() == COLUMN_CALIBRATION)
+    {
+        return Qt::ItemIsEditable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren | Qt::ItemIsSelectable;
+    }
+    else if (isStatsColumn(index.column()))
+    {
+        return Qt::ItemIsEnabled | Qt::ItemNeverHasChildren | Qt::ItemIsSelectable;
+    }
 
     return Qt::NoItemFlags;
 }
@@ -244,11 +264,72 @@ QVariant ChannelInfoModel::data(const QModelIndex &index, int role) const
         {
             return QVariant(info.offset);
         }
+    } // calibration
+    else if (index.column() == COLUMN_CALIBRATION)
+    {
+        if (role == Qt::DisplayRole || role == Qt::EditRole)
+        {
+            return QVariant(info.calibration.toString());
+        }
+    }
+    else if (isStatsColumn(index.column()))
+    {
+        if (role == Qt::DisplayRole)
+        {
+            return statsData(index.row(), index.column());
+        }
+        else if (role == Qt::TextAlignmentRole)
+        {
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+        }
     }
 
     return QVariant();
 }
 
+QVariant ChannelInfoModel::statsData(unsigned channel, int column) const
+{
+    if ((int) channel >= totalStats.size() || totalStats[channel].count == 0)
+    {
+        return QVariant();
+    }
+
+    auto& w = windowStats[channel];
+    double value;
+    switch (column)
+    {
+        case COLUMN_NUM_SAMPLES:
+            return QString::number(totalStats[channel].count);
+        case COLUMN_MEAN:         value = w.mean;         break;
+        case COLUMN_RMS:          value = w.rms;          break;
+        case COLUMN_MIN:          value = w.min;          break;
+        case COLUMN_MAX:          value = w.max;          break;
+        case COLUMN_STD_DEV:      value = w.stdDev;       break;
+        case COLUMN_PEAK_TO_PEAK: value = w.peakToPeak(); break;
+        default:
+            return QVariant();
+    }
+    return QString::number(value, 'g', 6);
+}
+
+void ChannelInfoModel::updateStats(const QVector<ChannelStats>& stats)
+{
+    totalStats.resize(stats.size());
+    windowStats.resize(stats.size());
+    for (int ci = 0; ci < stats.size(); ci++)
+    {
+        totalStats[ci] = stats[ci].total();
+        windowStats[ci] = stats[ci].windowed();
+    }
+
+    if (_numOfChannels)
+    {
+        emit dataChanged(index(0, COLUMN_NUM_SAMPLES),
+                         index(_numOfChannels-1, COLUMN_COUNT-1),
+                         QVector<int>({Qt::DisplayRole}));
+    }
+}
+
 QVariant ChannelInfoModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
     if (orientation == Qt::Horizontal)
@@ -271,6 +352,55 @@ QVariant ChannelInfoModel::headerData(int section, Qt::Orientation orientation,
             {
                 return tr("Offset");
             }
+            else if (section == COLUMN_CALIBRATION)
+            {
+                return tr("Calibration");
+            }
+            else if (section == COLUMN_NUM_SAMPLES)
+            {
+                return tr("Count");
+            }
+            else if (section == COLUMN_MEAN)
+            {
+                return tr("Mean");
+            }
+            else if (section == COLUMN_RMS)
+            {
+                return tr("RMS");
+            }
+            else if (section == COLUMN_MIN)
+            {
+                return tr("Min");
+            }
+            else if (section == COLUMN_MAX)
+            {
+                return tr("Max");
+            }
+            else if (section == COLUMN_STD_DEV)
+            {
+                return tr("Std Dev");
+            }
+            else if (section == COLUMN_PEAK_TO_PEAK)
+            {
+                return tr("P-P");
+            }
+        }
+        else if (role == Qt::ToolTipRole)
+        {
+            if (section == COLUMN_CALIBRATION)
+            {
+                return tr("Applied before gain and offset, leave empty to disable.\n"
+                          "Polynomial (c0 + c1*x + ...): \"poly: c0, c1, c2\"\n"
+                          "Lookup table, linearly interpolated: \"table: x0=y0, x1=y1, ...\"");
+            }
+            else if (section == COLUMN_NUM_SAMPLES)
+            {
+                return tr("Number of samples received since last clear");
+            }
+            else if (isStatsColumn(section))
+            {
+                return tr("Calculated over the samples in buffer");
+            }
         }
     }
     else                        // vertical
@@ -351,6 +481,15 @@ bool ChannelInfoModel::setData(const QModelIndex &index, const QVariant &value,
             r = true;
         }
     }
+    else if (index.column() == COLUMN_CALIBRATION)
+    {
+        if (role == Qt::DisplayRole || role == Qt::EditRole)
+        {
+            // invalid text is rejected, previous calibration is kept
+            r = Calibration::parse(value.toString(), &info.calibration);
+            if (r) updateGainOrOffsetEn();
+        }
+    }
 
     if (r)
     {
@@ -474,18 +613,69 @@ void ChannelInfoModel::resetOffsets()
     endResetModel();
 }
 
+void ChannelInfoModel::resetCalibrations()
+{
+    beginResetModel();
+    for (unsigned ci = 0; (int) ci < infos.length(); ci++)
+    {
+        infos[ci].calibration = Calibration();
+    }
+    updateGainOrOffsetEn();
+    endResetModel();
+}
+
 bool ChannelInfoModel::gainOrOffsetEn() const
 {
     return _gainOrOffsetEn;
 }
 
+bool ChannelInfoModel::calibrationEn() const
+{
+    return _calibrationEn;
+}
+
+void ChannelInfoModel::apply(SamplePack* pack) const
+{
+    unsigned ns = pack->numSamples();
+    unsigned nc = qMin(pack->numChannels(), _numOfChannels);
+
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        const ChannelInfo& info = infos[ci];
+        double* data = pack->data(ci);
+
+        // non-linear calibration is applied before gain and offset
+        if (info.calibration.isEnabled())
+        {
+            info.calibration.apply(data, ns);
+        }
+
+        if (info.gainEn)
+        {
+            for (unsigned i = 0; i < ns; i++)
+            {
+                data[i] *= info.gain;
+            }
+        }
+        if (info.offsetEn)
+        {
+            for (unsigned i = 0; i < ns; i++)
+            {
+                data[i] += info.offset;
+            }
+        }
+    }
+}
+
 void ChannelInfoModel::updateGainOrOffsetEn()
 {
     _gainOrOffsetEn = false;
+    _calibrationEn = false;
     for (unsigned ci = 0; ci < _numOfChannels; ci++)
     {
         auto& info = infos[ci];
         _gainOrOffsetEn |= (info.gainEn || info.offsetEn);
+        _calibrationEn |= info.calibration.isEnabled();
     }
 }
 
@@ -506,9 +696,11 @@ void ChannelInfoModel::saveSettings(QSettings* settings) const
         settings->setValue(SG_Channels_GainEn, info.gainEn);
         settings->setValue(SG_Channels_Offset, info.offset);
         settings->setValue(SG_Channels_OffsetEn, info.offsetEn);
+        settings->setValue(SG_Channels_Calibration, info.calibration.toString());
     }
 
     settings->endArray();
+    settings->setValue(SG_Channels_Expressions, _expressions);
     settings->endGroup();
 }
 
@@ -529,6 +721,8 @@ void ChannelInfoModel::loadSettings(QSettings* settings)
         chanInfo.gainEn     = settings->value(SG_Channels_GainEn   , chanInfo.gainEn).toBool();
         chanInfo.offset     = settings->value(SG_Channels_Offset   , chanInfo.offset).toDouble();
         chanInfo.offsetEn   = settings->value(SG_Channels_OffsetEn , chanInfo.offsetEn).toBool();
+        Calibration::parse(settings->value(SG_Channels_Calibration).toString(),
+                           &chanInfo.calibration);
 
         if ((int) ci < infos.size())
         {
@@ -550,5 +744,19 @@ void ChannelInfoModel::loadSettings(QSettings* settings)
     updateGainOrOffsetEn();
 
     settings->endArray();
+    setExpressions(settings->value(SG_Channels_Expressions, _expressions).toStringList());
     settings->endGroup();
 }
+
+QStringList ChannelInfoModel::expressions() const
+{
+    return _expressions;
+}
+
+void ChannelInfoModel::setExpressions(const QStringList& expressions)
+{
+    if (expressions == _expressions) return;
+
+    _expressions = expressions;
+    emit expressionsChanged();
+}
@@ -25,6 +25,10 @@
 #include <QSettings>
 #include <QStringList>
 
+#include "channelstats.h"
+#include "calibration.h"
+#include "samplepack.h"
+
 class ChannelInfoModel : public QAbstractTableModel
 {
     Q_OBJECT
@@ -36,6 +40,15 @@ public:
         COLUMN_VISIBILITY,
         COLUMN_GAIN,
         COLUMN_OFFSET,
+        COLUMN_CALIBRATION,
+        // statistics, read only
+        COLUMN_NUM_SAMPLES,
+        COLUMN_MEAN,
+        COLUMN_RMS,
+        COLUMN_MIN,
+        COLUMN_MAX,
+        COLUMN_STD_DEV,
+        COLUMN_PEAK_TO_PEAK,
         COLUMN_COUNT            // MUST be last
     };
 
@@ -50,10 +63,18 @@ public:
     double  gain     (unsigned i) const;
     bool    offsetEn (unsigned i) const;
     double  offset   (unsigned i) const;
+    const Calibration& calibration(unsigned i) const;
     /// Returns true if any of the channels have gain or offset enabled
     bool gainOrOffsetEn() const;
+    /// Returns true if any of the channels have calibration enabled
+    bool calibrationEn() const;
+    /// Applies calibration, gain and offset (in this order) of
+    /// channels to `pack` in place
+    void apply(SamplePack* pack) const;
     /// Returns a list of channel names
     QStringList channelNames() const;
+    /// Returns true if column is one of the read only statistics columns
+    static bool isStatsColumn(int column);
 
     // implemented from QAbstractItemModel
     int           rowCount(const QModelIndex &parent = QModelIndex()) const;
@@ -68,6 +89,24 @@ public:
     void saveSettings(QSettings* settings) const;
     /// Loads all channel info from a `QSettings`.
     void loadSettings(QSettings* settings);
+    /**
+     * Updates statistics columns. Sample count is the total count,
+     * others are calculated over the window (buffer).
+     *
+     * @note Only statistics columns are included in emitted
+     * `dataChanged` signal.
+     */
+    void updateStats(const QVector<ChannelStats>& stats);
+    /**
+     * Expressions of math (derived) channels. Derived channels are
+     * appended after the input channels, one for each expression.
+     */
+    QStringList expressions() const;
+    /// Sets math channel expressions, emits `expressionsChanged`
+    void setExpressions(const QStringList& expressions);
+
+signals:
+    void expressionsChanged();
 
 public slots:
     /// reset all channel info (names, color etc.)
@@ -80,6 +119,8 @@ public slots:
     void resetGains();
     /// reset all channel offset values and disables offsets
     void resetOffsets();
+    /// removes calibration of all channels
+    void resetCalibrations();
     /// reset visibility
     void resetVisibility(bool visible);
 
@@ -93,6 +134,7 @@ private:
         QColor color;
         double gain, offset;
         bool gainEn, offsetEn;
+        Calibration calibration;
     };
 
     unsigned _numOfChannels;     ///< @note this is not necessarily the length of `infos`
@@ -103,15 +145,25 @@ private:
      */
     QList<ChannelInfo> infos;
 
+    /// Math channel expressions
+    QStringList _expressions;
+
+    /// Statistics of channels, empty if never updated
+    QVector<ChannelStats::Summary> totalStats, windowStats;
+
     /**
      * Cache for gain and offset enabled variables of channels. If gain and/or
      * offset is not enabled for *any* of the channels this is false otherwise
      * true.
      */
     bool _gainOrOffsetEn;
+    /// Cache for calibration enabled state of channels, true if *any* is enabled
+    bool _calibrationEn;
 
-    /// Updates `_gainOrOffsetEn` by scanning all channel infos.
+    /// Updates `_gainOrOffsetEn` and `_calibrationEn` by scanning all channel infos.
     void updateGainOrOffsetEn();
+    /// Returns display data of a statistics column
+    QVariant statsData(unsigned channel, int column) const;
 };
 
 #endif // CHANNELINFOMODEL_H
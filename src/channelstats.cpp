@@ -0,0 +1,177 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+
+#include "channelstats.h"
+
+/// Initial capacity of monotonic queues
+#define QUEUE_MIN_CAPACITY 16
+
+const unsigned ChannelStats::MAX_WINDOW;
+
+void ChannelStats::MonotonicQueue::reset()
+{
+    items.resize(QUEUE_MIN_CAPACITY);
+    head = 0;
+    size = 0;
+}
+
+void ChannelStats::MonotonicQueue::popFront()
+{
+    head = (head + 1) % items.size();
+    size--;
+}
+
+void ChannelStats::MonotonicQueue::pushBack(quint64 index)
+{
+    if (size == (unsigned) items.size())
+    {
+        QVector<quint64> grown(items.size() * 2);
+        for (unsigned i = 0; i < size; i++)
+        {
+            grown[i] = items[(head + i) % items.size()];
+        }
+        items.swap(grown);
+        head = 0;
+    }
+    items[(head + size) % items.size()] = index;
+    size++;
+}
+
+ChannelStats::ChannelStats(unsigned window)
+{
+    _window = qMin(window, MAX_WINDOW);
+    clear();
+}
+
+void ChannelStats::setWindow(unsigned n)
+{
+    _window = qMin(n, MAX_WINDOW);
+    clear();
+}
+
+void ChannelStats::clear()
+{
+    count = 0;
+    mean = 0;
+    m2 = 0;
+    meanSq = 0;
+    min = 0;
+    max = 0;
+
+    values.fill(0, _window);
+    winSum = 0;
+    winSumSq = 0;
+    minQueue.reset();
+    maxQueue.reset();
+}
+
+void ChannelStats::add(const double* data, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++)
+    {
+        double x = data[i];
+
+        if (_window) addToWindow(x);
+
+        count++;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+        meanSq += (x * x - meanSq) / count;
+        if (count == 1)
+        {
+            min = max = x;
+        }
+        else
+        {
+            if (x < min) min = x;
+            if (x > max) max = x;
+        }
+    }
+}
+
+void ChannelStats::addToWindow(double x)
+{
+    // `count` is the index of the new sample
+    const quint64 index = count;
+    const unsigned pos = index % _window;
+
+    // drop sample that is leaving the window
+    if (index >= _window)
+    {
+        double old = values[pos];
+        winSum -= old;
+        winSumSq -= old * old;
+        quint64 expired = index - _window;
+        if (minQueue.size && minQueue.front() == expired) minQueue.popFront();
+        if (maxQueue.size && maxQueue.front() == expired) maxQueue.popFront();
+    }
+
+    while (minQueue.size && value(minQueue.back()) >= x) minQueue.popBack();
+    while (maxQueue.size && value(maxQueue.back()) <= x) maxQueue.popBack();
+
+    values[pos] = x;
+    winSum += x;
+    winSumSq += x * x;
+    minQueue.pushBack(index);
+    maxQueue.pushBack(index);
+
+    if (pos == _window - 1) resum();
+}
+
+void ChannelStats::resum()
+{
+    winSum = 0;
+    winSumSq = 0;
+    for (double v : values)
+    {
+        winSum += v;
+        winSumSq += v * v;
+    }
+}
+
+ChannelStats::Summary ChannelStats::total() const
+{
+    Summary r;
+    r.count = count;
+    r.mean = mean;
+    r.rms = sqrt(meanSq);
+    r.min = min;
+    r.max = max;
+    r.stdDev = count ? sqrt(m2 / count) : 0;
+    return r;
+}
+
+ChannelStats::Summary ChannelStats::windowed() const
+{
+    Summary r = {0, 0, 0, 0, 0, 0};
+    if (_window == 0 || count == 0) return r;
+
+    quint64 n = qMin(count, (quint64) _window);
+    r.count = n;
+    r.mean = winSum / n;
+    double msq = qMax(winSumSq / n, 0.);
+    r.rms = sqrt(msq);
+    r.stdDev = sqrt(qMax(msq - r.mean * r.mean, 0.));
+    r.min = value(minQueue.front());
+    r.max = value(maxQueue.front());
+    return r;
+}
@@ -0,0 +1,117 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CHANNELSTATS_H
+#define CHANNELSTATS_H
+
+#include <QVector>
+
+/**
+ * Incremental statistics of a single channel.
+ *
+ * Two sets of statistics are kept:
+ *
+ * - total: all samples since last `clear()`, mean and variance are
+ *   updated with Welford's method
+ * - window: last `window()` samples, mean and RMS come from sliding
+ *   sums, min/max come from monotonic queues
+ *
+ * Window keeps its own copy of samples, so its size is capped at
+ * `MAX_WINDOW` to keep memory use bounded even when plot buffers are
+ * very large or file backed.
+ *
+ * Cost of adding a sample is constant (amortized) and doesn't depend
+ * on the window size. Sliding sums are recalculated once per window
+ * length to keep rounding errors from accumulating.
+ */
+class ChannelStats
+{
+public:
+    struct Summary
+    {
+        quint64 count;          ///< number of samples
+        double mean;
+        double rms;
+        double min;
+        double max;
+        double stdDev;          ///< population standard deviation
+
+        double peakToPeak() const {return max - min;};
+    };
+
+    /// Maximum size of the sliding window
+    static const unsigned MAX_WINDOW = 1 << 16;
+
+    /// @param window size of the sliding window, 0 disables window
+    /// statistics, values larger than `MAX_WINDOW` are capped
+    explicit ChannelStats(unsigned window = 0);
+
+    unsigned window() const {return _window;};
+    /// Changes window size (capped at `MAX_WINDOW`), clears window statistics
+    void setWindow(unsigned n);
+
+    /// Adds `n` samples
+    void add(const double* data, unsigned n);
+    /// Clears all statistics
+    void clear();
+
+    /// Statistics of all samples since last clear
+    Summary total() const;
+    /// Statistics of last `window()` samples
+    Summary windowed() const;
+
+private:
+    /// Queue of sample indexes with monotonic values. Storage grows
+    /// on demand, it's usually much shorter than the window.
+    struct MonotonicQueue
+    {
+        QVector<quint64> items;
+        unsigned head;
+        unsigned size;
+
+        void reset();
+        quint64 front() const {return items[head];};
+        quint64 back() const {return items[(head + size - 1) % items.size()];};
+        void popFront();
+        void popBack() {size--;};
+        void pushBack(quint64 index);
+    };
+
+    // total
+    quint64 count;
+    double mean;
+    double m2;                  ///< sum of squared differences from mean
+    double meanSq;              ///< mean of squares
+    double min, max;
+
+    // window
+    unsigned _window;
+    QVector<double> values;     ///< last `_window` samples, circular
+    double winSum, winSumSq;
+    MonotonicQueue minQueue, maxQueue;
+
+    /// Adds a single sample to window statistics
+    void addToWindow(double value);
+    /// Recalculates window sums from `values`
+    void resum();
+    /// Sample value by index, index must be in window
+    double value(quint64 index) const {return values[index % _window];};
+};
+
+#endif // CHANNELSTATS_H
@@ -0,0 +1,192 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QMap>
+#include <QtEndian>
+
+#include "checksum.h"
+
+static QMap<ChecksumType, QString> mapping({
+        {ChecksumType_None, "none"},
+        {ChecksumType_Sum8, "sum8"},
+        {ChecksumType_CRC8, "crc8"},
+        {ChecksumType_CRC16_CCITT, "crc16ccitt"},
+        {ChecksumType_CRC16_XMODEM, "crc16xmodem"},
+        {ChecksumType_CRC32, "crc32"}
+    });
+
+namespace
+{
+/// Lookup tables, generated once on first use
+struct CrcTables
+{
+    quint8 crc8[256];
+    quint16 crc16[256];
+    quint32 crc32[8][256];   ///< `crc32[k]` processes a byte `k` bytes ahead
+
+    CrcTables()
+    {
+        for (unsigned i = 0; i < 256; i++)
+        {
+            quint8 c8 = i;
+            quint16 c16 = i << 8;
+            quint32 c32 = i;
+            for (int b = 0; b < 8; b++)
+            {
+                c8 = (c8 & 0x80) ? (c8 << 1) ^ 0x07 : (c8 << 1);
+                c16 = (c16 & 0x8000) ? (c16 << 1) ^ 0x1021 : (c16 << 1);
+                c32 = (c32 & 1) ? (c32 >> 1) ^ 0xEDB88320 : (c32 >> 1);
+            }
+            crc8[i] = c8;
+            crc16[i] = c16;
+            crc32[0][i] = c32;
+        }
+
+        for (unsigned i = 0; i < 256; i++)
+        {
+            for (int k = 1; k < 8; k++)
+            {
+                quint32 prev = crc32[k-1][i];
+                crc32[k][i] = (prev >> 8) ^ crc32[0][prev & 0xFF];
+            }
+        }
+    }
+};
+
+const CrcTables& tables()
+{
+    static const CrcTables t;
+    return t;
+}
+}
+
+unsigned checksumSize(ChecksumType type)
+{
+    switch (type)
+    {
+        case ChecksumType_Sum8:
+        case ChecksumType_CRC8:
+            return 1;
+        case ChecksumType_CRC16_CCITT:
+        case ChecksumType_CRC16_XMODEM:
+            return 2;
+        case ChecksumType_CRC32:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+quint32 calcChecksum(ChecksumType type, const uchar* data, unsigned n)
+{
+    switch (type)
+    {
+        case ChecksumType_Sum8:
+        {
+            unsigned sum = 0;
+            for (unsigned i = 0; i < n; i++)
+            {
+                sum += data[i];
+            }
+            return sum & 0xFF;
+        }
+        case ChecksumType_CRC8:
+            return crc8(data, n);
+        case ChecksumType_CRC16_CCITT:
+            return crc16Ccitt(data, n, 0xFFFF);
+        case ChecksumType_CRC16_XMODEM:
+            return crc16Ccitt(data, n, 0);
+        case ChecksumType_CRC32:
+            return crc32(data, n);
+        default:
+            return 0;
+    }
+}
+
+quint32 readChecksum(ChecksumType type, const uchar* data, bool littleEndian)
+{
+    switch (checksumSize(type))
+    {
+        case 1:
+            return data[0];
+        case 2:
+            return littleEndian ? qFromLittleEndian<quint16>(data) : qFromBigEndian<quint16>(data);
+        case 4:
+            return littleEndian ? qFromLittleEndian<quint32>(data) : qFromBigEndian<quint32>(data);
+        default:
+            return 0;
+    }
+}
+
+QString checksumTypeToStr(ChecksumType type)
+{
+    return mapping.value(type);
+}
+
+ChecksumType strToChecksumType(QString str)
+{
+    return mapping.key(str, ChecksumType_INVALID);
+}
+
+quint8 crc8(const uchar* data, unsigned n, quint8 crc)
+{
+    const quint8* table = tables().crc8;
+    for (unsigned i = 0; i < n; i++)
+    {
+        crc = table[crc ^ data[i]];
+    }
+    return crc;
+}
+
+quint16 crc16Ccitt(const uchar* data, unsigned n, quint16 crc)
+{
+    const quint16* table = tables().crc16;
+    for (unsigned i = 0; i < n; i++)
+    {
+        crc = (crc << 8) ^ table[(crc >> 8) ^ data[i]];
+    }
+    return crc;
+}
+
+quint32 crc32(const uchar* data, unsigned n, quint32 crc)
+{
+    const auto& t = tables().crc32;
+    crc = ~crc;
+
+    // process 8 bytes at a time
+    while (n >= 8)
+    {
+        quint32 one = crc ^ qFromLittleEndian<quint32>(data);
+        quint32 two = qFromLittleEndian<quint32>(data + 4);
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^
+              t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^
+              t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+        data += 8;
+        n -= 8;
+    }
+
+    // remaining bytes
+    while (n--)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return ~crc;
+}
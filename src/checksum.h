@@ -0,0 +1,69 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <QString>
+#include <QtGlobal>
+
+/// Checksum algorithms for framed data
+enum ChecksumType
+{
+    ChecksumType_None,
+    ChecksumType_Sum8,          ///< 8 bit sum of bytes
+    ChecksumType_CRC8,          ///< CRC-8 (poly 0x07, init 0x00)
+    ChecksumType_CRC16_CCITT,   ///< CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+    ChecksumType_CRC16_XMODEM,  ///< CRC-16/XMODEM (poly 0x1021, init 0x0000)
+    ChecksumType_CRC32,         ///< CRC-32 as used in ethernet, zip etc.
+    ChecksumType_INVALID ///< used for error cases
+};
+
+/// Returns the size of the checksum field in bytes
+unsigned checksumSize(ChecksumType type);
+
+/// Calculates the checksum of `n` bytes
+quint32 calcChecksum(ChecksumType type, const uchar* data, unsigned n);
+
+/// Reads a checksum field of `checksumSize(type)` bytes
+quint32 readChecksum(ChecksumType type, const uchar* data, bool littleEndian);
+
+/// Convert `ChecksumType` to string for representation
+QString checksumTypeToStr(ChecksumType type);
+
+/// Convert string to `ChecksumType`
+ChecksumType strToChecksumType(QString str);
+
+/// CRC-8, table driven
+quint8 crc8(const uchar* data, unsigned n, quint8 crc = 0);
+
+/**
+ * CRC-16 with CCITT polynomial (0x1021), table driven. Initial value
+ * is 0xFFFF for CRC-16/CCITT-FALSE and 0 for CRC-16/XMODEM.
+ */
+quint16 crc16Ccitt(const uchar* data, unsigned n, quint16 crc = 0xFFFF);
+
+/**
+ * CRC-32 (reflected, poly 0xEDB88320), slicing-by-8. Can be
+ * calculated in parts by passing the result of the previous part as
+ * `crc`.
+ */
+quint32 crc32(const uchar* data, unsigned n, quint32 crc = 0);
+
+#endif // CHECKSUM_H
@@ -21,6 +21,7 @@
 #include "ui_dataformatpanel.h"
 
 #include <QRadioButton>
+#include <QThread>
 #include <QtDebug>
 
 #include "utils.h"
@@ -29,9 +30,10 @@
 DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
     QWidget(parent),
     ui(new Ui::DataFormatPanel),
-    bsReader(port, this),
-    asciiReader(port, this),
-    framedReader(port, this),
+    bsReader(port),
+    asciiReader(port),
+    framedReader(port),
+    packetReader(port),
     demoReader(port, this)
 {
     ui->setupUi(this);
@@ -51,6 +53,7 @@ DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
     readerSelectButtons.addButton(ui->rbBinary);
     readerSelectButtons.addButton(ui->rbAscii);
     readerSelectButtons.addButton(ui->rbFramed);
+    readerSelectButtons.addButton(ui->rbPacket);
 
     connect(ui->rbBinary, &QRadioButton::toggled, [this](bool checked)
             {
@@ -66,6 +69,11 @@ DataFormatPanel::DataFormatPanel(QSerialPort* port, QWidget *parent) :
             {
                 if (checked) selectReader(&framedReader);
             });
+
+    connect(ui->rbPacket, &QRadioButton::toggled, [this](bool checked)
+            {
+                if (checked) selectReader(&packetReader);
+            });
 }
 
 DataFormatPanel::~DataFormatPanel()
@@ -86,7 +94,17 @@ Source* DataFormatPanel::activeSource()
 void DataFormatPanel::pause(bool enabled)
 {
     paused = enabled;
-    currentReader->pause(enabled);
+    // reader may be running in an I/O thread (see `InputPort`), its
+    // pause flag is set in its own thread
+    if (currentReader->thread() != QThread::currentThread())
+    {
+        QMetaObject::invokeMethod(currentReader, "pause", Qt::QueuedConnection,
+                                  Q_ARG(bool, enabled));
+    }
+    else
+    {
+        currentReader->pause(enabled);
+    }
     demoReader.pause(enabled);
 }
 
@@ -108,6 +126,7 @@ void DataFormatPanel::enableDemo(bool demoEnabled)
     ui->rbAscii->setDisabled(demoEnabled);
     ui->rbBinary->setDisabled(demoEnabled);
     ui->rbFramed->setDisabled(demoEnabled);
+    ui->rbPacket->setDisabled(demoEnabled);
 }
 
 bool DataFormatPanel::isDemoEnabled() const
@@ -135,6 +154,20 @@ void DataFormatPanel::selectReader(AbstractReader* reader)
     emit sourceChanged(currentReader);
 }
 
+void DataFormatPanel::moveReaderToThread(QThread* thread)
+{
+    currentReader->moveToThread(thread);
+}
+
+void DataFormatPanel::setDevice(QIODevice* device)
+{
+    bsReader.setDevice(device);
+    asciiReader.setDevice(device);
+    framedReader.setDevice(device);
+    packetReader.setDevice(device);
+    demoReader.setDevice(device);
+}
+
 uint64_t DataFormatPanel::bytesRead()
 {
     _bytesRead += currentReader->getBytesRead();
@@ -156,6 +189,10 @@ void DataFormatPanel::saveSettings(QSettings* settings)
     {
         format = "ascii";
     }
+    else if (selectedReader == &packetReader)
+    {
+        format = "packet";
+    }
     else // framed reader
     {
         format = "custom";
@@ -168,6 +205,7 @@ void DataFormatPanel::saveSettings(QSettings* settings)
     bsReader.saveSettings(settings);
     asciiReader.saveSettings(settings);
     framedReader.saveSettings(settings);
+    packetReader.saveSettings(settings);
 }
 
 void DataFormatPanel::loadSettings(QSettings* settings)
@@ -192,6 +230,11 @@ void DataFormatPanel::loadSettings(QSettings* settings)
     {
         selectReader(&framedReader);
         ui->rbFramed->setChecked(true);
+    }
+    else if (format == "packet")
+    {
+        selectReader(&packetReader);
+        ui->rbPacket->setChecked(true);
     } // else current selection stays
 
     settings->endGroup();
@@ -200,4 +243,5 @@ void DataFormatPanel::loadSettings(QSettings* settings)
     bsReader.loadSettings(settings);
     asciiReader.loadSettings(settings);
     framedReader.loadSettings(settings);
+    packetReader.loadSettings(settings);
 }
@@ -24,6 +24,7 @@
 #include <QWidget>
 #include <QButtonGroup>
 #include <QSerialPort>
+#include <QThread>
 #include <QList>
 #include <QSettings>
 #include <QtGlobal>
@@ -33,6 +34,7 @@
 #include "asciireader.h"
 #include "demoreader.h"
 #include "framedreader.h"
+#include "packetreader.h"
 #include "datarecorder.h"
 
 namespace Ui {
@@ -53,6 +55,14 @@ public:
     Source* activeSource();
     /// Returns total number of bytes read
     uint64_t bytesRead();
+    /**
+     * Moves active reader to given thread. Must be called from the
+     * reader's current thread. Reader selection must not change while
+     * reader is in another thread.
+     */
+    void moveReaderToThread(QThread* thread);
+    /// Changes the device that readers read from (ex: to a network socket)
+    void setDevice(QIODevice* device);
     /// Stores data format panel settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads data format panel settings from a `QSettings`.
@@ -72,9 +82,11 @@ private:
 
     QSerialPort* serialPort;
 
+    // readers don't have a parent so that they can be moved to another thread
     BinaryStreamReader bsReader;
     AsciiReader asciiReader;
     FramedReader framedReader;
+    PacketReader packetReader;
     /// Currently selected reader
     AbstractReader* currentReader;
     /// Disable current reader and enable a another one
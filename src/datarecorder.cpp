@@ -31,6 +31,7 @@ DataRecorder::DataRecorder(QObject *parent) :
     lastNumChannels = 0;
     disableBuffering = false;
     windowsLE = false;
+    writeSummary = false;
     timestampOpt = TimestampOption::disabled;
 
     fileStream.setRealNumberNotation(QTextStream::FixedNotation);
@@ -47,6 +48,8 @@ bool DataRecorder::startRecording(QString fileName, QString separator,
     Q_ASSERT(!file.isOpen());
     _sep =  separator;
     timestampOpt = ts;
+    _channelNames = channelNames;
+    stats.clear();
 
     // create directory if it doesn't exist
     {
@@ -96,8 +99,18 @@ void DataRecorder::feedIn(const SamplePack& data)
     }
     lastNumChannels = numChannels;
 
-    // write data
+    // update statistics for summary
     unsigned numSamples = data.numSamples();
+    if (writeSummary)
+    {
+        if (stats.size() < (int) numChannels) stats.resize(numChannels);
+        for (unsigned ci = 0; ci < numChannels; ci++)
+        {
+            stats[ci].add(data.data(ci), numSamples);
+        }
+    }
+
+    // write data
     for (unsigned int i = 0; i < numSamples; i++)
     {
         if (timestampOpt != TimestampOption::disabled)
@@ -119,10 +132,53 @@ void DataRecorder::stopRecording()
 {
     Q_ASSERT(file.isOpen());
 
+    if (writeSummary) saveSummary();
+
     file.close();
     lastNumChannels = 0;
 }
 
+QString DataRecorder::summaryFileName(QString fileName)
+{
+    QFileInfo fi(fileName);
+    QString suffix = fi.suffix().isEmpty() ? "csv" : fi.suffix();
+    return fi.dir().filePath(fi.completeBaseName() + "_summary." + suffix);
+}
+
+bool DataRecorder::saveSummary()
+{
+    QFile summaryFile(summaryFileName(file.fileName()));
+    if (!summaryFile.open(QIODevice::WriteOnly))
+    {
+        qCritical() << "Opening summary file " << summaryFile.fileName()
+                    << " failed with error: " << summaryFile.error();
+        return false;
+    }
+
+    QTextStream out(&summaryFile);
+    out.setRealNumberNotation(fileStream.realNumberNotation());
+    out.setRealNumberPrecision(fileStream.realNumberPrecision());
+
+    QStringList header({tr("channel"), tr("count"), tr("mean"), tr("rms"), tr("min"),
+                        tr("max"), tr("std_dev"), tr("peak_to_peak")});
+    out << header.join(_sep) << le();
+
+    for (int ci = 0; ci < stats.size(); ci++)
+    {
+        auto st = stats[ci].total();
+        out << (ci < _channelNames.size() ? _channelNames[ci] : QString::number(ci + 1)) << _sep
+            << st.count << _sep
+            << st.mean << _sep
+            << st.rms << _sep
+            << st.min << _sep
+            << st.max << _sep
+            << st.stdDev << _sep
+            << st.peakToPeak() << le();
+    }
+
+    return true;
+}
+
 QString DataRecorder::formatTimestamp() const
 {
     Q_ASSERT(timestampOpt != TimestampOption::disabled);
@@ -25,6 +25,7 @@
 #include <QTextStream>
 
 #include "sink.h"
+#include "channelstats.h"
 
 /**
  * Implemented as a `Sink` that writes incoming data to a file. Before
@@ -54,6 +55,17 @@ public:
      */
     bool windowsLE;
 
+    /**
+     * Write a summary file with statistics of each channel when
+     * recording is stopped. See `summaryFileName()`. `false` by
+     * default.
+     */
+    bool writeSummary;
+
+    /// Returns the summary file name for a recording file name:
+    /// "data.csv" → "data_summary.csv"
+    static QString summaryFileName(QString fileName);
+
     /**
      * Set floating point number precision.
      */
@@ -105,6 +117,11 @@ private:
     QTextStream fileStream;
     QString _sep;
     TimestampOption timestampOpt;
+    QStringList _channelNames;
+    QVector<ChannelStats> stats; ///< statistics of recorded data for summary
+
+    /// Writes summary file of current recording
+    bool saveSummary();
 
     /// Returns formatted timestamp
     QString formatTimestamp() const;
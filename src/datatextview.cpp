@@ -17,12 +17,22 @@
   along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QAbstractListModel>
+#include <QApplication>
+#include <QClipboard>
+#include <QScrollBar>
+#include <QAction>
+#include <algorithm>
+
 #include "datatextview.h"
 #include "ui_datatextview.h"
 
 #include "setting_defines.h"
 #include "utils.h"
 
+/// Maximum rate of text view updates
+#define UPDATE_INTERVAL_MS (50)
+
 class DataTextViewSink : public Sink
 {
 public:
@@ -41,6 +51,180 @@ private:
     DataTextView* _textView;
 };
 
+/**
+ * Stores the last `maxRows` rows of samples in a ring. Rows are
+ * formatted only when requested by the view, which is only for rows
+ * in the viewport.
+ *
+ * Incoming data is kept pending until `commit()` so that the view is
+ * updated once per batch instead of once per sample.
+ */
+class DataTextViewModel : public QAbstractListModel
+{
+public:
+    DataTextViewModel(QObject* parent = 0) :
+        QAbstractListModel(parent)
+    {
+        numCols = 1;
+        maxRows = 1;
+        decimals = 6;
+        first = 0;
+        count = 0;
+        ring.resize(maxRows * numCols);
+    }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : count;
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+    {
+        if (role != Qt::DisplayRole || !index.isValid() ||
+            index.row() >= (int) count)
+        {
+            return QVariant();
+        }
+
+        return rowText(index.row());
+    }
+
+    QString rowText(unsigned r) const
+    {
+        const double* data = row(r);
+        QString str;
+        for (unsigned ci = 0; ci < numCols; ci++)
+        {
+            str += QString::number(data[ci], 'f', decimals);
+            if (ci != numCols-1) str += " ";
+        }
+        return str;
+    }
+
+    void setMaxRows(unsigned value)
+    {
+        beginResetModel();
+
+        // keep the newest rows
+        unsigned newCount = std::min(count, value);
+        QVector<double> newRing(value * numCols);
+        for (unsigned i = 0; i < newCount; i++)
+        {
+            std::copy_n(row(count - newCount + i), numCols, newRing.data() + i * numCols);
+        }
+
+        ring = newRing;
+        maxRows = value;
+        first = 0;
+        count = newCount;
+        trimPending();
+
+        endResetModel();
+    }
+
+    void setDecimals(int value)
+    {
+        decimals = value;
+        if (count) emit dataChanged(index(0), index(count-1));
+    }
+
+    /// Stores data to be added with next `commit()`
+    void addData(const SamplePack& data)
+    {
+        const unsigned nc = data.numChannels();
+        const unsigned ns = data.numSamples();
+
+        if (nc != numCols)
+        {
+            beginResetModel();
+            numCols = nc;
+            ring.resize(maxRows * numCols);
+            first = 0;
+            count = 0;
+            pending.clear();
+            endResetModel();
+        }
+
+        // convert to row major
+        unsigned start = pending.size();
+        pending.resize(start + ns * nc);
+        for (unsigned ci = 0; ci < nc; ci++)
+        {
+            const double* cdata = data.data(ci);
+            for (unsigned i = 0; i < ns; i++)
+            {
+                pending[start + i * nc + ci] = cdata[i];
+            }
+        }
+
+        trimPending();
+    }
+
+    bool hasPending() const
+    {
+        return !pending.isEmpty();
+    }
+
+    /// Adds pending rows to the model, drops oldest rows if over `maxRows`
+    void commit()
+    {
+        const unsigned numNew = pending.size() / numCols;
+        if (numNew == 0) return;
+
+        if (count + numNew > maxRows)
+        {
+            unsigned numDrop = count + numNew - maxRows;
+            beginRemoveRows(QModelIndex(), 0, numDrop-1);
+            first = (first + numDrop) % maxRows;
+            count -= numDrop;
+            endRemoveRows();
+        }
+
+        beginInsertRows(QModelIndex(), count, count + numNew - 1);
+        for (unsigned i = 0; i < numNew; i++)
+        {
+            std::copy_n(pending.constData() + i * numCols, numCols,
+                        ring.data() + ((first + count) % maxRows) * numCols);
+            count++;
+        }
+        pending.clear();
+        endInsertRows();
+    }
+
+    void clear()
+    {
+        beginResetModel();
+        first = 0;
+        count = 0;
+        pending.clear();
+        endResetModel();
+    }
+
+private:
+    unsigned numCols;
+    unsigned maxRows;
+    int decimals;
+    QVector<double> ring;    ///< row major storage for `maxRows` rows
+    unsigned first;          ///< ring position of the oldest row
+    unsigned count;          ///< number of rows in ring
+    QVector<double> pending; ///< row major data waiting for `commit()`
+
+    const double* row(unsigned r) const
+    {
+        return ring.constData() + ((first + r) % maxRows) * numCols;
+    }
+
+    /// Drops pending rows that wouldn't be displayed anyway
+    void trimPending()
+    {
+        unsigned numPending = pending.size() / numCols;
+        if (numPending > maxRows)
+        {
+            pending.remove(0, (numPending - maxRows) * numCols);
+        }
+    }
+};
+
 DataTextView::DataTextView(Stream* stream, QWidget *parent) :
     QWidget(parent),
     ui(new Ui::DataTextView)
@@ -48,6 +232,8 @@ DataTextView::DataTextView(Stream* stream, QWidget *parent) :
     _stream = stream;
     ui->setupUi(this);
     sink = new DataTextViewSink(this);
+    model = new DataTextViewModel(this);
+    ui->textView->setModel(model);
 
     connect(ui->cbEnable, &QCheckBox::toggled, [this](bool checked)
             {
@@ -61,14 +247,32 @@ DataTextView::DataTextView(Stream* stream, QWidget *parent) :
                 }
             });
 
-    ui->textView->setMaximumBlockCount(ui->spNumLines->value());
+    model->setMaxRows(ui->spNumLines->value());
     connect(ui->spNumLines, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
             [this](int value)
             {
-                ui->textView->setMaximumBlockCount(value);
+                model->setMaxRows(value);
             });
 
-    connect(ui->pbClear, &QPushButton::clicked, ui->textView, &QPlainTextEdit::clear);
+    model->setDecimals(ui->spDecimals->value());
+    connect(ui->spDecimals, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int value)
+            {
+                model->setDecimals(value);
+            });
+
+    connect(ui->pbClear, &QPushButton::clicked, model, &DataTextViewModel::clear);
+
+    updateTimer.setSingleShot(true);
+    updateTimer.setInterval(UPDATE_INTERVAL_MS);
+    connect(&updateTimer, &QTimer::timeout, this, &DataTextView::updateView);
+
+    auto copyAction = new QAction("&Copy", ui->textView);
+    copyAction->setShortcut(QKeySequence::Copy);
+    copyAction->setShortcutContext(Qt::WidgetShortcut);
+    ui->textView->addAction(copyAction);
+    ui->textView->setContextMenuPolicy(Qt::ActionsContextMenu);
+    connect(copyAction, &QAction::triggered, this, &DataTextView::copySelection);
 }
 
 DataTextView::~DataTextView()
@@ -79,16 +283,32 @@ DataTextView::~DataTextView()
 
 void DataTextView::addData(const SamplePack& data)
 {
-    for (unsigned int i = 0; i < data.numSamples(); i++)
+    model->addData(data);
+    if (!updateTimer.isActive()) updateTimer.start();
+}
+
+void DataTextView::updateView()
+{
+    auto scrollBar = ui->textView->verticalScrollBar();
+    bool atBottom = scrollBar->value() == scrollBar->maximum();
+
+    model->commit();
+
+    // follow new data unless user scrolled up
+    if (atBottom) ui->textView->scrollToBottom();
+}
+
+void DataTextView::copySelection()
+{
+    auto indexes = ui->textView->selectionModel()->selectedIndexes();
+    std::sort(indexes.begin(), indexes.end());
+
+    QString text;
+    for (auto index : indexes)
     {
-        QString str;
-        for (unsigned ci = 0; ci < data.numChannels(); ci++)
-        {
-            str += QString::number(data.data(ci)[i], 'f', ui->spDecimals->value());
-            if (ci != data.numChannels()-1) str += " ";
-        }
-        ui->textView->appendPlainText(str);
+        text += model->rowText(index.row()) + "\n";
     }
+    QApplication::clipboard()->setText(text);
 }
 
 void DataTextView::saveSettings(QSettings* settings)
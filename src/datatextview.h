@@ -21,6 +21,7 @@
 #define DATATEXTVIEW_H
 
 #include <QWidget>
+#include <QTimer>
 
 #include "stream.h"
 
@@ -29,6 +30,7 @@ class DataTextView;
 }
 
 class DataTextViewSink;
+class DataTextViewModel;
 
 class DataTextView : public QWidget
 {
@@ -51,7 +53,14 @@ protected:
 private:
     Ui::DataTextView *ui;
     DataTextViewSink* sink;
+    DataTextViewModel* model;
     Stream* _stream;
+    QTimer updateTimer; ///< limits the rate of view updates
+
+    /// Adds pending data to the view in one batch
+    void updateView();
+    /// Copies selected rows to the clipboard
+    void copySelection();
 };
 
 #endif // DATATEXTVIEW_H
@@ -0,0 +1,390 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "expression.h"
+
+// during parsing constants and temporaries are tagged, they are
+// relocated after their counts are known
+#define TAG_CONST 0x4000u
+#define TAG_TEMP  0x8000u
+#define TAG_MASK  0xC000u
+#define MAX_REGS  0x4000u
+// limits recursion of the parser so that it can't overflow the stack
+#define MAX_DEPTH 256
+
+Expression::Expression()
+{
+    numInputs = 0;
+    numTemps = 0;
+    result = 0;
+    valid = false;
+}
+
+bool Expression::compile(const QString& text, unsigned numInputs, QString* error)
+{
+    this->numInputs = numInputs;
+    constants.clear();
+    code.clear();
+    numTemps = 0;
+    valid = false;
+
+    src = text;
+    pos = 0;
+    usedTemps = 0;
+    depth = 0;
+    err.clear();
+
+    unsigned r = parseSum();
+    skipSpace();
+    if (err.isEmpty() && pos < src.size())
+    {
+        fail(QString("Unexpected '%1'").arg(src[pos]));
+    }
+    if (err.isEmpty() && numInputs >= MAX_REGS)
+    {
+        fail("Too many inputs");
+    }
+
+    if (!err.isEmpty())
+    {
+        if (error != nullptr) *error = err;
+        code.clear();
+        return false;
+    }
+
+    for (auto& ins : code)
+    {
+        ins.dst = relocate(ins.dst);
+        ins.a = relocate(ins.a);
+        ins.b = relocate(ins.b);
+    }
+    result = relocate(r);
+
+    // storage for constants and temporaries, sized at evaluation
+    regBuffers.resize(constants.size() + numTemps);
+    for (auto& buf : regBuffers) buf.clear();
+    regs.resize(numInputs + constants.size() + numTemps);
+
+    valid = true;
+    return true;
+}
+
+unsigned Expression::relocate(unsigned reg) const
+{
+    if (reg & TAG_TEMP) return numInputs + constants.size() + (reg & ~TAG_MASK);
+    if (reg & TAG_CONST) return numInputs + (reg & ~TAG_MASK);
+    return reg;
+}
+
+bool Expression::fail(const QString& message)
+{
+    if (err.isEmpty()) err = message;
+    return false;
+}
+
+void Expression::skipSpace()
+{
+    while (pos < src.size() && src[pos].isSpace()) pos++;
+}
+
+bool Expression::accept(QChar c)
+{
+    skipSpace();
+    if (pos < src.size() && src[pos] == c)
+    {
+        pos++;
+        return true;
+    }
+    return false;
+}
+
+unsigned Expression::constant(double value)
+{
+    int i = constants.indexOf(value);
+    if (i < 0)
+    {
+        // tag bits can't hold more
+        if ((unsigned) constants.size() >= MAX_REGS)
+        {
+            fail("Too many constants");
+            return 0;
+        }
+        constants.append(value);
+        i = constants.size() - 1;
+    }
+    return TAG_CONST | i;
+}
+
+unsigned Expression::emitOp(Op op, unsigned a, unsigned b)
+{
+    // operands are released in reverse order of allocation
+    if ((b & TAG_TEMP) && (b & ~TAG_MASK) == usedTemps - 1) usedTemps--;
+    if ((a & TAG_TEMP) && (a & ~TAG_MASK) == usedTemps - 1) usedTemps--;
+
+    if (usedTemps >= MAX_REGS)
+    {
+        fail("Expression is too large");
+        return 0;
+    }
+
+    unsigned dst = TAG_TEMP | usedTemps;
+    usedTemps++;
+    numTemps = qMax(numTemps, usedTemps);
+
+    code.append({op, (quint16) dst, (quint16) a, (quint16) b});
+    return dst;
+}
+
+// sum := product (('+' | '-') product)*
+unsigned Expression::parseSum()
+{
+    unsigned r = parseProduct();
+    while (err.isEmpty())
+    {
+        if (accept('+')) r = emitOp(OpAdd, r, parseProduct());
+        else if (accept('-')) r = emitOp(OpSub, r, parseProduct());
+        else break;
+    }
+    return r;
+}
+
+// product := unary (('*' | '/') unary)*
+unsigned Expression::parseProduct()
+{
+    unsigned r = parseUnary();
+    while (err.isEmpty())
+    {
+        if (accept('*')) r = emitOp(OpMul, r, parseUnary());
+        else if (accept('/')) r = emitOp(OpDiv, r, parseUnary());
+        else break;
+    }
+    return r;
+}
+
+// unary := '-' unary | '+' unary | power
+//
+// Every recursion of the grammar goes through here, so nesting depth
+// is checked here.
+unsigned Expression::parseUnary()
+{
+    if (depth >= MAX_DEPTH)
+    {
+        fail("Expression too deeply nested");
+        return 0;
+    }
+
+    depth++;
+    unsigned r;
+    if (accept('-')) r = emitOp(OpNeg, parseUnary());
+    else if (accept('+')) r = parseUnary();
+    else r = parsePower();
+    depth--;
+    return r;
+}
+
+// power := primary ('^' unary)?   (right associative)
+unsigned Expression::parsePower()
+{
+    unsigned r = parsePrimary();
+    if (err.isEmpty() && accept('^'))
+    {
+        r = emitOp(OpPow, r, parseUnary());
+    }
+    return r;
+}
+
+// primary := number | channel | 'pi' | function '(' args ')' | '(' sum ')'
+unsigned Expression::parsePrimary()
+{
+    skipSpace();
+    if (pos >= src.size())
+    {
+        fail("Unexpected end of expression");
+        return 0;
+    }
+
+    if (accept('('))
+    {
+        unsigned r = parseSum();
+        if (err.isEmpty() && !accept(')')) fail("Missing ')'");
+        return r;
+    }
+
+    QChar c = src[pos];
+    if (c.isDigit() || c == '.')
+    {
+        int start = pos;
+        while (pos < src.size() && (src[pos].isDigit() || src[pos] == '.')) pos++;
+        // exponent
+        if (pos < src.size() && (src[pos] == 'e' || src[pos] == 'E'))
+        {
+            int save = pos;
+            pos++;
+            if (pos < src.size() && (src[pos] == '+' || src[pos] == '-')) pos++;
+            if (pos < src.size() && src[pos].isDigit())
+            {
+                while (pos < src.size() && src[pos].isDigit()) pos++;
+            }
+            else
+            {
+                pos = save;
+            }
+        }
+        bool ok;
+        double value = src.mid(start, pos - start).toDouble(&ok);
+        if (!ok)
+        {
+            fail(QString("Invalid number '%1'").arg(src.mid(start, pos - start)));
+            return 0;
+        }
+        return constant(value);
+    }
+
+    if (c.isLetter())
+    {
+        int start = pos;
+        while (pos < src.size() && (src[pos].isLetterOrNumber() || src[pos] == '_')) pos++;
+        QString name = src.mid(start, pos - start).toLower();
+
+        if (name == "pi") return constant(M_PI);
+
+        if (name.startsWith("ch") && name.size() > 2)
+        {
+            bool ok;
+            unsigned ch = name.mid(2).toUInt(&ok);
+            if (ok)
+            {
+                if (ch < 1 || ch > numInputs)
+                {
+                    fail(QString("Channel '%1' doesn't exist").arg(name));
+                    return 0;
+                }
+                return ch - 1;
+            }
+        }
+
+        return parseFunction(name);
+    }
+
+    fail(QString("Unexpected '%1'").arg(c));
+    return 0;
+}
+
+unsigned Expression::parseFunction(const QString& name)
+{
+    static const struct {const char* name; Op op; int numArgs;} functions[] =
+    {
+        {"sqrt", OpSqrt, 1}, {"abs", OpAbs, 1}, {"sin", OpSin, 1},
+        {"cos", OpCos, 1}, {"tan", OpTan, 1}, {"exp", OpExp, 1},
+        {"log", OpLog, 1}, {"log10", OpLog10, 1},
+        {"atan2", OpAtan2, 2}, {"min", OpMin, 2}, {"max", OpMax, 2},
+        {"pow", OpPow, 2}
+    };
+
+    for (auto& f : functions)
+    {
+        if (name != f.name) continue;
+
+        if (!accept('('))
+        {
+            fail(QString("Missing '(' after '%1'").arg(name));
+            return 0;
+        }
+        unsigned a = parseSum();
+        unsigned b = 0;
+        if (f.numArgs == 2 && err.isEmpty())
+        {
+            if (!accept(','))
+            {
+                fail(QString("'%1' takes 2 arguments").arg(name));
+                return 0;
+            }
+            b = parseSum();
+        }
+        if (err.isEmpty() && !accept(')'))
+        {
+            fail("Missing ')'");
+        }
+        if (!err.isEmpty()) return 0;
+        return emitOp(f.op, a, b);
+    }
+
+    fail(QString("Unknown name '%1'").arg(name));
+    return 0;
+}
+
+void Expression::evaluate(const double* const* inputs, unsigned ns, double* out)
+{
+    Q_ASSERT(valid);
+
+    // setup register columns
+    for (unsigned i = 0; i < numInputs; i++)
+    {
+        regs[i] = inputs[i];
+    }
+    for (int i = 0; i < regBuffers.size(); i++)
+    {
+        auto& buf = regBuffers[i];
+        if ((unsigned) buf.size() < ns)
+        {
+            if (i < constants.size())
+            {
+                buf.fill(constants[i], ns);
+            }
+            else
+            {
+                buf.resize(ns);
+            }
+        }
+        regs[numInputs + i] = buf.constData();
+    }
+
+    for (auto& ins : code)
+    {
+        double* d = const_cast<double*>(regs[ins.dst]);
+        const double* a = regs[ins.a];
+        const double* b = regs[ins.b];
+
+        switch (ins.op)
+        {
+            case OpAdd:   for (unsigned i = 0; i < ns; i++) d[i] = a[i] + b[i]; break;
+            case OpSub:   for (unsigned i = 0; i < ns; i++) d[i] = a[i] - b[i]; break;
+            case OpMul:   for (unsigned i = 0; i < ns; i++) d[i] = a[i] * b[i]; break;
+            case OpDiv:   for (unsigned i = 0; i < ns; i++) d[i] = a[i] / b[i]; break;
+            case OpPow:   for (unsigned i = 0; i < ns; i++) d[i] = pow(a[i], b[i]); break;
+            case OpNeg:   for (unsigned i = 0; i < ns; i++) d[i] = -a[i]; break;
+            case OpSqrt:  for (unsigned i = 0; i < ns; i++) d[i] = sqrt(a[i]); break;
+            case OpAbs:   for (unsigned i = 0; i < ns; i++) d[i] = fabs(a[i]); break;
+            case OpSin:   for (unsigned i = 0; i < ns; i++) d[i] = sin(a[i]); break;
+            case OpCos:   for (unsigned i = 0; i < ns; i++) d[i] = cos(a[i]); break;
+            case OpTan:   for (unsigned i = 0; i < ns; i++) d[i] = tan(a[i]); break;
+            case OpExp:   for (unsigned i = 0; i < ns; i++) d[i] = exp(a[i]); break;
+            case OpLog:   for (unsigned i = 0; i < ns; i++) d[i] = log(a[i]); break;
+            case OpLog10: for (unsigned i = 0; i < ns; i++) d[i] = log10(a[i]); break;
+            case OpAtan2: for (unsigned i = 0; i < ns; i++) d[i] = atan2(a[i], b[i]); break;
+            case OpMin:   for (unsigned i = 0; i < ns; i++) d[i] = fmin(a[i], b[i]); break;
+            case OpMax:   for (unsigned i = 0; i < ns; i++) d[i] = fmax(a[i], b[i]); break;
+        }
+    }
+
+    memcpy(out, regs[result], ns * sizeof(double));
+}
@@ -0,0 +1,118 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * Arithmetic expression over input channels, such as
+ * `sqrt(ch1^2 + ch2^2)`.
+ *
+ * Expression is compiled once into a register based bytecode. Each
+ * register is a column of samples; an instruction processes all
+ * samples of its operands before the next instruction runs, so the
+ * interpretation overhead is per pack, not per sample.
+ *
+ * Supported syntax:
+ * - channels: `ch1` ... `chN` (1 based)
+ * - numbers, `pi`
+ * - operators: `+ - * / ^` and unary minus, parentheses
+ * - functions: `sqrt abs sin cos tan exp log log10` (1 argument),
+ *   `atan2 min max pow` (2 arguments)
+ */
+class Expression
+{
+public:
+    Expression();
+
+    /**
+     * Compiles an expression.
+     *
+     * @param text expression
+     * @param numInputs number of input channels that can be referenced
+     * @param error if not null, set to error message on failure
+     * @return false if expression is invalid
+     */
+    bool compile(const QString& text, unsigned numInputs, QString* error = nullptr);
+
+    /// Returns true if a valid expression is compiled
+    bool isValid() const {return valid;};
+
+    /**
+     * Evaluates the expression.
+     *
+     * @param inputs column of each input channel
+     * @param ns number of samples in each column
+     * @param out result column, `ns` long
+     */
+    void evaluate(const double* const* inputs, unsigned ns, double* out);
+
+private:
+    enum Op : quint8
+    {
+        OpAdd, OpSub, OpMul, OpDiv, OpPow, OpNeg,
+        OpSqrt, OpAbs, OpSin, OpCos, OpTan, OpExp, OpLog, OpLog10,
+        OpAtan2, OpMin, OpMax
+    };
+
+    struct Instruction
+    {
+        Op op;
+        quint16 dst, a, b;
+    };
+
+    /// Register layout: inputs, then constants, then temporaries
+    unsigned numInputs;
+    QVector<double> constants;
+    unsigned numTemps;
+    QVector<Instruction> code;
+    unsigned result;            ///< register holding the result
+    bool valid;
+
+    QVector<QVector<double>> regBuffers; ///< storage of constants and temps
+    QVector<const double*> regs;         ///< columns of all registers
+
+    // parser state, only used during compile
+    QString src;
+    int pos;
+    unsigned usedTemps;
+    unsigned depth;             ///< nesting depth, limits recursion
+    QString err;
+
+    unsigned parseSum();
+    unsigned parseProduct();
+    unsigned parseUnary();
+    unsigned parsePower();
+    unsigned parsePrimary();
+    unsigned parseFunction(const QString& name);
+
+    void skipSpace();
+    bool accept(QChar c);
+    bool fail(const QString& message);
+    unsigned constant(double value);
+    /// Emits an instruction, releasing temp operands and allocating result
+    unsigned emitOp(Op op, unsigned a, unsigned b = 0);
+    /// Maps registers used during parsing to final register indexes
+    unsigned relocate(unsigned reg) const;
+};
+
+#endif // EXPRESSION_H
@@ -0,0 +1,140 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <algorithm>
+
+#include "fft.h"
+
+bool FFT::isValidSize(unsigned n)
+{
+    return n >= MIN_SIZE && (n & (n - 1)) == 0;
+}
+
+FFT::FFT(unsigned n)
+{
+    Q_ASSERT(isValidSize(n));
+
+    _n = n;
+    m = n / 2;
+
+    unsigned bits = 0;
+    while ((1u << bits) < m) bits++;
+
+    bitRev.resize(m);
+    for (unsigned i = 0; i < m; i++)
+    {
+        unsigned r = 0;
+        for (unsigned b = 0; b < bits; b++)
+        {
+            if (i & (1u << b)) r |= 1u << (bits - 1 - b);
+        }
+        bitRev[i] = r;
+    }
+
+    // stage with half size `h` uses exp(-iπj/h) for j in [0, h)
+    twRe.resize(m > 1 ? m - 1 : 1);
+    twIm.resize(twRe.size());
+    for (unsigned h = 1; h < m; h *= 2)
+    {
+        for (unsigned j = 0; j < h; j++)
+        {
+            double a = -M_PI * j / h;
+            twRe[h - 1 + j] = cos(a);
+            twIm[h - 1 + j] = sin(a);
+        }
+    }
+
+    splitRe.resize(m + 1);
+    splitIm.resize(m + 1);
+    for (unsigned k = 0; k <= m; k++)
+    {
+        double a = -2 * M_PI * k / n;
+        splitRe[k] = cos(a);
+        splitIm[k] = sin(a);
+    }
+}
+
+void FFT::complexTransform(double* re, double* im) const
+{
+    for (unsigned i = 0; i < m; i++)
+    {
+        unsigned j = bitRev[i];
+        if (i < j)
+        {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    for (unsigned h = 1; h < m; h *= 2)
+    {
+        const double* wr = twRe.constData() + h - 1;
+        const double* wi = twIm.constData() + h - 1;
+
+        for (unsigned start = 0; start < m; start += 2*h)
+        {
+            double* __restrict ar = re + start;
+            double* __restrict ai = im + start;
+            double* __restrict br = ar + h;
+            double* __restrict bi = ai + h;
+
+            for (unsigned j = 0; j < h; j++)
+            {
+                double tr = br[j] * wr[j] - bi[j] * wi[j];
+                double ti = br[j] * wi[j] + bi[j] * wr[j];
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] = ar[j] + tr;
+                ai[j] = ai[j] + ti;
+            }
+        }
+    }
+}
+
+void FFT::transform(const double* input, double* re, double* im) const
+{
+    // pack even samples to real, odd samples to imaginary part
+    QVector<double> zr(m), zi(m);
+    for (unsigned i = 0; i < m; i++)
+    {
+        zr[i] = input[2*i];
+        zi[i] = input[2*i + 1];
+    }
+
+    complexTransform(zr.data(), zi.data());
+
+    // split: X[k] = E[k] + W^k O[k] where E, O are transforms of even
+    // and odd samples recovered from Z[k] and conj(Z[m-k])
+    for (unsigned k = 0; k <= m; k++)
+    {
+        unsigned k1 = k % m;
+        unsigned k2 = (m - k) % m;
+        double a = zr[k1], b = zi[k1];
+        double c = zr[k2], d = zi[k2];
+
+        double er = (a + c) / 2;
+        double ei = (b - d) / 2;
+        double orr = (b + d) / 2;
+        double oi = (c - a) / 2;
+
+        re[k] = er + splitRe[k] * orr - splitIm[k] * oi;
+        im[k] = ei + splitRe[k] * oi + splitIm[k] * orr;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <QVector>
+
+/**
+ * Real input, power of 2 sized forward FFT.
+ *
+ * A real transform of size `n` is computed with a complex radix-2
+ * transform of size `n/2` followed by a split step. Bit reversal
+ * permutation and twiddle factors are computed once in the
+ * constructor. Twiddles of each stage are stored contiguously and
+ * real/imaginary parts are kept in separate arrays so that butterfly
+ * loops are simple enough to be vectorized by the compiler.
+ *
+ * `transform()` is const and doesn't modify the object, so a single
+ * instance can be used from multiple threads.
+ */
+class FFT
+{
+public:
+    /// Minimum supported transform size
+    static const unsigned MIN_SIZE = 4;
+
+    /// @param n transform size, must be a power of 2 and >= `MIN_SIZE`
+    explicit FFT(unsigned n);
+
+    /// Returns true if `n` is a valid transform size
+    static bool isValidSize(unsigned n);
+
+    /// Transform size
+    unsigned size() const {return _n;};
+    /// Number of output bins (`size()/2 + 1`)
+    unsigned numBins() const {return _n/2 + 1;};
+
+    /**
+     * Computes the transform of `size()` real samples.
+     *
+     * @param input `size()` samples
+     * @param re real part of output, `numBins()` long
+     * @param im imaginary part of output, `numBins()` long
+     */
+    void transform(const double* input, double* re, double* im) const;
+
+private:
+    unsigned _n;                ///< real transform size
+    unsigned m;                 ///< complex transform size (`_n/2`)
+    QVector<unsigned> bitRev;   ///< bit reversal permutation of `m` indexes
+    /// Twiddles of complex stages; stage with half size `h` starts at `h-1`
+    QVector<double> twRe, twIm;
+    /// Twiddles of the real split step, `exp(-2πik/n)` for `k` in `[0, m]`
+    QVector<double> splitRe, splitIm;
+
+    /// In place complex transform of size `m`
+    void complexTransform(double* re, double* im) const;
+};
+
+#endif // FFT_H
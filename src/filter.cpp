@@ -0,0 +1,270 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "filter.h"
+#include "channelinfomodel.h"
+
+Filter::Filter()
+{
+    _enabled = false;
+    _numChannels = 0;
+    _hasX = false;
+    infoModel = nullptr;
+    _decimation = 1;
+    phase = 0;
+}
+
+void Filter::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+    reset();
+}
+
+void Filter::setIir(const QVector<Biquad>& sections)
+{
+    iir = sections;
+    reset();
+}
+
+void Filter::setFir(const QVector<double>& taps, unsigned decimation)
+{
+    Q_ASSERT(decimation > 0);
+
+    firReversed.resize(taps.size());
+    for (int i = 0; i < taps.size(); i++)
+    {
+        firReversed[i] = taps[taps.size() - 1 - i];
+    }
+    _decimation = decimation;
+    reset();
+}
+
+void Filter::reset()
+{
+    iirStates.resize(_numChannels);
+    histories.resize(_numChannels);
+    unsigned historySize = firReversed.isEmpty() ? 0 : firReversed.size() - 1;
+    for (unsigned ci = 0; ci < _numChannels; ci++)
+    {
+        iirStates[ci].fill(0, 2 * iir.size());
+        histories[ci].fill(0, historySize);
+    }
+    phase = 0;
+}
+
+void Filter::setInfoModel(const ChannelInfoModel* model)
+{
+    infoModel = model;
+}
+
+bool Filter::hasX() const
+{
+    return _hasX;
+}
+
+unsigned Filter::numChannels() const
+{
+    return _numChannels;
+}
+
+void Filter::setNumChannels(unsigned nc, bool x)
+{
+    _numChannels = nc;
+    _hasX = x;
+    reset();
+
+    Sink::setNumChannels(nc, x);
+    updateNumChannels();
+}
+
+void Filter::feedIn(const SamplePack& data)
+{
+    // calibration, gain and offset are applied before filtering so
+    // that followers (recorder) get processed data at the input rate
+    SamplePack* mPack = nullptr;
+    if (infoModel != nullptr &&
+        (infoModel->gainOrOffsetEn() || infoModel->calibrationEn()))
+    {
+        mPack = new SamplePack(data);
+        infoModel->apply(mPack);
+    }
+    const SamplePack& pData = (mPack == nullptr) ? data : *mPack;
+
+    // followers tap the unfiltered data
+    Sink::feedIn(pData);
+    filterPack(pData);
+
+    if (mPack != nullptr) delete mPack;
+}
+
+void Filter::filterPack(const SamplePack& data)
+{
+    if (!_enabled || data.hasX())
+    {
+        feedOut(data);
+        return;
+    }
+
+    unsigned ns = data.numSamples();
+    unsigned numOut = phase < ns ? (ns - phase - 1) / _decimation + 1 : 0;
+
+    // filter states are updated even if there is no output sample
+    SamplePack* out = numOut ? new SamplePack(numOut, _numChannels) : nullptr;
+    for (unsigned ci = 0; ci < _numChannels; ci++)
+    {
+        filterChannel(ci, data.data(ci), ns, out ? out->data(ci) : nullptr, numOut);
+    }
+    phase = phase + numOut * _decimation - ns;
+
+    if (out != nullptr)
+    {
+        feedOut(*out);
+        delete out;
+    }
+}
+
+void Filter::filterChannel(unsigned ci, const double* in, unsigned ns,
+                           double* out, unsigned numOut)
+{
+    QVector<double>& history = histories[ci];
+    const unsigned hs = history.size();
+
+    buffer.resize(hs + ns);
+    double* buf = buffer.data();
+    if (hs) memcpy(buf, history.constData(), hs * sizeof(double));
+    memcpy(buf + hs, in, ns * sizeof(double));
+
+    // IIR, transposed direct form II, section by section over the whole block
+    double* x = buf + hs;
+    double* state = iirStates[ci].data();
+    for (int s = 0; s < iir.size(); s++)
+    {
+        const Biquad& q = iir[s];
+        double s1 = state[2*s];
+        double s2 = state[2*s + 1];
+        for (unsigned i = 0; i < ns; i++)
+        {
+            double y = q.b0 * x[i] + s1;
+            s1 = q.b1 * x[i] - q.a1 * y + s2;
+            s2 = q.b2 * x[i] - q.a2 * y;
+            x[i] = y;
+        }
+        state[2*s] = s1;
+        state[2*s + 1] = s2;
+    }
+
+    // decimating FIR, only kept outputs are calculated
+    if (firReversed.isEmpty())
+    {
+        for (unsigned k = 0; k < numOut; k++)
+        {
+            out[k] = x[phase + k * _decimation];
+        }
+    }
+    else
+    {
+        const double* h = firReversed.constData();
+        const unsigned nt = firReversed.size();
+        for (unsigned k = 0; k < numOut; k++)
+        {
+            // y[n] = sum(h[j] * x[n-j]) = sum(hr[i] * buf[n+i])
+            const double* w = buf + phase + k * _decimation;
+            // independent accumulators so that the compiler can use
+            // SIMD lanes without reordering floating point sums
+            double acc[4] = {0, 0, 0, 0};
+            unsigned i = 0;
+            for (; i + 4 <= nt; i += 4)
+            {
+                acc[0] += h[i]   * w[i];
+                acc[1] += h[i+1] * w[i+1];
+                acc[2] += h[i+2] * w[i+2];
+                acc[3] += h[i+3] * w[i+3];
+            }
+            for (; i < nt; i++)
+            {
+                acc[0] += h[i] * w[i];
+            }
+            out[k] = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+    }
+
+    // keep last samples for the next pack
+    if (hs)
+    {
+        memcpy(history.data(), buf + ns, hs * sizeof(double));
+    }
+}
+
+QVector<Filter::Biquad> Filter::butterworth(IirType type, unsigned order, double cutoff)
+{
+    QVector<Biquad> sections;
+    if (type == IirNone || order == 0) return sections;
+
+    unsigned n = order + order % 2;
+    double w0 = 2 * M_PI * cutoff;
+    double cosw = cos(w0);
+    for (unsigned k = 0; k < n / 2; k++)
+    {
+        double q = 1. / (2 * cos(M_PI * (2*k + 1) / (2*n)));
+        double alpha = sin(w0) / (2 * q);
+        double a0 = 1 + alpha;
+
+        Biquad s;
+        if (type == IirLowPass)
+        {
+            s.b0 = (1 - cosw) / 2 / a0;
+            s.b1 = (1 - cosw) / a0;
+        }
+        else
+        {
+            s.b0 = (1 + cosw) / 2 / a0;
+            s.b1 = -(1 + cosw) / a0;
+        }
+        s.b2 = s.b0;
+        s.a1 = -2 * cosw / a0;
+        s.a2 = (1 - alpha) / a0;
+        sections.append(s);
+    }
+    return sections;
+}
+
+QVector<double> Filter::lowPassFir(unsigned numTaps, double cutoff)
+{
+    QVector<double> taps(numTaps);
+    double center = (numTaps - 1) / 2.;
+    double sum = 0;
+    for (unsigned i = 0; i < numTaps; i++)
+    {
+        double t = i - center;
+        double sinc = t == 0 ? 2 * cutoff : sin(2 * M_PI * cutoff * t) / (M_PI * t);
+        double window = numTaps > 1 ?
+            0.42 - 0.5 * cos(2 * M_PI * i / (numTaps - 1))
+                 + 0.08 * cos(4 * M_PI * i / (numTaps - 1)) : 1;
+        taps[i] = sinc * window;
+        sum += taps[i];
+    }
+    for (auto& t : taps)
+    {
+        t /= sum;
+    }
+    return taps;
+}
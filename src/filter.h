@@ -0,0 +1,141 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <QVector>
+
+#include "sink.h"
+#include "source.h"
+
+class ChannelInfoModel;
+
+/**
+ * Filtering and decimation stage to be placed between a reader and
+ * the `Stream`.
+ *
+ * Incoming data is first filtered with a cascade of biquad IIR
+ * sections, then with a decimating FIR filter which only calculates
+ * the output samples that are kept. Filter state is kept per channel
+ * so that packs of any size can be processed.
+ *
+ * When a channel info model is set, calibration, gain and offset of
+ * channels are applied before filtering (even when disabled).
+ *
+ * As a `Sink`, followers receive the processed but unfiltered input
+ * data. As a `Source`, connected sinks receive the filtered output.
+ * When disabled, input is passed through without filtering.
+ */
+class Filter : public Sink, public Source
+{
+public:
+    /// Second order IIR section, `a0` is normalized to 1
+    struct Biquad
+    {
+        double b0, b1, b2, a1, a2;
+    };
+
+    enum IirType
+    {
+        IirNone,
+        IirLowPass,
+        IirHighPass
+    };
+
+    Filter();
+
+    bool isEnabled() const {return _enabled;};
+    unsigned decimation() const {return _decimation;};
+
+    /// Enables/disables filtering, state is reset
+    void setEnabled(bool enabled);
+    /// Sets IIR sections, empty list disables IIR filtering
+    void setIir(const QVector<Biquad>& sections);
+    /**
+     * Sets FIR filter and decimation factor.
+     *
+     * @param taps filter coefficients, empty means no filtering
+     * @param decimation only every `decimation`th output sample is kept
+     */
+    void setFir(const QVector<double>& taps, unsigned decimation = 1);
+    /// Clears filter states
+    void reset();
+    /**
+     * Sets the model to take channel calibration, gain and offset
+     * from, `nullptr` disables processing.
+     *
+     * @note Sink that applies them itself should be told not to,
+     * see `Stream::setApplyGainOffset()`.
+     */
+    void setInfoModel(const ChannelInfoModel* model);
+
+    /**
+     * Designs a Butterworth filter as biquad sections.
+     *
+     * @param type filter type, `IirNone` returns an empty list
+     * @param order filter order, rounded up to an even number
+     * @param cutoff cutoff frequency normalized to sample rate (0, 0.5)
+     */
+    static QVector<Biquad> butterworth(IirType type, unsigned order, double cutoff);
+    /**
+     * Designs a windowed-sinc (Blackman) low pass FIR filter with
+     * unity DC gain.
+     *
+     * @param numTaps number of coefficients
+     * @param cutoff cutoff frequency normalized to sample rate (0, 0.5]
+     */
+    static QVector<double> lowPassFir(unsigned numTaps, double cutoff);
+
+    // implementations for `Source`
+    bool hasX() const override;
+    unsigned numChannels() const override;
+
+protected:
+    // implementations for `Sink`
+    void feedIn(const SamplePack& data) override;
+    void setNumChannels(unsigned nc, bool x) override;
+
+private:
+    bool _enabled;
+    unsigned _numChannels;
+    bool _hasX;
+    const ChannelInfoModel* infoModel;
+
+    QVector<Biquad> iir;
+    QVector<double> firReversed;  ///< FIR taps in reverse order
+    unsigned _decimation;
+
+    /// IIR states (2 per section) of each channel
+    QVector<QVector<double>> iirStates;
+    /// Last `taps-1` (IIR filtered) input samples of each channel
+    QVector<QVector<double>> histories;
+    /// Offset of the next output sample in the next input pack
+    unsigned phase;
+    /// Work buffer: history followed by current input
+    QVector<double> buffer;
+
+    /// Filters (and decimates) a pack and feeds the output
+    void filterPack(const SamplePack& data);
+    /// Filters a single channel into `out`, `numOut` samples
+    void filterChannel(unsigned ci, const double* in, unsigned ns,
+                       double* out, unsigned numOut);
+};
+
+#endif // FILTER_H
@@ -0,0 +1,134 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "filterpanel.h"
+#include "ui_filterpanel.h"
+
+#include "setting_defines.h"
+#include "utils.h"
+
+/// Anti-aliasing filter cutoff relative to the output Nyquist frequency
+#define FIR_CUTOFF_RATIO 0.8
+
+FilterPanel::FilterPanel(Filter* filter, QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::FilterPanel)
+{
+    _filter = filter;
+    ui->setupUi(this);
+
+    connect(ui->cbEnable, &QCheckBox::toggled,
+            [this](bool enabled)
+            {
+                _filter->setEnabled(enabled);
+            });
+
+    connect(ui->cbIirType, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            [this](int)
+            {
+                updateIir();
+            });
+    connect(ui->spIirOrder, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int)
+            {
+                updateIir();
+            });
+    connect(ui->spIirCutoff, SELECT<double>::OVERLOAD_OF(&QDoubleSpinBox::valueChanged),
+            [this](double)
+            {
+                updateIir();
+            });
+
+    connect(ui->spDecimation, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int)
+            {
+                updateFir();
+            });
+    connect(ui->spFirTaps, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int)
+            {
+                updateFir();
+            });
+
+    // apply initial settings
+    updateIir();
+    updateFir();
+}
+
+FilterPanel::~FilterPanel()
+{
+    delete ui;
+}
+
+void FilterPanel::updateIir()
+{
+    auto type = (Filter::IirType) ui->cbIirType->currentIndex();
+    ui->spIirOrder->setEnabled(type != Filter::IirNone);
+    ui->spIirCutoff->setEnabled(type != Filter::IirNone);
+
+    _filter->setIir(Filter::butterworth(type,
+                                        ui->spIirOrder->value(),
+                                        ui->spIirCutoff->value()));
+}
+
+void FilterPanel::updateFir()
+{
+    unsigned decimation = ui->spDecimation->value();
+    ui->spFirTaps->setEnabled(decimation > 1);
+
+    if (decimation > 1)
+    {
+        double cutoff = 0.5 / decimation * FIR_CUTOFF_RATIO;
+        _filter->setFir(Filter::lowPassFir(ui->spFirTaps->value(), cutoff), decimation);
+    }
+    else
+    {
+        _filter->setFir({}, 1);
+    }
+}
+
+void FilterPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Filter);
+    settings->setValue(SG_Filter_Enabled, ui->cbEnable->isChecked());
+    settings->setValue(SG_Filter_IirType, ui->cbIirType->currentIndex());
+    settings->setValue(SG_Filter_IirOrder, ui->spIirOrder->value());
+    settings->setValue(SG_Filter_IirCutoff, ui->spIirCutoff->value());
+    settings->setValue(SG_Filter_Decimation, ui->spDecimation->value());
+    settings->setValue(SG_Filter_FirTaps, ui->spFirTaps->value());
+    settings->endGroup();
+}
+
+void FilterPanel::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Filter);
+    ui->cbIirType->setCurrentIndex(
+        settings->value(SG_Filter_IirType, ui->cbIirType->currentIndex()).toInt());
+    ui->spIirOrder->setValue(
+        settings->value(SG_Filter_IirOrder, ui->spIirOrder->value()).toInt());
+    ui->spIirCutoff->setValue(
+        settings->value(SG_Filter_IirCutoff, ui->spIirCutoff->value()).toDouble());
+    ui->spDecimation->setValue(
+        settings->value(SG_Filter_Decimation, ui->spDecimation->value()).toInt());
+    ui->spFirTaps->setValue(
+        settings->value(SG_Filter_FirTaps, ui->spFirTaps->value()).toInt());
+    ui->cbEnable->setChecked(
+        settings->value(SG_Filter_Enabled, ui->cbEnable->isChecked()).toBool());
+    settings->endGroup();
+}
@@ -55,6 +55,7 @@ public:
 /// Abstract base class for writable frame buffers
 class WFrameBuffer : public ResizableBuffer
 {
+public:
     /// Add samples to the buffer
     virtual void addSamples(double* samples, unsigned n) = 0;
     /// Reset all data to 0
@@ -19,7 +19,6 @@
 
 #include <QtDebug>
 #include <QtEndian>
-#include "byteswap.h"
 
 #include "framedreader.h"
 
@@ -35,8 +34,8 @@ FramedReader::FramedReader(QIODevice* device, QObject* parent) :
     isSizeField2B = (_settingsWidget.sizeFieldType() == FramedReaderSettings::SizeFieldType::Field2Byte);
     frameSize = _settingsWidget.fixedFrameSize();
     syncWord = _settingsWidget.syncWord();
-    checksumEnabled = _settingsWidget.isChecksumEnabled();
-    onNumberFormatChanged(_settingsWidget.numberFormat());
+    setChecksumType(_settingsWidget.checksumType());
+    updateLayout();
     debugModeEnabled = _settingsWidget.isDebugModeEnabled();
     checkSettings();
 
@@ -53,8 +52,14 @@ FramedReader::FramedReader(QIODevice* device, QObject* parent) :
     connect(&_settingsWidget, &FramedReaderSettings::sizeFieldChanged,
             this, &FramedReader::onSizeFieldChanged);
 
+    connect(&_settingsWidget, &FramedReaderSettings::endiannessChanged,
+            [this](Endianness endianness){layout.setEndianness(endianness);});
+
+    connect(&_settingsWidget, &FramedReaderSettings::layoutChanged,
+            [this](){updateLayout(); checkSettings(); reset();});
+
     connect(&_settingsWidget, &FramedReaderSettings::checksumChanged,
-            [this](bool enabled){checksumEnabled = enabled; reset();});
+            this, &FramedReader::setChecksumType);
 
     connect(&_settingsWidget, &FramedReaderSettings::debugModeChanged,
             [this](bool enabled){debugModeEnabled = enabled;});
@@ -75,46 +80,35 @@ unsigned FramedReader::numChannels() const
 
 void FramedReader::onNumberFormatChanged(NumberFormat numberFormat)
 {
-    switch(numberFormat)
+    Q_UNUSED(numberFormat);
+    updateLayout();
+    checkSettings();
+    reset();
+}
+
+void FramedReader::updateLayout()
+{
+    QString desc = _settingsWidget.layoutDescription();
+    if (desc.isEmpty() || !layout.parse(desc))
     {
-        case NumberFormat_uint8:
-            sampleSize = sizeof(quint8);
-            readSample = &FramedReader::readSampleAs<quint8>;
-            break;
-        case NumberFormat_int8:
-            sampleSize = sizeof(qint8);
-            readSample = &FramedReader::readSampleAs<qint8>;
-            break;
-        case NumberFormat_uint16:
-            sampleSize = sizeof(quint16);
-            readSample = &FramedReader::readSampleAs<quint16>;
-            break;
-        case NumberFormat_int16:
-            sampleSize = sizeof(qint16);
-            readSample = &FramedReader::readSampleAs<qint16>;
-            break;
-        case NumberFormat_uint32:
-            sampleSize = sizeof(quint32);
-            readSample = &FramedReader::readSampleAs<quint32>;
-            break;
-        case NumberFormat_int32:
-            sampleSize = sizeof(qint32);
-            readSample = &FramedReader::readSampleAs<qint32>;
-            break;
-        case NumberFormat_float:
-            sampleSize = sizeof(float);
-            readSample = &FramedReader::readSampleAs<float>;
-            break;
-        case NumberFormat_double:
-            sampleSize = sizeof(double);
-            readSample = &FramedReader::readSampleAs<double>;
-            break;
-        case NumberFormat_INVALID:
-            Q_ASSERT(1); // never
-            break;
+        layout = FrameLayout(_settingsWidget.numOfChannels(),
+                             _settingsWidget.numberFormat());
     }
+    layout.setEndianness(_settingsWidget.endianness());
 
-    checkSettings();
+    unsigned nc = layout.numChannels();
+    if (nc != _numChannels)
+    {
+        _numChannels = nc;
+        updateNumChannels();
+        emit numOfChannelsChanged(nc);
+    }
+}
+
+void FramedReader::setChecksumType(ChecksumType type)
+{
+    checksumType = type;
+    checksumBytes = checksumSize(type);
     reset();
 }
 
@@ -131,7 +125,7 @@ void FramedReader::checkSettings()
     }
 
     // check if fixed frame size is multiple of a sample set size
-    if (!hasSizeByte && (frameSize % (_numChannels * sampleSize) != 0))
+    if (!hasSizeByte && (frameSize % layout.size() != 0))
     {
         settingsInvalid |= FRAMESIZE_INVALID;
     }
@@ -148,8 +142,8 @@ void FramedReader::checkSettings()
     else if (settingsInvalid & FRAMESIZE_INVALID)
     {
         QString errorMessage =
-            QString("Frame size must be multiple of %1 (#channels * sample size)!")\
-            .arg(_numChannels * sampleSize);
+            QString("Frame size must be multiple of %1 (sample set size)!")\
+            .arg(layout.size());
 
         _settingsWidget.showMessage(errorMessage, true);
     }
@@ -161,11 +155,10 @@ void FramedReader::checkSettings()
 
 void FramedReader::onNumOfChannelsChanged(unsigned value)
 {
-    _numChannels = value;
+    Q_UNUSED(value);
+    updateLayout();
     checkSettings();
     reset();
-    updateNumChannels();
-    emit numOfChannelsChanged(value);
 }
 
 void FramedReader::onSyncWordChanged(QByteArray word)
@@ -253,11 +246,11 @@ unsigned FramedReader::readData()
                 qCritical() << "Frame size is read as 0!";
                 reset();
             }
-            else if (frameSize % (_numChannels * sampleSize) != 0)
+            else if (frameSize % layout.size() != 0)
             {
                 qCritical() <<
-                    QString("Frame size is not multiple of %1 (#channels * sample size)!") \
-                    .arg(_numChannels * sampleSize);
+                    QString("Frame size is not multiple of %1 (sample set size)!") \
+                    .arg(layout.size());
                 reset();
             }
             else
@@ -268,15 +261,15 @@ unsigned FramedReader::readData()
         }
         else // read data bytes
         {
-            // have enough data bytes? (+1 for checksum)
-            if (bytesAvailable < (checksumEnabled ? frameSize+1 : frameSize))
+            // have enough data bytes? (including checksum)
+            if (bytesAvailable < frameSize + checksumBytes)
             {
                 break;
             }
             else // read data bytes and checksum
             {
                 readFrameDataAndCheck();
-                numBytesRead += checksumEnabled ? frameSize+1 : frameSize;
+                numBytesRead += frameSize + checksumBytes;
                 reset();
             }
         }
@@ -291,75 +284,43 @@ void FramedReader::reset()
     gotSync = false;
     gotSize = false;
     if (hasSizeByte) frameSize = 0;
-    calcChecksum = 0;
 }
 
 // Important: this function assumes device has enough bytes to read a full frames data and checksum
 void FramedReader::readFrameDataAndCheck()
 {
-    // if paused just read and waste data
-    if (paused)
-    {
-        _device->read(checksumEnabled ? frameSize+1 : frameSize);
-        return;
-    }
+    // read the whole frame at once
+    frameBuffer.resize(frameSize + checksumBytes);
+    _device->read(frameBuffer.data(), frameBuffer.size());
 
-    // a package is 1 set of samples for all channels
-    unsigned numOfPackagesToRead = frameSize / (_numChannels * sampleSize);
-    SamplePack samples(numOfPackagesToRead, _numChannels);
-    for (unsigned i = 0; i < numOfPackagesToRead; i++)
-    {
-        for (unsigned int ci = 0; ci < _numChannels; ci++)
-        {
-            samples.data(ci)[i] = (this->*readSample)();
-        }
-    }
+    // if paused just waste data
+    if (paused) return;
 
-    // read checksum
-    unsigned rChecksum = 0;
-    bool checksumPassed = false;
-    if (checksumEnabled)
-    {
-        _device->read((char*) &rChecksum, 1);
-        calcChecksum &= 0xFF;
-        checksumPassed = (calcChecksum == rChecksum);
-    }
+    const uchar* data = (const uchar*) frameBuffer.constData();
 
-    if (!checksumEnabled || checksumPassed)
+    // check the checksum in a single pass over the payload
+    if (checksumType != ChecksumType_None)
     {
-        // commit data
-        feedOut(samples);
-    }
-    else
-    {
-        qCritical() << "Checksum failed! Received:" << rChecksum << "Calculated:" << calcChecksum;
-    }
-}
+        quint32 calculated = calcChecksum(checksumType, data, frameSize);
 
-template<typename T> double FramedReader::readSampleAs()
-{
-    T data;
-
-    _device->read((char*) &data, sizeof(data));
+        quint32 received = readChecksum(checksumType, data + frameSize,
+                                        _settingsWidget.endianness() == LittleEndian);
 
-    if (checksumEnabled)
-    {
-        for (unsigned i = 0; i < sizeof(data); i++)
+        if (calculated != received)
         {
-            calcChecksum += ((unsigned char*) &data)[i];
+            qCritical() << "Checksum failed! Received:" << received << "Calculated:" << calculated;
+            return;
         }
     }
 
-    if (_settingsWidget.endianness() == LittleEndian)
-    {
-        data = qFromLittleEndian(data);
-    }
-    else
-    {
-        data = qFromBigEndian(data);
-    }
+    // a package is 1 set of samples for all channels (or more for
+    // bit packed formats, see `FrameLayout::setsPerPackage()`)
+    unsigned numOfPackagesToRead = frameSize / layout.size();
+    SamplePack samples(numOfPackagesToRead * layout.setsPerPackage(), _numChannels);
+    layout.decode(data, numOfPackagesToRead, &samples);
 
-    return double(data);
+    // commit data
+    feedOut(samples);
 }
 
 void FramedReader::saveSettings(QSettings* settings)
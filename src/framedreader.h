@@ -24,6 +24,7 @@
 
 #include "abstractreader.h"
 #include "framedreadersettings.h"
+#include "framelayout.h"
 
 /**
  * Reads data in a customizable framed format.
@@ -52,10 +53,11 @@ private:
     // settings related members
     FramedReaderSettings _settingsWidget;
     unsigned _numChannels;
-    unsigned sampleSize;
+    FrameLayout layout;         /// layout of a sample set in payload
     unsigned settingsInvalid;   /// settings are all valid if this is 0, if not no reading is done
     QByteArray syncWord;
-    bool checksumEnabled;
+    ChecksumType checksumType;
+    unsigned checksumBytes;     /// size of the checksum field
     bool hasSizeByte;
     bool isSizeField2B;         /// size field is 2 bytes
     unsigned frameSize;
@@ -70,15 +72,17 @@ private:
     unsigned sync_i; /// sync byte index to be read next
     bool gotSync;    /// indicates if sync word is captured
     bool gotSize;    /// indicates if size is captured, ignored if size byte is disabled (fixed size)
-    unsigned calcChecksum;
+    QByteArray frameBuffer;     /// payload and checksum of a frame
 
     void reset();    /// Resets the reading state. Used in case of error or setting change.
-    /// points to the readSampleAs function for currently selected number format
-    double (FramedReader::*readSample)();
-    template<typename T> double readSampleAs();
+    /// Updates `layout` from settings, also updates number of
+    /// channels if changed
+    void updateLayout();
     /// reads payload portion of the frame, calculates checksum and commits data
     /// @note should be called only if there are enough bytes on device
     void readFrameDataAndCheck();
+    /// Sets the checksum algorithm
+    void setChecksumType(ChecksumType type);
 
     unsigned readData() override;
 
@@ -34,10 +34,10 @@ FramedReaderSettings::FramedReaderSettings(QWidget *parent) :
     ui->leSyncWord->setText("AA BB");
     ui->spNumOfChannels->setMaximum(MAX_NUM_CHANNELS);
 
-    connect(ui->cbChecksum, &QCheckBox::toggled,
-            [this](bool enabled)
+    connect(ui->cbChecksum, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            [this](int index)
             {
-                emit checksumChanged(enabled);
+                emit checksumChanged(static_cast<ChecksumType>(index));
             });
 
     connect(ui->cbDebugMode, &QCheckBox::toggled,
@@ -87,6 +87,18 @@ FramedReaderSettings::FramedReaderSettings(QWidget *parent) :
 
     connect(ui->nfBox, SIGNAL(selectionChanged(NumberFormat)),
             this, SIGNAL(numberFormatChanged(NumberFormat)));
+
+    connect(ui->endiBox, SIGNAL(selectionChanged(Endianness)),
+            this, SIGNAL(endiannessChanged(Endianness)));
+
+    // layout overrides number format and number of channels
+    connect(ui->leLayout, &FrameLayoutEdit::descriptionChanged,
+            [this](QString desc)
+            {
+                ui->nfBox->setEnabled(desc.isEmpty());
+                ui->spNumOfChannels->setEnabled(desc.isEmpty());
+                emit layoutChanged(desc);
+            });
 }
 
 FramedReaderSettings::~FramedReaderSettings()
@@ -122,6 +134,11 @@ Endianness FramedReaderSettings::endianness()
     return ui->endiBox->currentSelection();
 }
 
+QString FramedReaderSettings::layoutDescription()
+{
+    return ui->leLayout->description();
+}
+
 QByteArray FramedReaderSettings::syncWord()
 {
     QString text = ui->leSyncWord->text().remove(' ');
@@ -153,9 +170,9 @@ unsigned FramedReaderSettings::fixedFrameSize() const
     return ui->spSize->value();
 }
 
-bool FramedReaderSettings::isChecksumEnabled()
+ChecksumType FramedReaderSettings::checksumType()
 {
-    return ui->cbChecksum->isChecked();
+    return static_cast<ChecksumType>(ui->cbChecksum->currentIndex());
 }
 
 bool FramedReaderSettings::isDebugModeEnabled()
@@ -186,8 +203,9 @@ void FramedReaderSettings::saveSettings(QSettings* settings)
     }
     settings->setValue(SG_CustomFrame_SizeFieldType, sizeFieldStr);
     settings->setValue(SG_CustomFrame_FixedFrameSize, fixedFrameSize());
-    settings->setValue(SG_CustomFrame_Checksum, ui->cbChecksum->isChecked());
+    settings->setValue(SG_CustomFrame_ChecksumType, checksumTypeToStr(checksumType()));
     settings->setValue(SG_CustomFrame_DebugMode, ui->cbDebugMode->isChecked());
+    settings->setValue(SG_CustomFrame_Layout, ui->leLayout->text());
     settings->endGroup();
 }
 
@@ -248,8 +266,23 @@ void FramedReaderSettings::loadSettings(QSettings* settings)
     } // ignore invalid value
 
     // load checksum
-    ui->cbChecksum->setChecked(
-        settings->value(SG_CustomFrame_Checksum, ui->cbChecksum->isChecked()).toBool());
+    ChecksumType csSetting =
+        strToChecksumType(settings->value(SG_CustomFrame_ChecksumType,
+                                          QString()).toString());
+    if (csSetting == ChecksumType_INVALID &&
+        settings->contains(SG_CustomFrame_Checksum)) // older versions
+    {
+        csSetting = settings->value(SG_CustomFrame_Checksum).toBool() ?
+            ChecksumType_Sum8 : ChecksumType_None;
+    }
+    if (csSetting != ChecksumType_INVALID)
+    {
+        ui->cbChecksum->setCurrentIndex(csSetting);
+    }
+
+    // load layout
+    ui->leLayout->setText(
+        settings->value(SG_CustomFrame_Layout, ui->leLayout->text()).toString());
 
     // load debug mode
     ui->cbDebugMode->setChecked(
@@ -27,6 +27,7 @@
 
 #include "numberformatbox.h"
 #include "endiannessbox.h"
+#include "checksum.h"
 
 namespace Ui {
 class FramedReaderSettings;
@@ -50,10 +51,12 @@ public:
     unsigned numOfChannels();
     NumberFormat numberFormat();
     Endianness endianness();
+    /// Returns layout description, empty if not set or invalid
+    QString layoutDescription();
     QByteArray syncWord();
     SizeFieldType sizeFieldType() const;
     unsigned fixedFrameSize() const;
-    bool isChecksumEnabled();
+    ChecksumType checksumType();
     bool isDebugModeEnabled();
     /// Save settings into a `QSettings`
     void saveSettings(QSettings* settings);
@@ -68,9 +71,12 @@ signals:
     void sizeFieldChanged(SizeFieldType type, unsigned size);
     /// `0` indicates frame size byte is enabled
     void fixedFrameSizeChanged(unsigned);
-    void checksumChanged(bool);
+    void checksumChanged(ChecksumType);
     void numOfChannelsChanged(unsigned);
     void numberFormatChanged(NumberFormat);
+    void endiannessChanged(Endianness);
+    /// Signaled with a valid layout description or empty string
+    void layoutChanged(QString);
     void debugModeChanged(bool);
 
 private:
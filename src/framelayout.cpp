@@ -0,0 +1,336 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QtEndian>
+
+#include "byteswap.h"
+#include "defines.h"
+#include "framelayout.h"
+
+namespace
+{
+typedef void (*DecodeFunc)(const uchar* src, unsigned stride, unsigned n, double* dst);
+
+template<typename T, Endianness E>
+void decodeField(const uchar* src, unsigned stride, unsigned n, double* dst)
+{
+    for (unsigned i = 0; i < n; i++)
+    {
+        T value;
+        memcpy(&value, src, sizeof(value));
+        value = (E == LittleEndian) ? qFromLittleEndian(value) : qFromBigEndian(value);
+        dst[i] = double(value);
+        src += stride;
+    }
+}
+
+template<Endianness E>
+DecodeFunc decodeFunc(NumberFormat format)
+{
+    switch(format)
+    {
+        case NumberFormat_uint8:
+            return &decodeField<quint8, E>;
+        case NumberFormat_int8:
+            return &decodeField<qint8, E>;
+        case NumberFormat_uint16:
+            return &decodeField<quint16, E>;
+        case NumberFormat_int16:
+            return &decodeField<qint16, E>;
+        case NumberFormat_uint32:
+            return &decodeField<quint32, E>;
+        case NumberFormat_int32:
+            return &decodeField<qint32, E>;
+        case NumberFormat_float:
+            return &decodeField<float, E>;
+        case NumberFormat_double:
+            return &decodeField<double, E>;
+        default:
+            Q_ASSERT(false); // never
+            return nullptr;
+    }
+}
+
+/// Removes `_t` suffix from type names
+QString stripTypeName(QString name)
+{
+    if (name.endsWith("_t")) name.chop(2);
+    return name;
+}
+
+/// Returns size in bytes of given number of bits, rounded up
+inline unsigned bitsToBytes(unsigned bits)
+{
+    return (bits + 7) / 8;
+}
+}
+
+const unsigned FrameLayout::MAX_SIZE;
+
+FrameLayout::FrameLayout(unsigned numChannels, NumberFormat format, Endianness endianness)
+{
+    unsigned fbits = numberFormatBits(format);
+    for (unsigned ci = 0; ci < numChannels; ci++)
+    {
+        fields.append(formatField(format, ci * fbits));
+    }
+    // whole number of bytes per package, ex: 2 sets of odd number of
+    // 12 bit channels
+    setBits = numChannels * fbits;
+    _sets = 1;
+    while (setBits && (_sets * setBits) % 8) _sets++;
+    _size = bitsToBytes(_sets * setBits);
+    _endianness = endianness;
+    compile();
+}
+
+FrameLayout::Field FrameLayout::formatField(NumberFormat format, unsigned offset)
+{
+    return {format, numberFormatBits(format), numberFormatIsSigned(format), offset};
+}
+
+bool FrameLayout::parse(QString description, QString* error)
+{
+    QString dummy;
+    if (error == nullptr) error = &dummy;
+
+    // remove C struct decorations
+    QString text = description;
+    text.replace(QRegularExpression("\\bstruct\\b\\s*\\w*"), " ");
+    text.replace('{', ' ').replace('}', ' ');
+
+    QRegularExpression declRe("^(\\w+)\\s*(.*)$");
+    QRegularExpression nameRe("^[A-Za-z_]\\w*(?:\\s*\\[\\s*(\\d+)\\s*\\])?$");
+
+    QVector<Field> newFields;
+    quint64 offset = 0;         // in bits, wide enough to not wrap
+    const quint64 maxBits = quint64(MAX_SIZE) * 8;
+    const QString tooLarge = QString("Layout is too large, maximum is %1 bytes").arg(MAX_SIZE);
+    for (auto decl : text.split(QRegularExpression("[;\\n]")))
+    {
+        decl = decl.trimmed();
+        if (decl.isEmpty()) continue;
+
+        auto match = declRe.match(decl);
+        if (!match.hasMatch())
+        {
+            *error = QString("Invalid declaration: '%1'").arg(decl);
+            return false;
+        }
+        QString type = match.captured(1);
+        QString rest = match.captured(2).trimmed();
+
+        // padding bytes
+        if (type == "pad")
+        {
+            bool ok = true;
+            unsigned n = rest.isEmpty() ? 1 : rest.toUInt(&ok);
+            if (!ok || n == 0)
+            {
+                *error = QString("Invalid padding size: '%1'").arg(rest);
+                return false;
+            }
+            if (offset + quint64(n) * 8 > maxBits)
+            {
+                *error = tooLarge;
+                return false;
+            }
+            offset += quint64(n) * 8;
+            continue;
+        }
+
+        Field field;
+        QString typeName = stripTypeName(type);
+        NumberFormat format = strToNumberFormat(typeName);
+        if (format != NumberFormat_INVALID)
+        {
+            field = formatField(format, 0);
+        }
+        else if (strToBitFormat(typeName, &field.bits, &field.isSigned))
+        {
+            field.format = NumberFormat_INVALID;
+        }
+        else
+        {
+            *error = QString("Unknown type: '%1'").arg(type);
+            return false;
+        }
+
+        if ((format == NumberFormat_float || format == NumberFormat_double) && offset % 8)
+        {
+            *error = QString("'%1' must be byte aligned").arg(type);
+            return false;
+        }
+
+        // count channels, names are optional
+        unsigned count = 0;
+        if (rest.isEmpty())
+        {
+            count = 1;
+        }
+        else
+        {
+            for (auto name : rest.split(','))
+            {
+                auto nameMatch = nameRe.match(name.trimmed());
+                unsigned n = nameMatch.captured(1).isEmpty() ? 1 : nameMatch.captured(1).toUInt();
+                if (!nameMatch.hasMatch() || n == 0)
+                {
+                    *error = QString("Invalid field name: '%1'").arg(name.trimmed());
+                    return false;
+                }
+                // checked before adding so that huge counts can't
+                // overflow or allocate before being rejected
+                if (n > MAX_NUM_CHANNELS - (unsigned) newFields.size() - count)
+                {
+                    *error = QString("Too many channels, maximum is %1").arg(MAX_NUM_CHANNELS);
+                    return false;
+                }
+                count += n;
+            }
+        }
+
+        if (offset + quint64(count) * field.bits > maxBits)
+        {
+            *error = tooLarge;
+            return false;
+        }
+
+        for (unsigned i = 0; i < count; i++)
+        {
+            field.offset = (unsigned) offset;
+            newFields.append(field);
+            offset += field.bits;
+        }
+    }
+
+    if (newFields.isEmpty())
+    {
+        *error = "No fields";
+        return false;
+    }
+
+    if (offset == 0)
+    {
+        *error = "Layout size is zero";
+        return false;
+    }
+
+    fields = newFields;
+    _size = bitsToBytes((unsigned) offset);
+    _sets = 1;
+    setBits = (unsigned) offset;
+    compile();
+    return true;
+}
+
+unsigned FrameLayout::size() const
+{
+    return _size;
+}
+
+unsigned FrameLayout::setsPerPackage() const
+{
+    return _sets;
+}
+
+unsigned FrameLayout::numChannels() const
+{
+    return fields.size();
+}
+
+unsigned FrameLayout::fieldSize(unsigned channel) const
+{
+    Q_ASSERT(channel < numChannels());
+    return bitsToBytes(fields[channel].bits);
+}
+
+Endianness FrameLayout::endianness() const
+{
+    return _endianness;
+}
+
+void FrameLayout::setEndianness(Endianness endianness)
+{
+    if (endianness == _endianness) return;
+    _endianness = endianness;
+    compile();
+}
+
+void FrameLayout::compile()
+{
+    plan.clear();
+    for (unsigned set = 0; set < _sets; set++)
+    {
+        for (int ci = 0; ci < fields.size(); ci++)
+        {
+            const Field& field = fields[ci];
+            unsigned offset = set * setBits + field.offset;
+            Step step = {nullptr, offset / 8, (unsigned) ci, set,
+                         offset % 8, field.bits, field.isSigned};
+
+            // whole byte formats are read directly
+            if (field.format != NumberFormat_INVALID &&
+                !numberFormatIsPacked(field.format) && step.shift == 0)
+            {
+                step.func = _endianness == LittleEndian ?
+                    decodeFunc<LittleEndian>(field.format) :
+                    decodeFunc<BigEndian>(field.format);
+            }
+            plan.append(step);
+        }
+    }
+}
+
+void FrameLayout::decode(const uchar* data, unsigned n, SamplePack* samples, unsigned offset) const
+{
+    Q_ASSERT(samples->numChannels() == numChannels());
+    Q_ASSERT(offset + n * _sets <= samples->numSamples());
+
+    // sets of a package are decoded separately then interleaved
+    QVector<double> setSamples(_sets > 1 ? n : 0);
+
+    for (auto& step : plan)
+    {
+        double* dst = samples->data(step.channel) + offset;
+        if (_sets > 1) dst = setSamples.data();
+
+        if (step.func)
+        {
+            step.func(data + step.offset, _size, n, dst);
+        }
+        else
+        {
+            unpackBits(data + step.offset, _size, n, step.shift, step.bits,
+                       step.isSigned, _endianness == BigEndian, dst);
+        }
+
+        if (_sets > 1)
+        {
+            double* out = samples->data(step.channel) + offset + step.set;
+            for (unsigned i = 0; i < n; i++)
+            {
+                out[i * _sets] = setSamples[i];
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMELAYOUT_H
+#define FRAMELAYOUT_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "numberformat.h"
+#include "endiannessbox.h"
+#include "samplepack.h"
+
+/**
+ * Describes the binary layout of a single set of samples (one sample
+ * for each channel) and decodes them.
+ *
+ * Fields can be of different number formats. A layout is either
+ * uniform, every channel with the same format, or parsed from a
+ * packed C struct like description such as:
+ *
+ *     uint32 ts; int16 ax, ay, az; pad 2; float temp
+ *
+ * Each named field is a channel, `name[N]` is `N` channels and
+ * `pad N` skips `N` bytes. There is no implicit alignment. `_t`
+ * suffixed type names and `struct {...}` wrapping are accepted. Size
+ * of a parsed layout is limited to `MAX_SIZE` bytes.
+ *
+ * Integers can be of any width from 1 to 32 bits (ex: `uint12`,
+ * `int5`), such fields are packed without gaps. Size of a parsed
+ * layout is rounded up to whole bytes. Floating point fields must be
+ * byte aligned.
+ *
+ * Data is read in packages. A package is a single sample set, except
+ * for uniform bit packed layouts whose sample set isn't whole bytes
+ * (ex: odd number of `uint12` channels); those are read in packages
+ * of multiple sample sets packed without gaps, see `setsPerPackage()`.
+ *
+ * Layout is compiled into a decode plan where each step converts one
+ * field for a whole batch of sample sets, with offsets and byte
+ * swapping decided at configuration time.
+ */
+class FrameLayout
+{
+public:
+    /// Maximum size of a parsed layout in bytes
+    static const unsigned MAX_SIZE = 1 << 16;
+
+    /// Creates a uniform layout, samples are packed without gaps
+    explicit FrameLayout(unsigned numChannels = 1, NumberFormat format = NumberFormat_uint8,
+                         Endianness endianness = LittleEndian);
+
+    /**
+     * Parses a layout description. Layout isn't changed if
+     * description is invalid.
+     *
+     * @param error set to a reason if description is invalid
+     * @return false if description is invalid
+     */
+    bool parse(QString description, QString* error = nullptr);
+
+    /// Size of a package in bytes, including padding
+    unsigned size() const;
+    /// Number of sample sets in a package, 1 unless sets aren't whole bytes
+    unsigned setsPerPackage() const;
+    unsigned numChannels() const;
+    /// Size of a channels field in bytes, rounded up for bit fields
+    unsigned fieldSize(unsigned channel) const;
+
+    Endianness endianness() const;
+    void setEndianness(Endianness endianness);
+
+    /**
+     * Decodes `n` packages (`n * setsPerPackage()` sample sets) into
+     * `samples`.
+     *
+     * @param data at least `n * size()` bytes
+     * @param offset index of the first sample set in `samples`
+     */
+    void decode(const uchar* data, unsigned n, SamplePack* samples, unsigned offset = 0) const;
+
+private:
+    /// Converts a field of `n` sample sets spaced `stride` bytes apart
+    typedef void (*DecodeFunc)(const uchar* src, unsigned stride, unsigned n, double* dst);
+
+    struct Field
+    {
+        NumberFormat format;    ///< `NumberFormat_INVALID` for arbitrary width integers
+        unsigned bits;
+        bool isSigned;
+        unsigned offset;        ///< in bits from the start of sample set
+    };
+
+    /// Field decoding step, bit fields are unpacked if `func` is null
+    struct Step
+    {
+        DecodeFunc func;
+        unsigned offset;        ///< in bytes
+        unsigned channel;
+        unsigned set;           ///< sample set in the package
+        unsigned shift;         ///< bits into the first byte
+        unsigned bits;
+        bool isSigned;
+    };
+
+    QVector<Field> fields;      ///< one per channel
+    QVector<Step> plan;
+    unsigned _size;             ///< in bytes
+    unsigned _sets;             ///< sample sets per package
+    unsigned setBits;           ///< size of a sample set in bits
+    Endianness _endianness;
+
+    /// Creates a field of a named format
+    static Field formatField(NumberFormat format, unsigned offset);
+    /// Rebuilds the decode plan
+    void compile();
+};
+
+#endif // FRAMELAYOUT_H
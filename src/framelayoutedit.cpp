@@ -0,0 +1,76 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "framelayout.h"
+#include "framelayoutedit.h"
+
+FrameLayoutEdit::FrameLayoutEdit(QWidget *parent) :
+    QLineEdit(parent)
+{
+    valid = true;
+    setPlaceholderText("e.g. uint32 ts; int16 ax, ay, az; pad 2; float temp");
+    defaultToolTip =
+        "Optional layout of a sample set with mixed number types, "
+        "overrides number type and number of channels. "
+        "Types: uint8, int8, uint16, int16, uint32, int32, float, double. "
+        "Use 'pad N' to skip N bytes.";
+    setToolTip(defaultToolTip);
+
+    connect(this, &QLineEdit::textChanged, this, &FrameLayoutEdit::onTextChanged);
+}
+
+bool FrameLayoutEdit::isValid() const
+{
+    return valid;
+}
+
+QString FrameLayoutEdit::description() const
+{
+    return valid ? text().trimmed() : QString();
+}
+
+void FrameLayoutEdit::onTextChanged(QString text)
+{
+    QString desc = text.trimmed();
+    QString error;
+    FrameLayout layout;
+
+    if (desc.isEmpty())
+    {
+        valid = true;
+        setToolTip(defaultToolTip);
+    }
+    else if (layout.parse(desc, &error))
+    {
+        valid = true;
+        setToolTip(QString("%1 channels, %2 bytes").arg(layout.numChannels()).arg(layout.size()));
+    }
+    else
+    {
+        valid = false;
+        setToolTip(error);
+    }
+
+    setStyleSheet(valid ? "" : "color: red;");
+    if (valid && desc != lastDescription)
+    {
+        lastDescription = desc;
+        emit descriptionChanged(desc);
+    }
+}
@@ -0,0 +1,57 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FRAMELAYOUTEDIT_H
+#define FRAMELAYOUTEDIT_H
+
+#include <QLineEdit>
+#include <QString>
+
+/**
+ * Line edit for entering a `FrameLayout` description. Invalid
+ * descriptions are marked and the error is shown as tooltip. Empty
+ * description means a uniform layout is used.
+ */
+class FrameLayoutEdit : public QLineEdit
+{
+    Q_OBJECT
+
+public:
+    explicit FrameLayoutEdit(QWidget *parent = 0);
+
+    /// Returns true if description is empty or valid
+    bool isValid() const;
+    /// Returns the description if valid, empty otherwise
+    QString description() const;
+
+signals:
+    /// Signaled with a valid description or an empty string when
+    /// cleared. Not signaled for invalid input.
+    void descriptionChanged(QString description);
+
+private:
+    bool valid;
+    QString lastDescription;    ///< last signaled description
+    QString defaultToolTip;
+
+private slots:
+    void onTextChanged(QString text);
+};
+
+#endif // FRAMELAYOUTEDIT_H
@@ -0,0 +1,438 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QtDebug>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+
+#include "headless.h"
+#include "binarystreamreader.h"
+#include "asciireader.h"
+#include "framedreader.h"
+#include "packetreader.h"
+#include "channelinfomodel.h"
+#include "portlist.h"
+#include "setting_defines.h"
+#include "defines.h"
+
+#define DEFAULT_STATS_INTERVAL (1000) // ms
+#define SIGNAL_CHECK_INTERVAL  (100)  // ms
+
+static volatile std::sig_atomic_t quitRequested = 0;
+
+static void quitSignalHandler(int)
+{
+    quitRequested = 1;
+}
+
+HeadlessCapture::HeadlessCapture(QObject* parent) :
+    QObject(parent)
+{
+    reader = nullptr;
+    totalBytes = 0;
+    totalSamples = 0;
+    intervalSamples = 0;
+    portErrors = 0;
+    lastStatsTime = 0;
+
+    connect(&statsTimer, &QTimer::timeout, this, &HeadlessCapture::printStats);
+    connect(&signalTimer, &QTimer::timeout, this, &HeadlessCapture::checkSignal);
+    connect(&serialPort, SIGNAL(error(QSerialPort::SerialPortError)),
+            this, SLOT(onPortError(QSerialPort::SerialPortError)));
+    // queued: device shouldn't be closed while it's signaling
+    connect(&pipeDevice, &QIODevice::readChannelFinished,
+            this, &HeadlessCapture::onInputEnd, Qt::QueuedConnection);
+}
+
+HeadlessCapture::~HeadlessCapture()
+{
+    stop();
+}
+
+bool HeadlessCapture::requested(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0) return true;
+    }
+    return false;
+}
+
+bool HeadlessCapture::start(const QCoreApplication& app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Record data from serial port without the graphical interface.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption headlessOpt("headless", "Run without the graphical interface.");
+    QCommandLineOption configOpt({"c", "config"}, "Load configuration from file.", "filename");
+    QCommandLineOption portOpt({"p", "port"}, "Set port name.", "port name");
+    QCommandLineOption baudrateOpt({"b" ,"baudrate"}, "Set port baud rate.", "baud rate");
+    QCommandLineOption formatOpt({"f", "format"}, "Data format: binary, ascii, custom or packet.", "format");
+    QCommandLineOption outputOpt({"o", "output"}, "Recording file.", "filename");
+    QCommandLineOption intervalOpt({"s", "stats-interval"},
+                                   "Statistics print interval in milliseconds, 0 to disable.",
+                                   "ms", QString::number(DEFAULT_STATS_INTERVAL));
+
+    parser.addOption(headlessOpt);
+    parser.addOption(configOpt);
+    parser.addOption(portOpt);
+    parser.addOption(baudrateOpt);
+    parser.addOption(formatOpt);
+    parser.addOption(outputOpt);
+    parser.addOption(intervalOpt);
+
+    parser.process(app);
+
+    if (!parser.isSet(outputOpt))
+    {
+        qCritical() << "Headless mode requires an output file (--output).";
+        return false;
+    }
+
+    bool ok;
+    int interval = parser.value(intervalOpt).toInt(&ok);
+    if (!ok || interval < 0)
+    {
+        qCritical() << "Invalid statistics interval:" << parser.value(intervalOpt);
+        return false;
+    }
+
+    QSettings* settings;
+    if (parser.isSet(configOpt))
+    {
+        QString fileName = parser.value(configOpt);
+        QFileInfo fileInfo(fileName);
+        if (!fileInfo.exists() || !fileInfo.isFile())
+        {
+            qCritical() << "Configuration file not found:" << fileName;
+            return false;
+        }
+        settings = new QSettings(fileName, QSettings::IniFormat);
+    }
+    else
+    {
+        settings = new QSettings(PROGRAM_NAME, PROGRAM_NAME);
+    }
+
+    // format from command line overrides the settings
+    settings->beginGroup(SettingGroup_DataFormat);
+    QString format = settings->value(SG_DataFormat_Format, "binary").toString();
+    settings->endGroup();
+    if (parser.isSet(formatOpt)) format = parser.value(formatOpt);
+
+    bool started = createReader(format, settings) &&
+        setupPort(settings, parser.value(portOpt), parser.value(baudrateOpt)) &&
+        startRecorder(settings, parser.value(outputOpt));
+    delete settings;
+
+    if (!started)
+    {
+        device()->close();
+        return false;
+    }
+
+    reader->connectSink(this);
+    reader->enable(true);
+
+    elapsed.start();
+    if (interval > 0) statsTimer.start(interval);
+
+    std::signal(SIGINT, quitSignalHandler);
+    std::signal(SIGTERM, quitSignalHandler);
+    signalTimer.start(SIGNAL_CHECK_INTERVAL);
+
+    qDebug() << "Recording" << (pipeDevice.isOpen() ? pipeDevice.path() : serialPort.portName())
+             << "to" << parser.value(outputOpt);
+    return true;
+}
+
+bool HeadlessCapture::createReader(QString format, QSettings* settings)
+{
+    // Only the selected reader is constructed. Readers keep their
+    // settings in their (never shown) settings widgets.
+    if (format == "binary")
+    {
+        auto r = new BinaryStreamReader(&serialPort, this);
+        r->loadSettings(settings);
+        reader = r;
+    }
+    else if (format == "ascii")
+    {
+        auto r = new AsciiReader(&serialPort, this);
+        r->loadSettings(settings);
+        reader = r;
+    }
+    else if (format == "custom")
+    {
+        auto r = new FramedReader(&serialPort, this);
+        r->loadSettings(settings);
+        reader = r;
+    }
+    else if (format == "packet")
+    {
+        auto r = new PacketReader(&serialPort, this);
+        r->loadSettings(settings);
+        reader = r;
+    }
+    else
+    {
+        qCritical() << "Invalid data format:" << format;
+        return false;
+    }
+
+    return true;
+}
+
+bool HeadlessCapture::setupPort(QSettings* settings, QString portName, QString baudRate)
+{
+    settings->beginGroup(SettingGroup_Port);
+
+    if (portName.isEmpty())
+    {
+        portName = settings->value(SG_Port_SelectedPort, QString()).toString();
+    }
+    if (baudRate.isEmpty())
+    {
+        baudRate = settings->value(SG_Port_BaudRate, "9600").toString();
+    }
+
+    QString parity = settings->value(SG_Port_Parity, "none").toString();
+    int dataBits = settings->value(SG_Port_DataBits, QSerialPort::Data8).toInt();
+    int stopBits = settings->value(SG_Port_StopBits, QSerialPort::OneStop).toInt();
+    QString flowControl = settings->value(SG_Port_FlowControl, "none").toString();
+
+    settings->endGroup();
+
+    if (portName.isEmpty())
+    {
+        qCritical() << "No port selected, use --port.";
+        return false;
+    }
+
+    if (portName.startsWith(PIPE_PORT_PREFIX))
+    {
+        QString path = portName.mid(strlen(PIPE_PORT_PREFIX));
+        if (!pipeDevice.openPath(path))
+        {
+            qCritical() << "Can't open input" << path << ":" << pipeDevice.errorString();
+            return false;
+        }
+        reader->setDevice(&pipeDevice);
+        return true;
+    }
+
+    bool ok;
+    qint32 baud = baudRate.toUInt(&ok);
+    if (!ok || baud <= 0)
+    {
+        qCritical() << "Invalid baud rate:" << baudRate;
+        return false;
+    }
+
+    serialPort.setPortName(portName);
+    if (!serialPort.open(QIODevice::ReadWrite))
+    {
+        qCritical() << "Can't open port" << portName << ":" << serialPort.errorString();
+        return false;
+    }
+
+    // settings must be applied after opening the port
+    serialPort.setBaudRate(baud);
+
+    if (parity == "odd")
+    {
+        serialPort.setParity(QSerialPort::OddParity);
+    }
+    else if (parity == "even")
+    {
+        serialPort.setParity(QSerialPort::EvenParity);
+    }
+    else
+    {
+        serialPort.setParity(QSerialPort::NoParity);
+    }
+
+    if (dataBits >= 5 && dataBits <= 8)
+    {
+        serialPort.setDataBits((QSerialPort::DataBits) dataBits);
+    }
+
+    serialPort.setStopBits(stopBits == QSerialPort::TwoStop ?
+                           QSerialPort::TwoStop : QSerialPort::OneStop);
+
+    if (flowControl == "hardware")
+    {
+        serialPort.setFlowControl(QSerialPort::HardwareControl);
+    }
+    else if (flowControl == "software")
+    {
+        serialPort.setFlowControl(QSerialPort::SoftwareControl);
+    }
+    else
+    {
+        serialPort.setFlowControl(QSerialPort::NoFlowControl);
+    }
+
+    return true;
+}
+
+bool HeadlessCapture::startRecorder(QSettings* settings, QString fileName)
+{
+    settings->beginGroup(SettingGroup_Record);
+
+    bool header = settings->value(SG_Record_Header, true).toBool();
+    QString separator = settings->value(SG_Record_Separator, ",").toString();
+    separator.replace("\\t", "\t");
+    recorder.disableBuffering = settings->value(SG_Record_DisableBuffering, false).toBool();
+    recorder.writeSummary = settings->value(SG_Record_Summary, false).toBool();
+    recorder.setDecimals(settings->value(SG_Record_Decimals, 6).toUInt());
+
+    auto tsOpt = DataRecorder::TimestampOption::disabled;
+    if (settings->value(SG_Record_Timestamp, false).toBool())
+    {
+        QString tsFormatStr = settings->value(SG_Record_TimestampFormat, "").toString();
+        if (tsFormatStr == "seconds_with_precision")
+        {
+            tsOpt = DataRecorder::TimestampOption::seconds_precision;
+        }
+        else if (tsFormatStr == "milliseconds")
+        {
+            tsOpt = DataRecorder::TimestampOption::milliseconds;
+        }
+        else
+        {
+            tsOpt = DataRecorder::TimestampOption::seconds;
+        }
+    }
+
+    settings->endGroup();
+
+    // channel names are only known if number of channels is fixed
+    QStringList channelNames;
+    unsigned nc = reader->numChannels();
+    if (header && nc > 0)
+    {
+        ChannelInfoModel infoModel(nc);
+        infoModel.loadSettings(settings);
+        infoModel.setNumOfChannels(nc);
+        channelNames = infoModel.channelNames();
+    }
+
+    if (!recorder.startRecording(fileName, separator, channelNames, tsOpt))
+    {
+        qCritical() << "Can't open recording file:" << fileName;
+        return false;
+    }
+
+    connectFollower(&recorder);
+    return true;
+}
+
+QIODevice* HeadlessCapture::device()
+{
+    if (pipeDevice.isOpen())
+    {
+        return &pipeDevice;
+    }
+    else
+    {
+        return &serialPort;
+    }
+}
+
+void HeadlessCapture::feedIn(const SamplePack& data)
+{
+    intervalSamples += data.numSamples();
+    Sink::feedIn(data);
+}
+
+void HeadlessCapture::printStats()
+{
+    qint64 now = elapsed.elapsed();
+    double dt = (now - lastStatsTime) / 1000.;
+    lastStatsTime = now;
+    if (dt <= 0) return;
+
+    unsigned bytes = reader->getBytesRead();
+    totalBytes += bytes;
+    totalSamples += intervalSamples;
+
+    std::cerr << QString("%1 s: %2 B/s, %3 samples/s, total %4 B / %5 samples, "
+                         "port errors %6, backlog %7 B")
+        .arg(now / 1000., 0, 'f', 1)
+        .arg(bytes / dt, 0, 'f', 0)
+        .arg(intervalSamples / dt, 0, 'f', 0)
+        .arg(totalBytes)
+        .arg(totalSamples)
+        .arg(portErrors)
+        .arg(device()->bytesAvailable())
+        .toStdString() << std::endl;
+
+    intervalSamples = 0;
+}
+
+void HeadlessCapture::checkSignal()
+{
+    if (quitRequested)
+    {
+        stop();
+        QCoreApplication::quit();
+    }
+}
+
+void HeadlessCapture::stop()
+{
+    if (reader == nullptr || !device()->isOpen()) return;
+
+    statsTimer.stop();
+    signalTimer.stop();
+    reader->enable(false);
+    device()->close();
+
+    disconnectFollower(&recorder);
+    recorder.stopRecording();
+    printStats();
+}
+
+void HeadlessCapture::onPortError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::NoError) return;
+
+    portErrors++;
+    qWarning() << "Port error:" << serialPort.errorString();
+
+    // port is gone, finish the recording
+    if (error == QSerialPort::ResourceError)
+    {
+        stop();
+        QCoreApplication::exit(1);
+    }
+}
+
+void HeadlessCapture::onInputEnd()
+{
+    qDebug() << "End of input.";
+    stop();
+    QCoreApplication::quit();
+}
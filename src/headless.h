@@ -0,0 +1,102 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <QObject>
+#include <QSerialPort>
+#include <QSettings>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+#include "sink.h"
+#include "abstractreader.h"
+#include "datarecorder.h"
+#include "pipedevice.h"
+
+/**
+ * Runs a capture without the main window: opens the serial port (or
+ * a pipe input, see `PIPE_PORT_PREFIX`), runs the selected reader and records its output with a
+ * `DataRecorder`. Throughput and error statistics are periodically
+ * printed to `stderr`.
+ *
+ * Port, data format and recording settings are read from the
+ * settings file (the default one or the one given with `--config`)
+ * and can be overridden from the command line.
+ */
+class HeadlessCapture : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    explicit HeadlessCapture(QObject* parent = 0);
+    ~HeadlessCapture();
+
+    /// Returns true if `--headless` is present in arguments. Used
+    /// before constructing the application object.
+    static bool requested(int argc, char* argv[]);
+
+    /**
+     * Parses command line options, opens the port and starts
+     * recording.
+     *
+     * @return false if capture couldn't be started, an error message
+     * is printed in that case
+     */
+    bool start(const QCoreApplication& app);
+
+protected:
+    void feedIn(const SamplePack& data) override;
+
+private:
+    QSerialPort serialPort;
+    PipeDevice pipeDevice;
+    AbstractReader* reader;
+    DataRecorder recorder;
+    QTimer statsTimer;
+    QTimer signalTimer;
+    QElapsedTimer elapsed;
+
+    quint64 totalBytes;
+    quint64 totalSamples;
+    quint64 intervalSamples;
+    unsigned portErrors;
+    qint64 lastStatsTime;
+
+    /// Creates the reader for given format name and loads its settings
+    bool createReader(QString format, QSettings* settings);
+    /// Opens the port and applies its settings, `portName` and
+    /// `baudRate` override settings if not empty
+    bool setupPort(QSettings* settings, QString portName, QString baudRate);
+    /// Starts the recorder with settings from "Record" group
+    bool startRecorder(QSettings* settings, QString fileName);
+    /// Returns the device that is read from
+    QIODevice* device();
+
+private slots:
+    void printStats();
+    void checkSignal();
+    void stop();
+    void onPortError(QSerialPort::SerialPortError error);
+    void onInputEnd();
+};
+
+#endif // HEADLESS_H
@@ -0,0 +1,158 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtDebug>
+
+#include "inputport.h"
+
+PortWorker::PortWorker(QSerialPort* port, DataFormatPanel* formatPanel, QThread* homeThread)
+{
+    this->port = port;
+    this->formatPanel = formatPanel;
+    this->homeThread = homeThread;
+
+    connect(port, SIGNAL(error(QSerialPort::SerialPortError)),
+            this, SLOT(onPortError(QSerialPort::SerialPortError)));
+}
+
+QString PortWorker::open(QString portName, qint32 baudRate)
+{
+    port->setPortName(portName);
+    if (port->open(QIODevice::ReadOnly) && port->setBaudRate(baudRate))
+    {
+        return QString();
+    }
+
+    QString error = port->errorString();
+    close();
+    return error;
+}
+
+void PortWorker::close()
+{
+    // already closed because of an error
+    if (port->thread() != QThread::currentThread()) return;
+
+    if (port->isOpen()) port->close();
+    port->moveToThread(homeThread);
+    formatPanel->moveReaderToThread(homeThread);
+}
+
+void PortWorker::onPortError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::ResourceError && port->isOpen())
+    {
+        qWarning() << "Closing port on resource error:" << port->portName();
+        close();
+        emit closedOnError();
+    }
+}
+
+InputPort::InputPort(QObject* parent) :
+    QObject(parent),
+    _formatPanel(&port)
+{
+    _isOpen = false;
+
+    worker = new PortWorker(&port, &_formatPanel, QThread::currentThread());
+    worker->moveToThread(&thread);
+    connect(worker, &PortWorker::closedOnError, this, &InputPort::onPortClosed);
+    thread.start();
+
+    connect(&_formatPanel, &DataFormatPanel::sourceChanged,
+            this, &InputPort::onSourceChanged);
+    onSourceChanged(_formatPanel.activeSource());
+}
+
+InputPort::~InputPort()
+{
+    close();
+    thread.quit();
+    thread.wait();
+    delete worker;
+}
+
+DataFormatPanel* InputPort::formatPanel()
+{
+    return &_formatPanel;
+}
+
+Source* InputPort::source()
+{
+    return &relay;
+}
+
+bool InputPort::isOpen() const
+{
+    return _isOpen;
+}
+
+quint64 InputPort::droppedPacks() const
+{
+    return relay.droppedPacks();
+}
+
+QString InputPort::open(QString portName, qint32 baudRate)
+{
+    if (_isOpen) return QString();
+
+    // reader is moved with the port, so that parsing runs in I/O thread
+    port.moveToThread(&thread);
+    _formatPanel.moveReaderToThread(&thread);
+
+    QString error;
+    QMetaObject::invokeMethod(worker, "open", Qt::BlockingQueuedConnection,
+                              Q_RETURN_ARG(QString, error),
+                              Q_ARG(QString, portName),
+                              Q_ARG(qint32, baudRate));
+    if (!error.isEmpty()) return error;
+
+    // reader selection and settings can't change while reader is in I/O thread
+    _formatPanel.setEnabled(false);
+    _isOpen = true;
+    emit portToggled(true);
+    return QString();
+}
+
+void InputPort::close()
+{
+    if (!_isOpen) return;
+
+    QMetaObject::invokeMethod(worker, "close", Qt::BlockingQueuedConnection);
+    onPortClosed();
+}
+
+void InputPort::onPortClosed()
+{
+    if (!_isOpen) return;
+
+    _formatPanel.setEnabled(true);
+    _isOpen = false;
+    if (relay.droppedPacks())
+    {
+        qWarning() << "Dropped" << relay.droppedPacks()
+                   << "data packs of port" << port.portName();
+    }
+    emit portToggled(false);
+}
+
+void InputPort::onSourceChanged(Source* source)
+{
+    source->connectSink(&relay);
+}
@@ -0,0 +1,109 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef INPUTPORT_H
+#define INPUTPORT_H
+
+#include <QObject>
+#include <QThread>
+#include <QSerialPort>
+
+#include "dataformatpanel.h"
+#include "threadrelay.h"
+
+/**
+ * Opens and closes the port of an `InputPort` in its I/O thread.
+ *
+ * @note Lives in the I/O thread.
+ */
+class PortWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    PortWorker(QSerialPort* port, DataFormatPanel* formatPanel, QThread* homeThread);
+
+    /// Opens the port, returns error string if fails
+    Q_INVOKABLE QString open(QString portName, qint32 baudRate);
+    /// Closes the port and moves port and reader back to home thread
+    Q_INVOKABLE void close();
+
+signals:
+    /// Port is closed due to an error
+    void closedOnError();
+
+private:
+    QSerialPort* port;
+    DataFormatPanel* formatPanel;
+    QThread* homeThread;
+
+private slots:
+    void onPortError(QSerialPort::SerialPortError error);
+};
+
+/**
+ * An additional input (port and reader pair) running in its own thread.
+ *
+ * While the port is closed reader and port are in the main (GUI)
+ * thread and data format can be changed as usual. When the port is
+ * opened they are moved to the I/O thread, so that reading and
+ * parsing runs in parallel to the GUI and other inputs. Data is
+ * passed back to the main thread through `source()`.
+ */
+class InputPort : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InputPort(QObject* parent = 0);
+    ~InputPort();
+
+    /// Data format selection of this input
+    DataFormatPanel* formatPanel();
+    /// Data read from this port, in the main thread
+    Source* source();
+
+    bool isOpen() const;
+    /// Number of data packs dropped because main thread couldn't keep up
+    quint64 droppedPacks() const;
+    /**
+     * Opens the port and starts reading.
+     *
+     * @return error string if port couldn't be opened
+     */
+    QString open(QString portName, qint32 baudRate);
+    void close();
+
+signals:
+    void portToggled(bool open);
+
+private:
+    QThread thread;
+    QSerialPort port;
+    DataFormatPanel _formatPanel;
+    ThreadRelay relay;
+    PortWorker* worker;
+    bool _isOpen;
+
+private slots:
+    void onSourceChanged(Source* source);
+    void onPortClosed();
+};
+
+#endif // INPUTPORT_H
@@ -0,0 +1,249 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QHash>
+
+#include "keyvalueparser.h"
+
+/// Initial size of the hash table
+const int MIN_TABLE_SIZE = 16;
+
+namespace
+{
+bool isKeyChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == '_' || c == '.' || c == '-';
+}
+
+bool isSeparator(QChar c)
+{
+    return c.isSpace() || c == ',' || c == ';' || c == '{' || c == '}';
+}
+
+/// Skips spaces, returns new position
+int skipSpaces(const QString& line, int i)
+{
+    while (i < line.size() && line[i].isSpace()) i++;
+    return i;
+}
+}
+
+KeyValueParser::KeyValueParser(unsigned maxChannels)
+{
+    _maxChannels = maxChannels;
+    isHex = false;
+    setKeys(QStringList());
+}
+
+void KeyValueParser::setKeys(const QStringList& keys)
+{
+    _keys.clear();
+    hashes.clear();
+    rehash(MIN_TABLE_SIZE);
+
+    for (auto& key : keys)
+    {
+        QString k = key.trimmed();
+        if (!k.isEmpty()) channelOf(QStringRef(&k));
+    }
+}
+
+QStringList KeyValueParser::keys() const
+{
+    return _keys;
+}
+
+unsigned KeyValueParser::numChannels() const
+{
+    return _keys.size();
+}
+
+void KeyValueParser::setHex(bool enabled)
+{
+    isHex = enabled;
+}
+
+const KeyValueParser::Value& KeyValueParser::value(int i) const
+{
+    return values[i];
+}
+
+int KeyValueParser::find(const QStringRef& key, uint hash) const
+{
+    int mask = table.size() - 1;
+    int slot = hash & mask;
+    while (table[slot] >= 0)
+    {
+        int index = table[slot];
+        if (hashes[index] == hash && _keys[index] == key) return index;
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+int KeyValueParser::lookup(const QStringRef& key)
+{
+    int index = find(key, qHash(key));
+    if (index >= 0) return index;
+
+    // new keys of a line are few, linear search is fine
+    for (int i = 0; i < newKeys.size(); i++)
+    {
+        if (newKeys[i] == key) return _keys.size() + i;
+    }
+
+    if ((unsigned) (_keys.size() + newKeys.size()) >= _maxChannels) return -1;
+    newKeys.append(key);
+    return _keys.size() + newKeys.size() - 1;
+}
+
+int KeyValueParser::channelOf(const QStringRef& key)
+{
+    uint hash = qHash(key);
+    int index = find(key, hash);
+    if (index >= 0) return index;
+
+    // new key
+    if ((unsigned) _keys.size() >= _maxChannels) return -1;
+
+    index = _keys.size();
+    _keys.append(key.toString());
+    hashes.append(hash);
+    int mask = table.size() - 1;
+    int slot = hash & mask;
+    while (table[slot] >= 0) slot = (slot + 1) & mask;
+    table[slot] = index;
+
+    // keep load factor under 1/2
+    if (_keys.size() * 2 > table.size()) rehash(table.size() * 2);
+
+    return index;
+}
+
+void KeyValueParser::rehash(int size)
+{
+    table.fill(-1, size);
+    int mask = size - 1;
+    for (int index = 0; index < hashes.size(); index++)
+    {
+        int slot = hashes[index] & mask;
+        while (table[slot] >= 0) slot = (slot + 1) & mask;
+        table[slot] = index;
+    }
+}
+
+bool KeyValueParser::parseNumber(const QStringRef& token, double* value) const
+{
+    bool ok;
+    if (isHex)
+    {
+        *value = token.toInt(&ok, 16);
+    }
+    else
+    {
+        *value = token.toDouble(&ok);
+        if (!ok)
+        {
+            *value = token.toInt(&ok, 0);
+        }
+    }
+    return ok;
+}
+
+int KeyValueParser::parse(const QString& line)
+{
+    int numValues = 0;
+    int i = 0;
+    const int size = line.size();
+    newKeys.clear();
+
+    while (true)
+    {
+        while (i < size && isSeparator(line[i])) i++;
+        if (i == size) break;
+
+        // key, quoted or bare
+        QStringRef key;
+        if (line[i] == '"')
+        {
+            int end = line.indexOf('"', i + 1);
+            if (end < 0) return -1;
+            key = line.midRef(i + 1, end - i - 1);
+            i = end + 1;
+        }
+        else
+        {
+            int start = i;
+            while (i < size && isKeyChar(line[i])) i++;
+            key = line.midRef(start, i - start);
+        }
+        if (key.isEmpty()) return -1;
+
+        i = skipSpaces(line, i);
+        if (i == size || (line[i] != '=' && line[i] != ':')) return -1;
+        i = skipSpaces(line, i + 1);
+        if (i == size) return -1;
+
+        // JSON strings are not data
+        if (line[i] == '"')
+        {
+            int end = line.indexOf('"', i + 1);
+            if (end < 0) return -1;
+            i = end + 1;
+            continue;
+        }
+
+        int start = i;
+        while (i < size && !isSeparator(line[i])) i++;
+        QStringRef token = line.midRef(start, i - start);
+
+        double value;
+        if (token == QLatin1String("null"))
+        {
+            continue;
+        }
+        else if (token == QLatin1String("true"))
+        {
+            value = 1;
+        }
+        else if (token == QLatin1String("false"))
+        {
+            value = 0;
+        }
+        else if (!parseNumber(token, &value))
+        {
+            return -1;
+        }
+
+        int channel = lookup(key);
+        if (channel < 0) continue; // too many channels
+
+        if (numValues == values.size()) values.append(Value());
+        values[numValues++] = {(unsigned) channel, value};
+    }
+
+    // whole line is valid, register its new keys in order
+    for (auto& key : newKeys)
+    {
+        channelOf(key);
+    }
+    newKeys.clear();
+
+    return numValues;
+}
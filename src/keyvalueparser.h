@@ -0,0 +1,96 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef KEYVALUEPARSER_H
+#define KEYVALUEPARSER_H
+
+#include <QString>
+#include <QStringList>
+#include <QStringRef>
+#include <QVector>
+
+/**
+ * Parses lines of key/value pairs and maps keys to channels.
+ *
+ * Accepted forms are `key=value` and `key:value` pairs separated by
+ * spaces, commas or semicolons, and flat JSON objects such as:
+ *
+ *     {"temp": 21.5, "hum": 40, "ok": true}
+ *
+ * JSON strings and `null` values are ignored, `true` and `false` are
+ * read as 1 and 0.
+ *
+ * Keys are looked up in an open addressing hash table that is built
+ * when keys are set, unknown keys are assigned to new channels in the
+ * order they are first seen. Keys of an invalid line are not added.
+ * Parsing a line doesn't allocate unless a new key is seen.
+ */
+class KeyValueParser
+{
+public:
+    struct Value
+    {
+        unsigned channel;
+        double value;
+    };
+
+    /// @param maxChannels new keys are ignored after this many channels
+    explicit KeyValueParser(unsigned maxChannels);
+
+    /// Clears all keys and assigns given keys to first channels
+    void setKeys(const QStringList& keys);
+    /// Keys in channel order
+    QStringList keys() const;
+    unsigned numChannels() const;
+    /// Read values as hexadecimal integers
+    void setHex(bool enabled);
+
+    /**
+     * Parses a line, only channels present in the line have values.
+     *
+     * @return number of values, -1 if line is invalid
+     */
+    int parse(const QString& line);
+    /// Returns a value of last parsed line
+    const Value& value(int i) const;
+
+private:
+    unsigned _maxChannels;
+    bool isHex;
+    QStringList _keys;
+    QVector<uint> hashes;       ///< hash of each key
+    QVector<int> table;         ///< indexes into `_keys`, -1 for empty slots
+    QVector<Value> values;      ///< only grows
+    /// Keys first seen in the line being parsed, added if line is valid
+    QVector<QStringRef> newKeys;
+
+    /// Returns channel of a key, adds if new. -1 if channels are full.
+    int channelOf(const QStringRef& key);
+    /// Returns channel of a known key or -1
+    int find(const QStringRef& key, uint hash) const;
+    /// Returns channel a key will get, new keys are queued in `newKeys`.
+    /// -1 if channels are full.
+    int lookup(const QStringRef& key);
+    /// Rebuilds `table` with given size, must be power of 2
+    void rehash(int size);
+    /// Parses a value token, returns false if invalid
+    bool parseNumber(const QStringRef& token, double* value) const;
+};
+
+#endif // KEYVALUEPARSER_H
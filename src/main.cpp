@@ -5,6 +5,7 @@
 
 #include "mainwindow.h"        // 引入主窗口类头文件
 #include "tooltipfilter.h"     // 引入工具提示过滤器头文件
+#include "headless.h"          // 引入无界面采集类头文件
 #include "version.h"           // 引入版本信息头文件
 
 MainWindow* pMainWindow = nullptr;  // 声明一个指向 MainWindow 的全局指针，初始化为空指针
@@ -53,6 +54,12 @@ void messageHandler(QtMsgType type, const QMessageLogContext &context,
 
 int main(int argc, char *argv[])
 {
+    // 无界面模式：不显示任何窗口，使用 offscreen 平台（无需显示服务器）
+    bool headless = HeadlessCapture::requested(argc, argv);
+    if (headless && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
 
     QApplication a(argc, argv);  // 创建一个 QApplication 对象，传递命令行参数
     QApplication::setApplicationName(PROGRAM_NAME);  // 设置应用程序的名称
@@ -64,6 +71,18 @@ int main(int argc, char *argv[])
 #endif
 
     qInstallMessageHandler(messageHandler);  // 告知QT安装使用自定义的消息处理函数
+
+    if (headless)
+    {
+        // 不创建主窗口，仅运行读取器和记录器
+        HeadlessCapture capture;
+        if (!capture.start(a))
+        {
+            return 1;
+        }
+        return a.exec();
+    }
+
     MainWindow w;  // 创建 MainWindow 对象
     pMainWindow = &w;  // 将全局指针 pMainWindow 指向当前的 MainWindow 对象
 
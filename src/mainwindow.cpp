@@ -17,9 +17,11 @@
 #include <cmath>
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 
 #include <plot.h>
 #include <barplot.h>
+#include <spectrumview.h>
 
 #include "framebufferseries.h"
 #include "utils.h"
@@ -40,9 +42,31 @@ const QMap<int, QString> panelSettingMap({
         {3, "Commands"},
         {4, "Record"},
         {5, "TextView"},
-        {6, "Log"}
+        {6, "Trigger"},
+        {7, "Filter"},
+        {8, "Ports"},
+        {9, "Network"},
+        {10, "Log"}
     });
 
+// 从命令行参数中获取 "--buffer-dir" 的值，未设置时返回空字符串
+static QString bufferDirArgument()
+{
+    QStringList args = QCoreApplication::arguments();
+    for (int i = 1; i < args.size(); i++)
+    {
+        if (args[i] == "--buffer-dir" && i + 1 < args.size())
+        {
+            return args[i + 1];
+        }
+        else if (args[i].startsWith("--buffer-dir="))
+        {
+            return args[i].mid(strlen("--buffer-dir="));
+        }
+    }
+    return QString();
+}
+
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainWindow), // 初始化 UI
@@ -50,13 +74,21 @@ MainWindow::MainWindow(QWidget *parent) :
     portControl(&serialPort),
     secondaryPlot(NULL), // 初始化副图
     snapshotMan(this, &stream), // 快照管理器
+    sessionCheckpoint(&stream, SessionCheckpoint::defaultDirectory()), // 会话检查点
+    mathChannels(stream.infoModel()), // 数学（派生）通道
     commandPanel(&serialPort),
     dataFormatPanel(&serialPort),
     recordPanel(&stream),
     textView(&stream),
+    triggerPanel(&stream),
+    filterPanel(&filter),
+    portsPanel(&merger, stream.infoModel()),
     updateCheckDialog(this),
     bpsLabel(&portControl, &dataFormatPanel, this) // 初始化比特率标签
 {
+    // 文件缓冲区必须在通道交给绘图之前设置
+    stream.setBufferDirectory(bufferDirArgument());
+
     ui->setupUi(this); // 设置 UI
 
     plotMan = new PlotManager(ui->plotArea, &plotMenu, &stream); // 初始化绘图管理器
@@ -68,6 +100,10 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->tabWidget->insertTab(3, &commandPanel, "Commands");
     ui->tabWidget->insertTab(4, &recordPanel, "Record");
     ui->tabWidget->insertTab(5, &textView, "Text View");
+    ui->tabWidget->insertTab(6, &triggerPanel, "Trigger");
+    ui->tabWidget->insertTab(7, &filterPanel, "Filter");
+    ui->tabWidget->insertTab(8, &portsPanel, "More Ports");
+    ui->tabWidget->insertTab(9, &networkControl, "Network");
     ui->tabWidget->setCurrentIndex(0); // 设置默认显示面板为端口控制面板
 
     // 添加工具栏
@@ -109,6 +145,8 @@ MainWindow::MainWindow(QWidget *parent) :
     // 副绘图菜单信号
     connect(ui->actionBarPlot, &QAction::triggered,
             this, &MainWindow::showBarPlot);
+    connect(ui->actionSpectrum, &QAction::triggered,
+            this, &MainWindow::showSpectrum);
 
     connect(ui->actionVertical, &QAction::triggered,
             [this](bool checked)
@@ -154,6 +192,32 @@ MainWindow::MainWindow(QWidget *parent) :
     QObject::connect(&portControl, &PortControl::portToggled,
                      this, &MainWindow::onPortToggled);
 
+    // 网络输入与串口互斥，读取器跟随当前设备
+    QObject::connect(&portControl, &PortControl::portToggled,
+                     [this](bool open)
+                     {
+                         if (open) networkControl.close();
+                     });
+    QObject::connect(&networkControl, &NetworkControl::portToggled,
+                     [this](bool open)
+                     {
+                         if (open) portControl.closePort();
+                         onPortToggled(open);
+                         if (!open) recordPanel.onPortClose();
+                     });
+    QObject::connect(&networkControl, &NetworkControl::deviceChanged,
+                     [this](QIODevice* device)
+                     {
+                         dataFormatPanel.setDevice(device != nullptr ? device : portControl.device());
+                     });
+    // 管道/文件输入；网络输入打开时忽略其关闭
+    QObject::connect(&portControl, &PortControl::deviceChanged,
+                     [this](QIODevice* device)
+                     {
+                         if (device == nullptr && networkControl.isOpen()) return;
+                         dataFormatPanel.setDevice(device != nullptr ? device : &serialPort);
+                     });
+
     // 绘图控制信号
     connect(&plotControlPanel, &PlotControlPanel::numOfSamplesChanged,
             this, &MainWindow::onNumOfSamplesChanged);
@@ -161,6 +225,9 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(&plotControlPanel, &PlotControlPanel::numOfSamplesChanged,
             plotMan, &PlotManager::setNumOfSamples);
 
+    connect(&plotControlPanel, &PlotControlPanel::numOfSamplesChanged,
+            &triggerPanel, &TriggerPanel::setNumOfSamples);
+
     connect(&plotControlPanel, &PlotControlPanel::yScaleChanged,
             plotMan, &PlotManager::setYAxis);
 
@@ -192,10 +259,12 @@ MainWindow::MainWindow(QWidget *parent) :
                          if (enabled && !recordPanel.recordPaused())
                          {
                              dataFormatPanel.pause(true);
+                             portsPanel.pause(true);
                          }
                          else
                          {
                              dataFormatPanel.pause(false);
+                             portsPanel.pause(false);
                          }
                      });
 
@@ -205,6 +274,7 @@ MainWindow::MainWindow(QWidget *parent) :
                          if (ui->actionPause->isChecked() && enabled)
                          {
                              dataFormatPanel.pause(false);
+                             portsPanel.pause(false);
                          }
                      });
 
@@ -225,6 +295,7 @@ MainWindow::MainWindow(QWidget *parent) :
     plotMan->setXAxis(plotControlPanel.xAxisAsIndex(),
                       plotControlPanel.xMin(), plotControlPanel.xMax());
     plotMan->setNumOfSamples(numOfSamples);
+    triggerPanel.setNumOfSamples(numOfSamples);
     plotMan->setPlotWidth(plotControlPanel.plotWidth());
 
     // 初始化比特率（bps）计数器
@@ -254,6 +325,17 @@ MainWindow::MainWindow(QWidget *parent) :
     connect(&dataFormatPanel, &DataFormatPanel::sourceChanged,
             this, &MainWindow::onSourceChanged);
     onSourceChanged(dataFormatPanel.activeSource());
+    // 合并器（多端口）、数学通道与滤波器位于读取器与 Stream 之间，
+    // 记录器从滤波器输入端获取数据（包含派生通道）
+    // 校准、增益和偏移在滤波之前由滤波器应用，因此记录的是处理后
+    // （未滤波、未抽取）的数据；Stream 不再重复应用
+    // 注意：必须在上一级得到通道数之后再连接下一级
+    merger.connectSink(&mathChannels);
+    mathChannels.connectSink(&filter);
+    filter.setInfoModel(stream.infoModel());
+    stream.setApplyGainOffset(false);
+    filter.connectSink(&stream);
+    recordPanel.setTap(&filter);
 
     // load default settings
     QSettings settings(PROGRAM_NAME, PROGRAM_NAME);
@@ -275,6 +357,49 @@ MainWindow::MainWindow(QWidget *parent) :
                 this->ui->tabWidget->setCurrentWidget(&commandPanel);
                 this->ui->tabWidget->showTabs();
             });
+
+    // 窗口显示后询问是否恢复上次（异常结束的）会话
+    QTimer::singleShot(0, this, SLOT(restoreLastSession()));
+}
+
+//如果上次会话没有正常结束，提示将其数据作为快照载入，然后开始保存当前会话。
+void MainWindow::restoreLastSession()
+{
+    // 使用文件缓冲区时，上次会话未正常结束的数据已被移到子目录
+    if (!stream.bufferDirectory().isEmpty())
+    {
+        QStringList files = stream.previousBufferFiles();
+        if (!files.isEmpty())
+        {
+            auto clickedButton = QMessageBox::question(
+                this, "Restore Last Session",
+                "SerialPlot wasn't closed properly last time. "
+                "Do you want to load the buffer files of the last session as a snapshot?",
+                QMessageBox::Yes, QMessageBox::No);
+            if (clickedButton == QMessageBox::Yes)
+            {
+                snapshotMan.loadSnapshotFromBuffers(files);
+            }
+        }
+        return;
+    }
+
+    QStringList files = sessionCheckpoint.lastSessionFiles();
+    if (!files.isEmpty())
+    {
+        auto clickedButton = QMessageBox::question(
+            this, "Restore Last Session",
+            "SerialPlot wasn't closed properly last time. "
+            "Do you want to load the data of the last session as a snapshot?",
+            QMessageBox::Yes, QMessageBox::No);
+        if (clickedButton == QMessageBox::Yes)
+        {
+            // 快照保持文件映射，先移出会话目录，避免被新的检查点删除或覆盖
+            snapshotMan.loadSnapshotFromBuffers(sessionCheckpoint.takeLastSessionFiles());
+        }
+    }
+
+    sessionCheckpoint.start();
 }
 
 //析构函数，用于清理资源（如关闭串口和销毁 plotMan）并释放内存。
@@ -284,6 +409,9 @@ MainWindow::~MainWindow()
     {
         serialPort.close();
     }
+    // 在 ui 删除之前关闭网络输入和管道输入（关闭时会更新 ui）
+    networkControl.close();
+    portControl.closePort();
 
     delete plotMan;
 
@@ -373,7 +501,9 @@ void MainWindow::onPortToggled(bool open)
 //当数据源发生变化时调用，连接新的数据源到 stream 和 sampleCounter
 void MainWindow::onSourceChanged(Source* source)
 {
-    source->connectSink(&stream);
+    // 注意：主端口（及其读取器）仍在 GUI 线程中读取和解析，只有附加端口
+    // 使用独立的 I/O 线程（见 InputPort）
+    source->connectSink(merger.input(0));
     source->connectSink(&sampleCounter);
 }
 //清空绘图数据并重新绘制图形。
@@ -405,7 +535,7 @@ void MainWindow::enableDemo(bool enabled)
 {
     if (enabled)
     {
-        if (!serialPort.isOpen())
+        if (!portControl.isOpen() && !networkControl.isOpen())
         {
             dataFormatPanel.enableDemo(true);
         }
@@ -451,6 +581,7 @@ void MainWindow::showBarPlot(bool show)
 {
     if (show)
     {
+        ui->actionSpectrum->setChecked(false); // 同一时间只显示一个副图
         auto plot = new BarPlot(&stream, &plotMenu);
         plot->setYAxis(plotControlPanel.autoScale(),
                        plotControlPanel.yMin(),
@@ -464,6 +595,20 @@ void MainWindow::showBarPlot(bool show)
         hideSecondary();
     }
 }
+
+//显示或隐藏频谱窗口。频谱视图作为 Stream 的 follower 接收数据，在后台线程计算 FFT。
+void MainWindow::showSpectrum(bool show)
+{
+    if (show)
+    {
+        ui->actionBarPlot->setChecked(false); // 同一时间只显示一个副图
+        showSecondary(new SpectrumView(&stream, &plotMenu));
+    }
+    else
+    {
+        hideSecondary();
+    }
+}
 //导出当前绘图的数据为 CSV 文件。如果绘图正在暂停，则暂停绘图，弹出保存文件对话框，保存数据为 CSV 格式。
 void MainWindow::onExportCsv()
 {
@@ -533,6 +678,10 @@ void MainWindow::saveAllSettings(QSettings* settings)
     commandPanel.saveSettings(settings);
     recordPanel.saveSettings(settings);
     textView.saveSettings(settings);
+    triggerPanel.saveSettings(settings);
+    filterPanel.saveSettings(settings);
+    portsPanel.saveSettings(settings);
+    networkControl.saveSettings(settings);
     updateCheckDialog.saveSettings(settings);
 }
 
@@ -548,6 +697,10 @@ void MainWindow::loadAllSettings(QSettings* settings)
     commandPanel.loadSettings(settings);
     recordPanel.loadSettings(settings);
     textView.loadSettings(settings);
+    triggerPanel.loadSettings(settings);
+    filterPanel.loadSettings(settings);
+    portsPanel.loadSettings(settings);
+    networkControl.loadSettings(settings);
     updateCheckDialog.loadSettings(settings);
 }
 //保存主窗口的设置，如窗口的大小、位置、最大化状态、当前面板等。
@@ -639,11 +792,16 @@ void MainWindow::handleCommandLineOptions(const QCoreApplication &app)
     QCommandLineOption portOpt({"p", "port"}, "Set port name.", "port name");
     QCommandLineOption baudrateOpt({"b" ,"baudrate"}, "Set port baud rate.", "baud rate");
     QCommandLineOption openPortOpt({"o", "open"}, "Open serial port.");
+    // 仅用于帮助信息，实际在构造函数中处理（需要在绘图创建之前）
+    QCommandLineOption bufferDirOpt("buffer-dir",
+                                    "Keep plot buffers in memory-mapped files in given directory.",
+                                    "directory");
 
     parser.addOption(configOpt);
     parser.addOption(portOpt);
     parser.addOption(baudrateOpt);
     parser.addOption(openPortOpt);
+    parser.addOption(bufferDirOpt);
 
     parser.process(app);
 
@@ -42,11 +42,19 @@
 #include "ui_about_dialog.h"
 #include "stream.h"
 #include "snapshotmanager.h"
+#include "sessioncheckpoint.h"
 #include "plotmanager.h"
 #include "plotmenu.h"
 #include "updatecheckdialog.h"
 #include "samplecounter.h"
 #include "datatextview.h"
+#include "triggerpanel.h"
+#include "merger.h"
+#include "mathchannels.h"
+#include "filter.h"
+#include "filterpanel.h"
+#include "portspanel.h"
+#include "networkcontrol.h"
 #include "bpslabel.h"
 
 namespace Ui {
@@ -82,7 +90,11 @@ private:
     PlotManager* plotMan;
     QWidget* secondaryPlot;
     SnapshotManager snapshotMan;
+    SessionCheckpoint sessionCheckpoint;
     SampleCounter sampleCounter;
+    Merger merger;
+    MathChannels mathChannels;
+    Filter filter;
 
     QLabel spsLabel;
     CommandPanel commandPanel;
@@ -91,6 +103,10 @@ private:
     PlotControlPanel plotControlPanel;
     PlotMenu plotMenu;
     DataTextView textView;
+    TriggerPanel triggerPanel;
+    FilterPanel filterPanel;
+    PortsPanel portsPanel;
+    NetworkControl networkControl;
     UpdateCheckDialog updateCheckDialog;
     BPSLabel bpsLabel;
 
@@ -124,11 +140,15 @@ private slots:
     void onSpsChanged(float sps);
     void enableDemo(bool enabled);
     void showBarPlot(bool show);
+    void showSpectrum(bool show);
 
     void onExportCsv();
     void onExportSvg();
     void onSaveSettings();
     void onLoadSettings();
+    /// Offers the data of a crashed session as a snapshot and starts
+    /// saving the current session
+    void restoreLastSession();
 };
 
 #endif // MAINWINDOW_H
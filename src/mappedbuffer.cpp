@@ -0,0 +1,403 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <algorithm>
+#include <QFileInfo>
+#include <QtDebug>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "mappedbuffer.h"
+
+const char MappedBuffer::FILE_SUFFIX[] = ".spbuf";
+
+static const char FILE_MAGIC[8] = {'S', 'P', 'L', 'O', 'T', 'B', 'U', 'F'};
+static const quint32 FILE_VERSION = 1;
+
+MappedBuffer::MappedBuffer(unsigned n, QString fileName) :
+    file(fileName)
+{
+    map = nullptr;
+    mapped = false;
+    _size = 0;
+    headIndex = 0;
+    syncedWritten = 0;
+
+    limInvalid = false;
+    limCache = {0, 0};
+
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+    {
+        qCritical() << "Couldn't create buffer file" << fileName << ":" << file.errorString();
+    }
+    // new file is sparse, all zeros
+    setCapacity(n);
+
+    memset(header, 0, sizeof(Header));
+    memcpy(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header->version = FILE_VERSION;
+    header->dataOffset = DATA_OFFSET;
+    header->size = n;
+}
+
+MappedBuffer::MappedBuffer(QString fileName) :
+    file(fileName)
+{
+    map = nullptr;
+    mapped = false;
+    header = nullptr;
+    data = nullptr;
+    _size = 0;
+    headIndex = 0;
+    syncedWritten = 0;
+
+    limInvalid = false;
+    limCache = {0, 0};
+
+    if (QFileInfo(fileName).isFile() &&
+        file.open(QIODevice::ReadWrite) &&
+        file.size() >= DATA_OFFSET &&
+        mapFile())
+    {
+        updatePointers();
+    }
+}
+
+MappedBuffer::~MappedBuffer()
+{
+    if (mapped)
+    {
+        // file is kept, it can be re-opened with `open()`
+        unmapFile();
+    }
+    else
+    {
+        delete[] map;
+    }
+}
+
+MappedBuffer* MappedBuffer::open(QString fileName, QString* error)
+{
+    auto buf = new MappedBuffer(fileName);
+
+    QString errorStr;
+    if (!buf->mapped)
+    {
+        errorStr = buf->file.isOpen() ?
+            QString("file is too small or can't be mapped") : QString("can't open file");
+    }
+    else if (memcmp(buf->header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+             buf->header->dataOffset != DATA_OFFSET)
+    {
+        errorStr = "not a buffer file";
+    }
+    else if (buf->header->version != FILE_VERSION)
+    {
+        errorStr = QString("unsupported version %1").arg(buf->header->version);
+    }
+    else if (buf->header->size == 0 ||
+             buf->header->headIndex >= buf->header->size ||
+             DATA_OFFSET + buf->header->size * sizeof(double) > quint64(buf->file.size()))
+    {
+        errorStr = "corrupt header";
+    }
+
+    if (!errorStr.isEmpty())
+    {
+        if (error != nullptr) *error = errorStr;
+        delete buf;
+        return nullptr;
+    }
+
+    buf->_size = buf->header->size;
+    buf->headIndex = buf->header->headIndex;
+    buf->syncedWritten = buf->header->numWritten;
+    buf->limInvalid = true;
+    return buf;
+}
+
+bool MappedBuffer::isMapped() const
+{
+    return mapped;
+}
+
+QString MappedBuffer::fileName() const
+{
+    return file.fileName();
+}
+
+unsigned MappedBuffer::numValid() const
+{
+    return qMin(header->numWritten, quint64(_size));
+}
+
+bool MappedBuffer::sync()
+{
+    if (!mapped) return false;
+
+    bool ok = true;
+    quint64 n = header->numWritten - syncedWritten;
+    if (n >= _size || n > header->numWritten) // all of it, or cleared since
+    {
+        ok = syncRange(DATA_OFFSET, quint64(_size) * sizeof(double));
+    }
+    else if (n > 0)
+    {
+        // new samples end at `headIndex` and may wrap around
+        const quint64 ss = sizeof(double);
+        if (n <= headIndex)
+        {
+            ok = syncRange(DATA_OFFSET + (headIndex - n) * ss, n * ss);
+        }
+        else
+        {
+            ok = syncRange(DATA_OFFSET, headIndex * ss) &&
+                syncRange(DATA_OFFSET + (_size - (n - headIndex)) * ss, (n - headIndex) * ss);
+        }
+    }
+
+    // header last, it validates the data
+    ok = syncRange(0, sizeof(Header)) && ok;
+    syncedWritten = header->numWritten;
+    return ok;
+}
+
+unsigned MappedBuffer::size() const
+{
+    return _size;
+}
+
+double MappedBuffer::sample(unsigned i) const
+{
+    unsigned index = headIndex + i;
+    if (index >= _size) index -= _size;
+    return data[index];
+}
+
+Range MappedBuffer::limits() const
+{
+    if (limInvalid) updateLimits();
+    return limCache;
+}
+
+void MappedBuffer::resize(unsigned n)
+{
+    Q_ASSERT(n != _size);
+    if (n == _size) return;
+
+    // in place, no temporary copy of the (possibly huge) data
+    unwrap();
+    unsigned oldSize = _size;
+    if (n > oldSize)
+    {
+        setCapacity(n);
+        memmove(data + (n - oldSize), data, oldSize * sizeof(double));
+        memset(data, 0, (n - oldSize) * sizeof(double));
+    }
+    else
+    {
+        memmove(data, data + (oldSize - n), n * sizeof(double));
+        setCapacity(n);
+    }
+    header->size = n;
+    syncedWritten = quint64(-1); // all data has moved
+
+    // invalidate bounding rectangle
+    limInvalid = true;
+}
+
+void MappedBuffer::addSamples(double* samples, unsigned n)
+{
+    if (n < _size)
+    {
+        unsigned x = _size - headIndex; // distance of `head` to end
+
+        if (n <= x) // there is enough room at the end of array
+        {
+            memcpy(data + headIndex, samples, n * sizeof(double));
+            headIndex = (n == x) ? 0 : headIndex + n;
+        }
+        else // fill the end part, continue from the beginning
+        {
+            memcpy(data + headIndex, samples, x * sizeof(double));
+            memcpy(data, samples + x, (n - x) * sizeof(double));
+            headIndex = n - x;
+        }
+    }
+    else // number of new samples equal or bigger than current size (doesn't fit)
+    {
+        memcpy(data, samples + (n - _size), _size * sizeof(double));
+        headIndex = 0;
+    }
+
+    header->headIndex = headIndex;
+    header->numWritten += n;
+
+    // invalidate cache
+    limInvalid = true;
+}
+
+void MappedBuffer::clear()
+{
+    if (mapped)
+    {
+        // dropping the data from the file is faster than writing zeros
+        Header h = *header;
+        unmapFile();
+        file.resize(DATA_OFFSET);
+        setCapacity(_size);
+        *header = h;
+    }
+    else
+    {
+        memset(data, 0, _size * sizeof(double));
+    }
+
+    headIndex = 0;
+    header->headIndex = 0;
+    header->numWritten = 0;
+    syncedWritten = quint64(-1); // forces a full sync
+
+    limCache = {0, 0};
+    limInvalid = false;
+}
+
+void MappedBuffer::updateLimits() const
+{
+    limCache.start = data[0];
+    limCache.end = data[0];
+
+    for (unsigned i = 0; i < _size; i++)
+    {
+        if (data[i] > limCache.end)
+        {
+            limCache.end = data[i];
+        }
+        else if (data[i] < limCache.start)
+        {
+            limCache.start = data[i];
+        }
+    }
+
+    limInvalid = false;
+}
+
+quint64 MappedBuffer::fileSize(unsigned n)
+{
+    quint64 size = DATA_OFFSET + quint64(n) * sizeof(double);
+    return (size + FILE_ALIGNMENT - 1) / FILE_ALIGNMENT * FILE_ALIGNMENT;
+}
+
+void MappedBuffer::setCapacity(unsigned n)
+{
+    quint64 oldBytes = DATA_OFFSET + quint64(_size) * sizeof(double);
+    quint64 bytes = DATA_OFFSET + quint64(n) * sizeof(double);
+
+    if (file.isOpen())
+    {
+        unmapFile();
+        if (file.resize(fileSize(n)) && mapFile())
+        {
+            _size = n;
+            updatePointers();
+            return;
+        }
+        qCritical() << "Couldn't map buffer file" << file.fileName() << ":"
+                    << file.errorString() << "- using memory instead.";
+    }
+
+    uchar* block = new uchar[bytes]();
+    if (file.isOpen())
+    {
+        // recover what is written to the file so far
+        file.seek(0);
+        file.read((char*) block, qMin(bytes, oldBytes));
+        file.close();
+    }
+    else if (map != nullptr)
+    {
+        memcpy(block, map, qMin(bytes, oldBytes));
+        delete[] map;
+    }
+
+    map = block;
+    mapped = false;
+    _size = n;
+    updatePointers();
+}
+
+bool MappedBuffer::mapFile()
+{
+    map = file.map(0, file.size());
+    if (map == nullptr) return false;
+    mapped = true;
+
+#ifdef Q_OS_UNIX
+    // data is written sequentially, and mostly read around the head
+    madvise(map, file.size(), MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(map, file.size(), MADV_HUGEPAGE);
+#endif
+#endif
+
+    return true;
+}
+
+void MappedBuffer::unmapFile()
+{
+    if (!mapped) return;
+
+    file.unmap(map);
+    map = nullptr;
+    mapped = false;
+}
+
+void MappedBuffer::updatePointers()
+{
+    header = reinterpret_cast<Header*>(map);
+    data = reinterpret_cast<double*>(map + DATA_OFFSET);
+}
+
+void MappedBuffer::unwrap()
+{
+    if (headIndex == 0) return;
+
+    std::rotate(data, data + headIndex, data + _size);
+    headIndex = 0;
+    header->headIndex = 0;
+}
+
+bool MappedBuffer::syncRange(quint64 start, quint64 length)
+{
+    if (length == 0) return true;
+
+#ifdef Q_OS_UNIX
+    const quint64 page = sysconf(_SC_PAGESIZE);
+    quint64 alignedStart = start / page * page;
+    return msync(map + alignedStart, length + (start - alignedStart), MS_SYNC) == 0;
+#else
+    Q_UNUSED(start);
+    // data is flushed by the OS when the file is unmapped
+    return true;
+#endif
+}
@@ -0,0 +1,138 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAPPEDBUFFER_H
+#define MAPPEDBUFFER_H
+
+#include <QFile>
+#include <QString>
+
+#include "framebuffer.h"
+
+/**
+ * A ring buffer stored in a memory-mapped file. Used instead of
+ * `RingBuffer` for histories that don't fit into memory; the OS pages
+ * the data in and out as needed.
+ *
+ * File starts with a header (see `Header`) that is updated with every
+ * write, data follows at `DATA_OFFSET`. Since all writes go to the
+ * shared mapping, the file stays readable after a crash and can be
+ * re-opened with `open()`.
+ *
+ * If the file cannot be created or mapped, buffer falls back to heap
+ * memory, see `isMapped()`.
+ */
+class MappedBuffer : public WFrameBuffer
+{
+public:
+    /// Suggested file name extension
+    static const char FILE_SUFFIX[];
+    /// Offset of the data in the file, one page
+    static const unsigned DATA_OFFSET = 4096;
+    /// File size is rounded up to a multiple of this so that the
+    /// mapping can be backed by huge pages
+    static const quint64 FILE_ALIGNMENT = 2 * 1024 * 1024;
+
+    /**
+     * Creates a new buffer file, an existing file is overwritten.
+     *
+     * @param n buffer size
+     * @param fileName backing file
+     */
+    MappedBuffer(unsigned n, QString fileName);
+    ~MappedBuffer();
+
+    /**
+     * Opens an existing buffer file, for example one that is left by
+     * a crashed session.
+     *
+     * @return `nullptr` if file is not a valid buffer file, `error`
+     * is set in that case
+     */
+    static MappedBuffer* open(QString fileName, QString* error = nullptr);
+
+    /// Returns true if data is kept in the file, false if buffer
+    /// fell back to heap memory.
+    bool isMapped() const;
+    QString fileName() const;
+    /// Number of samples that are actually written (rest is initial
+    /// zeros), at most `size()`. Valid samples are at the end.
+    unsigned numValid() const;
+
+    /**
+     * Flushes changes since the last `sync()` to the disk. Only the
+     * written part of the file is flushed so the cost is proportional
+     * to the new data. Blocks until data is written.
+     *
+     * @return false on error or if buffer isn't mapped
+     */
+    bool sync();
+
+    virtual unsigned size() const;
+    virtual double sample(unsigned i) const;
+    virtual Range limits() const;
+    virtual void resize(unsigned n);
+    virtual void addSamples(double* samples, unsigned n);
+    virtual void clear();
+
+private:
+    /// Layout of the file header
+    struct Header
+    {
+        char magic[8];
+        quint32 version;
+        quint32 dataOffset;
+        quint64 size;         ///< number of samples
+        quint64 headIndex;
+        quint64 numWritten;   ///< samples added since creation or clear
+    };
+
+    QFile file;
+    uchar* map;                ///< start of the mapping or heap block
+    bool mapped;               ///< `map` is a file mapping
+    Header* header;            ///< at the start of `map`
+    double* data;              ///< at `DATA_OFFSET` of `map`
+    unsigned _size;
+    unsigned headIndex;        ///< indicates the actual `0` index of the ring buffer
+    quint64 syncedWritten;     ///< `Header::numWritten` at last `sync()`
+
+    mutable bool limInvalid;   ///< Indicates that limits needs to be re-calculated
+    mutable Range limCache;    ///< Cache for limits()
+    void updateLimits() const; ///< Updates limits cache
+
+    /// Used by `open()`
+    MappedBuffer(QString fileName);
+
+    /// Returns the file size for a buffer of `n` samples
+    static quint64 fileSize(unsigned n);
+    /// (Re)maps storage for `n` samples, keeping existing bytes. Falls
+    /// back to heap memory if file mapping fails.
+    void setCapacity(unsigned n);
+    /// Maps the whole file, returns false on error
+    bool mapFile();
+    void unmapFile();
+    /// Sets up `header` and `data` pointers after `map` changes
+    void updatePointers();
+    /// Moves the data so that `headIndex` is 0
+    void unwrap();
+    /// Flushes given range of the mapping, aligned to pages
+    bool syncRange(quint64 start, quint64 length);
+};
+
+#endif // MAPPEDBUFFER_H
@@ -0,0 +1,123 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <limits>
+#include <algorithm>
+#include <QtDebug>
+
+#include "mathchannels.h"
+
+MathChannels::MathChannels(ChannelInfoModel* infoModel, QObject* parent) :
+    QObject(parent)
+{
+    _infoModel = infoModel;
+    numInputs = 0;
+    _hasX = false;
+
+    connect(_infoModel, &ChannelInfoModel::expressionsChanged,
+            this, &MathChannels::onExpressionsChanged);
+    texts = _infoModel->expressions();
+    compile();
+}
+
+unsigned MathChannels::numDerived() const
+{
+    return texts.size();
+}
+
+bool MathChannels::hasX() const
+{
+    return _hasX;
+}
+
+unsigned MathChannels::numChannels() const
+{
+    return numInputs + numDerived();
+}
+
+void MathChannels::compile()
+{
+    expressions.resize(texts.size());
+    for (int i = 0; i < texts.size(); i++)
+    {
+        QString error;
+        if (!expressions[i].compile(texts[i], numInputs, &error) && numInputs)
+        {
+            qWarning() << "Invalid math channel expression" << texts[i] << ":" << error;
+        }
+    }
+}
+
+void MathChannels::onExpressionsChanged()
+{
+    texts = _infoModel->expressions();
+    compile();
+    updateNumChannels();
+}
+
+void MathChannels::setNumChannels(unsigned nc, bool x)
+{
+    numInputs = nc;
+    _hasX = x;
+    compile();
+
+    Sink::setNumChannels(nc, x);
+    updateNumChannels();
+}
+
+void MathChannels::feedIn(const SamplePack& data)
+{
+    Sink::feedIn(data);
+
+    if (texts.isEmpty())
+    {
+        feedOut(data);
+        return;
+    }
+
+    unsigned ns = data.numSamples();
+    SamplePack out(ns, numChannels(), data.hasX());
+    if (data.hasX())
+    {
+        memcpy(out.xData(), data.xData(), ns * sizeof(double));
+    }
+
+    columns.resize(numInputs);
+    for (unsigned ci = 0; ci < numInputs; ci++)
+    {
+        memcpy(out.data(ci), data.data(ci), ns * sizeof(double));
+        columns[ci] = data.data(ci);
+    }
+
+    for (int i = 0; i < expressions.size(); i++)
+    {
+        double* dest = out.data(numInputs + i);
+        if (expressions[i].isValid())
+        {
+            expressions[i].evaluate(columns.constData(), ns, dest);
+        }
+        else
+        {
+            std::fill(dest, dest + ns, std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+
+    feedOut(out);
+}
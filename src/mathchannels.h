@@ -0,0 +1,79 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MATHCHANNELS_H
+#define MATHCHANNELS_H
+
+#include <QObject>
+#include <QVector>
+#include <QStringList>
+
+#include "sink.h"
+#include "source.h"
+#include "expression.h"
+#include "channelinfomodel.h"
+
+/**
+ * Appends derived channels calculated from expressions to the
+ * incoming data.
+ *
+ * Expressions are taken from `ChannelInfoModel::expressions()` and
+ * are recompiled when they change. Output has input channels followed
+ * by one channel for each expression, so that derived channels are
+ * plotted, recorded and snapshotted like the input channels. An
+ * invalid expression produces NaN samples.
+ *
+ * Should be placed right after the reader. Expressions see the
+ * samples as they are read, before gain/offset is applied.
+ */
+class MathChannels : public QObject, public Sink, public Source
+{
+    Q_OBJECT
+
+public:
+    explicit MathChannels(ChannelInfoModel* infoModel, QObject* parent = 0);
+
+    /// Number of derived channels
+    unsigned numDerived() const;
+
+    // implementations for `Source`
+    bool hasX() const override;
+    unsigned numChannels() const override;
+
+protected:
+    // implementations for `Sink`
+    void feedIn(const SamplePack& data) override;
+    void setNumChannels(unsigned nc, bool x) override;
+
+private:
+    ChannelInfoModel* _infoModel;
+    unsigned numInputs;
+    bool _hasX;
+    QStringList texts;
+    QVector<Expression> expressions;
+    QVector<const double*> columns;   ///< input columns for evaluation
+
+    /// Compiles `texts` for current number of inputs
+    void compile();
+
+private slots:
+    void onExpressionsChanged();
+};
+
+#endif // MATHCHANNELS_H
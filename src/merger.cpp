@@ -0,0 +1,266 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <limits>
+#include <algorithm>
+#include <QtGlobal>
+
+#include "merger.h"
+
+Merger::Input::Input(Merger* merger)
+{
+    this->merger = merger;
+    active = false;
+    nc = 0;
+    head = 0;
+}
+
+unsigned Merger::Input::available() const
+{
+    return nc ? queue[0].size() - head : 0;
+}
+
+void Merger::Input::take(unsigned ch, unsigned n, double* out) const
+{
+    unsigned m = std::min(n, available());
+    if (m) memcpy(out, queue[ch].constData() + head, m * sizeof(double));
+    std::fill(out + m, out + n, std::numeric_limits<double>::quiet_NaN());
+}
+
+void Merger::Input::drop(unsigned n)
+{
+    head += std::min(n, available());
+
+    // compact once consumed part is larger than the rest
+    if (nc && head * 2 >= (unsigned) queue[0].size())
+    {
+        for (auto& q : queue)
+        {
+            q.remove(0, head);
+        }
+        head = 0;
+    }
+}
+
+void Merger::Input::clear()
+{
+    queue.fill(QVector<double>(), nc);
+    head = 0;
+}
+
+void Merger::Input::feedIn(const SamplePack& data)
+{
+    Sink::feedIn(data);
+    merger->onData(this, data);
+}
+
+void Merger::Input::setNumChannels(unsigned nc, bool x)
+{
+    Sink::setNumChannels(nc, x);
+    this->nc = nc;
+    merger->reset();
+}
+
+Merger::Merger()
+{
+    _maxSkew = DEFAULT_MAX_SKEW;
+    auto first = new Input(this);
+    first->active = true;
+    inputs.append(first);
+}
+
+Merger::~Merger()
+{
+    for (auto in : inputs)
+    {
+        if (in->connectedSource() != nullptr)
+        {
+            in->connectedSource()->disconnect(in);
+        }
+        delete in;
+    }
+}
+
+unsigned Merger::numInputs() const
+{
+    return inputs.size();
+}
+
+Sink* Merger::input(unsigned i)
+{
+    return inputs[i];
+}
+
+Sink* Merger::addInput()
+{
+    auto in = new Input(this);
+    inputs.append(in);
+    return in;
+}
+
+void Merger::removeInput(Sink* input)
+{
+    auto in = findInput(input);
+    Q_ASSERT(in != nullptr);
+
+    if (in->connectedSource() != nullptr)
+    {
+        in->connectedSource()->disconnect(in);
+    }
+    inputs.removeOne(in);
+    delete in;
+    reset();
+}
+
+unsigned Merger::channelOffset(const Sink* input) const
+{
+    unsigned offset = 0;
+    for (auto in : inputs)
+    {
+        if (in == input) break;
+        offset += in->nc;
+    }
+    return offset;
+}
+
+void Merger::setInputActive(Sink* input, bool active)
+{
+    auto in = findInput(input);
+    Q_ASSERT(in != nullptr);
+
+    in->active = active;
+    in->clear();
+    // others may have been waiting for this input
+    flush();
+}
+
+void Merger::setMaxSkew(unsigned samples)
+{
+    _maxSkew = samples;
+    flush();
+}
+
+unsigned Merger::numChannels() const
+{
+    unsigned nc = 0;
+    for (auto in : inputs)
+    {
+        nc += in->nc;
+    }
+    return nc;
+}
+
+Merger::Input* Merger::findInput(const Sink* input) const
+{
+    for (auto in : inputs)
+    {
+        if (in == input) return in;
+    }
+    return nullptr;
+}
+
+Merger::Input* Merger::singleInput() const
+{
+    Input* single = nullptr;
+    for (auto in : inputs)
+    {
+        if (in->nc == 0) continue;
+        if (single != nullptr) return nullptr;
+        single = in;
+    }
+    return single;
+}
+
+void Merger::onData(Input* input, const SamplePack& data)
+{
+    Q_ASSERT(data.numChannels() == input->nc);
+
+    if (!input->active) return;
+
+    if (singleInput() == input)
+    {
+        feedOut(data);
+        return;
+    }
+
+    unsigned ns = data.numSamples();
+    for (unsigned ch = 0; ch < input->nc; ch++)
+    {
+        auto& q = input->queue[ch];
+        unsigned size = q.size();
+        q.resize(size + ns);
+        memcpy(q.data() + size, data.data(ch), ns * sizeof(double));
+    }
+
+    flush();
+}
+
+void Merger::flush()
+{
+    unsigned minA = std::numeric_limits<unsigned>::max();
+    unsigned maxA = 0;
+    for (auto in : inputs)
+    {
+        if (!in->active || in->nc == 0) continue;
+        minA = std::min(minA, in->available());
+        maxA = std::max(maxA, in->available());
+    }
+
+    // no active inputs
+    if (maxA == 0) return;
+
+    unsigned n = minA;
+    if (maxA - minA > _maxSkew)
+    {
+        n = maxA - _maxSkew;
+    }
+    if (n == 0) return;
+
+    SamplePack out(n, numChannels());
+    unsigned offset = 0;
+    for (auto in : inputs)
+    {
+        for (unsigned ch = 0; ch < in->nc; ch++)
+        {
+            double* dest = out.data(offset + ch);
+            if (in->active)
+            {
+                in->take(ch, n, dest);
+            }
+            else
+            {
+                std::fill(dest, dest + n, std::numeric_limits<double>::quiet_NaN());
+            }
+        }
+        in->drop(n);
+        offset += in->nc;
+    }
+
+    feedOut(out);
+}
+
+void Merger::reset()
+{
+    for (auto in : inputs)
+    {
+        in->clear();
+    }
+    updateNumChannels();
+}
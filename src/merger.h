@@ -0,0 +1,113 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MERGER_H
+#define MERGER_H
+
+#include <QList>
+#include <QVector>
+
+#include "sink.h"
+#include "source.h"
+
+/**
+ * Merges multiple sources into a single source.
+ *
+ * Each input is a `Sink` that a source (ex: reader of a port) is
+ * connected to. Channels of inputs are concatenated in input order.
+ *
+ * Inputs are aligned by arrival: incoming samples are queued per input
+ * and the n-th sample of every input is output together. If an input
+ * falls behind the others by more than `maxSkew()` samples (ex: its
+ * device stalled) its missing samples are output as NaN so that other
+ * inputs are not held back. Inactive inputs (ex: closed ports) always
+ * output NaN.
+ *
+ * When there is only a single input with channels, data is passed
+ * through without queuing.
+ */
+class Merger : public Source
+{
+public:
+    /// Default maximum difference between queued samples of inputs
+    static const unsigned DEFAULT_MAX_SKEW = 1000;
+
+    /// Creates a merger with a single (active) input
+    Merger();
+    ~Merger();
+
+    unsigned numInputs() const;
+    Sink* input(unsigned i);
+    /// Adds a new (inactive) input at the end
+    Sink* addInput();
+    /// Removes an input, its source is disconnected
+    void removeInput(Sink* input);
+    /// Index of the first merged channel that belongs to the input
+    unsigned channelOffset(const Sink* input) const;
+    /// Inactive inputs don't hold back others, their channels are NaN
+    void setInputActive(Sink* input, bool active);
+
+    unsigned maxSkew() const {return _maxSkew;};
+    void setMaxSkew(unsigned samples);
+
+    // implementations for `Source`
+    bool hasX() const override {return false;};
+    unsigned numChannels() const override;
+
+private:
+    class Input : public Sink
+    {
+    public:
+        explicit Input(Merger* merger);
+
+        Merger* merger;
+        bool active;
+        unsigned nc;
+        /// queued samples of each channel, starting from `head`
+        QVector<QVector<double>> queue;
+        unsigned head;
+
+        /// Number of queued samples
+        unsigned available() const;
+        /// Copies `n` queued samples of a channel to `out`, missing samples are NaN
+        void take(unsigned ch, unsigned n, double* out) const;
+        /// Removes `n` samples from queue
+        void drop(unsigned n);
+        void clear();
+
+    protected:
+        void feedIn(const SamplePack& data) override;
+        void setNumChannels(unsigned nc, bool x) override;
+    };
+
+    QList<Input*> inputs;
+    unsigned _maxSkew;
+
+    Input* findInput(const Sink* input) const;
+    /// Returns the only input with channels, `nullptr` if there are more
+    Input* singleInput() const;
+    /// Called when an input receives data
+    void onData(Input* input, const SamplePack& data);
+    /// Outputs samples that are aligned
+    void flush();
+    /// Clears queues and updates number of channels
+    void reset();
+};
+
+#endif // MERGER_H
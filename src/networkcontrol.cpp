@@ -0,0 +1,278 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QFormLayout>
+#include <QVBoxLayout>
+#include <QtDebug>
+
+#include "networkcontrol.h"
+#include "setting_defines.h"
+#include "utils.h"
+
+NetworkControl::NetworkControl(QWidget* parent) :
+    QWidget(parent)
+{
+    serverClient = nullptr;
+    _isOpen = false;
+
+    cbMode.addItem(tr("TCP Client"), TcpClient);
+    cbMode.addItem(tr("TCP Server"), TcpServer);
+    cbMode.addItem(tr("UDP"), Udp);
+    leHost.setText("127.0.0.1");
+    spPort.setRange(1, 65535);
+    spPort.setValue(5000);
+    pbOpen.setText(tr("Open"));
+    pbOpen.setCheckable(true);
+    lStatus.setText(tr("Closed"));
+
+    auto form = new QFormLayout();
+    form->addRow(tr("Mode:"), &cbMode);
+    form->addRow(tr("Host:"), &leHost);
+    form->addRow(tr("Port:"), &spPort);
+    form->addRow(&pbOpen);
+    form->addRow(tr("Status:"), &lStatus);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addStretch(1);
+
+    connect(&pbOpen, &QPushButton::toggled, this, &NetworkControl::onOpenToggled);
+    connect(&cbMode, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            this, &NetworkControl::onModeChanged);
+    onModeChanged(cbMode.currentIndex());
+
+    connect(&tcpServer, &QTcpServer::newConnection,
+            this, &NetworkControl::onNewConnection);
+    connect(&tcpSocket, &QTcpSocket::stateChanged,
+            this, &NetworkControl::onTcpStateChanged);
+    connect(&tcpSocket, SIGNAL(error(QAbstractSocket::SocketError)),
+            this, SLOT(onTcpError(QAbstractSocket::SocketError)));
+}
+
+NetworkControl::~NetworkControl()
+{
+    close();
+}
+
+bool NetworkControl::isOpen() const
+{
+    return _isOpen;
+}
+
+QIODevice* NetworkControl::device()
+{
+    if (!_isOpen) return nullptr;
+
+    switch (mode())
+    {
+        case TcpClient: return &tcpSocket;
+        case TcpServer: return serverClient;
+        case Udp: return &udpDevice;
+    }
+    return nullptr;
+}
+
+NetworkControl::Mode NetworkControl::mode() const
+{
+    return (Mode) cbMode.currentData().toInt();
+}
+
+void NetworkControl::onModeChanged(int index)
+{
+    Q_UNUSED(index);
+
+    // host is the address to listen on for server and UDP
+    if (mode() == TcpClient)
+    {
+        leHost.setPlaceholderText(tr("host name or address"));
+        leHost.setToolTip(tr("Host to connect to"));
+    }
+    else
+    {
+        leHost.setPlaceholderText(tr("any"));
+        leHost.setToolTip(tr("Local address to listen on, leave empty for any"));
+    }
+}
+
+void NetworkControl::onOpenToggled(bool checked)
+{
+    if (checked)
+    {
+        open();
+    }
+    else
+    {
+        close();
+    }
+}
+
+void NetworkControl::open()
+{
+    if (_isOpen) return;
+
+    QString host = leHost.text().trimmed();
+    QHostAddress address = host.isEmpty() ? QHostAddress(QHostAddress::Any) : QHostAddress(host);
+    quint16 port = spPort.value();
+
+    if (mode() == TcpClient)
+    {
+        setOpen(true);
+        tcpSocket.connectToHost(host, port, QIODevice::ReadOnly);
+        setStatus(tr("Connecting to %1:%2").arg(host).arg(port));
+    }
+    else if (mode() == TcpServer)
+    {
+        if (!tcpServer.listen(address, port))
+        {
+            setStatus(tcpServer.errorString());
+            setOpen(false);
+            return;
+        }
+        setOpen(true);
+        setStatus(tr("Waiting for connection on port %1").arg(port));
+    }
+    else // UDP
+    {
+        if (!udpDevice.bind(port, address))
+        {
+            setStatus(udpDevice.errorString());
+            setOpen(false);
+            return;
+        }
+        setOpen(true);
+        setStatus(tr("Receiving on UDP port %1").arg(port));
+    }
+
+    emit deviceChanged(device());
+}
+
+void NetworkControl::close()
+{
+    if (!_isOpen) return;
+
+    // readers should let go of the device before it's closed
+    emit deviceChanged(nullptr);
+    _isOpen = false;
+
+    tcpSocket.abort();
+    tcpServer.close();
+    if (serverClient != nullptr)
+    {
+        serverClient->disconnect(this);
+        serverClient->abort();
+        serverClient->deleteLater();
+        serverClient = nullptr;
+    }
+    udpDevice.close();
+
+    setOpen(false);
+    setStatus(tr("Closed"));
+}
+
+void NetworkControl::setOpen(bool open)
+{
+    bool changed = open != _isOpen || open != pbOpen.isChecked();
+    _isOpen = open;
+
+    pbOpen.blockSignals(true);
+    pbOpen.setChecked(open);
+    pbOpen.blockSignals(false);
+    pbOpen.setText(open ? tr("Close") : tr("Open"));
+    cbMode.setEnabled(!open);
+    leHost.setEnabled(!open);
+    spPort.setEnabled(!open);
+
+    if (changed) emit portToggled(open);
+}
+
+void NetworkControl::setStatus(QString text)
+{
+    lStatus.setText(text);
+    qDebug() << "Network:" << text;
+}
+
+void NetworkControl::onNewConnection()
+{
+    auto client = tcpServer.nextPendingConnection();
+    if (serverClient != nullptr)
+    {
+        // only a single client is read from at a time
+        client->abort();
+        client->deleteLater();
+        return;
+    }
+
+    serverClient = client;
+    connect(serverClient, &QTcpSocket::disconnected,
+            this, &NetworkControl::onClientDisconnected);
+    setStatus(tr("Connected to %1").arg(client->peerAddress().toString()));
+    emit deviceChanged(serverClient);
+}
+
+void NetworkControl::onClientDisconnected()
+{
+    emit deviceChanged(nullptr);
+    serverClient->deleteLater();
+    serverClient = nullptr;
+    setStatus(tr("Waiting for connection on port %1").arg(tcpServer.serverPort()));
+}
+
+void NetworkControl::onTcpStateChanged(QAbstractSocket::SocketState state)
+{
+    if (!_isOpen || mode() != TcpClient) return;
+
+    if (state == QAbstractSocket::ConnectedState)
+    {
+        setStatus(tr("Connected to %1:%2")
+                  .arg(tcpSocket.peerName()).arg(tcpSocket.peerPort()));
+    }
+    else if (state == QAbstractSocket::UnconnectedState)
+    {
+        close();
+        setStatus(tr("Disconnected"));
+    }
+}
+
+void NetworkControl::onTcpError(QAbstractSocket::SocketError error)
+{
+    Q_UNUSED(error);
+    if (!_isOpen) return;
+
+    QString message = tcpSocket.errorString();
+    close();
+    setStatus(message);
+}
+
+void NetworkControl::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Network);
+    settings->setValue(SG_Network_Mode, cbMode.currentIndex());
+    settings->setValue(SG_Network_Host, leHost.text());
+    settings->setValue(SG_Network_Port, spPort.value());
+    settings->endGroup();
+}
+
+void NetworkControl::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Network);
+    cbMode.setCurrentIndex(settings->value(SG_Network_Mode, cbMode.currentIndex()).toInt());
+    leHost.setText(settings->value(SG_Network_Host, leHost.text()).toString());
+    spPort.setValue(settings->value(SG_Network_Port, spPort.value()).toInt());
+    settings->endGroup();
+}
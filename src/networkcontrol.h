@@ -0,0 +1,102 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NETWORKCONTROL_H
+#define NETWORKCONTROL_H
+
+#include <QWidget>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTcpSocket>
+#include <QTcpServer>
+#include <QSettings>
+
+#include "udpdevice.h"
+
+/**
+ * Network input as an alternative to the serial port.
+ *
+ * Supports connecting to a TCP server (ex: a serial-to-network
+ * bridge), accepting a TCP connection and receiving UDP datagrams.
+ * Readers are pointed to `device()` when it changes.
+ */
+class NetworkControl : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum Mode
+    {
+        TcpClient = 0,
+        TcpServer,
+        Udp
+    };
+
+    explicit NetworkControl(QWidget* parent = 0);
+    ~NetworkControl();
+
+    bool isOpen() const;
+    /// Device to read from, `nullptr` if there is none (ex: server without a client)
+    QIODevice* device();
+
+    /// Stores network settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads network settings from a `QSettings`
+    void loadSettings(QSettings* settings);
+
+public slots:
+    void open();
+    void close();
+
+signals:
+    /// Network input is opened or closed
+    void portToggled(bool open);
+    /// Device to read from has changed, can be `nullptr`
+    void deviceChanged(QIODevice* device);
+
+private:
+    QComboBox cbMode;
+    QLineEdit leHost;
+    QSpinBox spPort;
+    QPushButton pbOpen;
+    QLabel lStatus;
+
+    QTcpSocket tcpSocket;
+    QTcpServer tcpServer;
+    QTcpSocket* serverClient;   ///< accepted connection in server mode
+    UdpDevice udpDevice;
+    bool _isOpen;
+
+    Mode mode() const;
+    void setOpen(bool open);
+    void setStatus(QString text);
+
+private slots:
+    void onOpenToggled(bool checked);
+    void onModeChanged(int index);
+    void onNewConnection();
+    void onClientDisconnected();
+    void onTcpStateChanged(QAbstractSocket::SocketState state);
+    void onTcpError(QAbstractSocket::SocketError error);
+};
+
+#endif // NETWORKCONTROL_H
@@ -18,6 +18,7 @@
 */
 
 #include <QMap>
+#include <QRegularExpression>
 
 #include "numberformat.h"
 
@@ -29,7 +30,11 @@ QMap<NumberFormat, QString> mapping({
         {NumberFormat_int16, "int16"},
         {NumberFormat_int32, "int32"},
         {NumberFormat_float, "float"},
-        {NumberFormat_double, "double"}
+        {NumberFormat_double, "double"},
+        {NumberFormat_uint12, "uint12"},
+        {NumberFormat_int12, "int12"},
+        {NumberFormat_uint24, "uint24"},
+        {NumberFormat_int24, "int24"}
     });
 
 QString numberFormatToStr(NumberFormat nf)
@@ -41,3 +46,170 @@ NumberFormat strToNumberFormat(QString str)
 {
     return mapping.key(str, NumberFormat_INVALID);
 }
+
+unsigned numberFormatSize(NumberFormat nf)
+{
+    switch(nf)
+    {
+        case NumberFormat_uint8:
+        case NumberFormat_int8:
+            return 1;
+        case NumberFormat_uint16:
+        case NumberFormat_int16:
+            return 2;
+        case NumberFormat_uint24:
+        case NumberFormat_int24:
+            return 3;
+        case NumberFormat_uint32:
+        case NumberFormat_int32:
+        case NumberFormat_float:
+            return 4;
+        case NumberFormat_double:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+unsigned numberFormatBits(NumberFormat nf)
+{
+    switch(nf)
+    {
+        case NumberFormat_uint12:
+        case NumberFormat_int12:
+            return 12;
+        default:
+            return numberFormatSize(nf) * 8;
+    }
+}
+
+bool numberFormatIsSigned(NumberFormat nf)
+{
+    switch(nf)
+    {
+        case NumberFormat_int8:
+        case NumberFormat_int12:
+        case NumberFormat_int16:
+        case NumberFormat_int24:
+        case NumberFormat_int32:
+        case NumberFormat_float:
+        case NumberFormat_double:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool numberFormatIsPacked(NumberFormat nf)
+{
+    return nf == NumberFormat_uint12 || nf == NumberFormat_int12 ||
+        nf == NumberFormat_uint24 || nf == NumberFormat_int24;
+}
+
+bool strToBitFormat(QString str, unsigned* bits, bool* isSigned)
+{
+    QRegularExpression re("^(u?)int(\\d+)$");
+    auto match = re.match(str);
+    if (!match.hasMatch()) return false;
+
+    unsigned b = match.captured(2).toUInt();
+    if (b < 1 || b > 32) return false;
+
+    *bits = b;
+    *isSigned = match.captured(1).isEmpty();
+    return true;
+}
+
+namespace
+{
+/// Reads `NB` bytes as an integer in given byte order
+template<unsigned NB, bool BE>
+inline quint64 loadBytes(const uchar* src)
+{
+    quint64 v = 0;
+    for (unsigned b = 0; b < NB; b++)
+    {
+        v |= quint64(src[b]) << (8 * (BE ? NB - 1 - b : b));
+    }
+    return v;
+}
+
+/// Unpack kernel, byte count is known at compile time so that the
+/// load is unrolled
+template<unsigned NB, bool BE, bool SIGNED>
+void unpackKernel(const uchar* src, unsigned stride, unsigned n,
+                  unsigned rshift, unsigned bits, double* dst)
+{
+    const quint64 mask = (quint64(1) << bits) - 1;
+    const qint64 signBit = qint64(1) << (bits - 1);
+    for (unsigned i = 0; i < n; i++)
+    {
+        quint64 v = (loadBytes<NB, BE>(src) >> rshift) & mask;
+        // sign extend
+        dst[i] = SIGNED ? double(qint64(v ^ signBit) - signBit) : double(v);
+        src += stride;
+    }
+}
+
+typedef void (*UnpackFunc)(const uchar* src, unsigned stride, unsigned n,
+                           unsigned rshift, unsigned bits, double* dst);
+
+template<bool BE, bool SIGNED>
+UnpackFunc unpackFunc(unsigned nbytes)
+{
+    switch(nbytes)
+    {
+        case 1: return &unpackKernel<1, BE, SIGNED>;
+        case 2: return &unpackKernel<2, BE, SIGNED>;
+        case 3: return &unpackKernel<3, BE, SIGNED>;
+        case 4: return &unpackKernel<4, BE, SIGNED>;
+        case 5: return &unpackKernel<5, BE, SIGNED>;
+        default:
+            Q_ASSERT(false); // never
+            return nullptr;
+    }
+}
+}
+
+void unpackBits(const uchar* src, unsigned stride, unsigned n,
+                unsigned shift, unsigned bits, bool isSigned, bool bigEndian,
+                double* dst)
+{
+    Q_ASSERT(shift < 8);
+    Q_ASSERT(bits >= 1 && bits <= 32);
+
+    unsigned nbytes = (shift + bits + 7) / 8;
+    // position of LSB of the value in the loaded integer
+    unsigned rshift = bigEndian ? nbytes * 8 - shift - bits : shift;
+
+    UnpackFunc func;
+    if (bigEndian)
+    {
+        func = isSigned ? unpackFunc<true, true>(nbytes) : unpackFunc<true, false>(nbytes);
+    }
+    else
+    {
+        func = isSigned ? unpackFunc<false, true>(nbytes) : unpackFunc<false, false>(nbytes);
+    }
+    func(src, stride, n, rshift, bits, dst);
+}
+
+void packBits(quint32 value, uchar* dst,
+              unsigned shift, unsigned bits, bool bigEndian)
+{
+    Q_ASSERT(shift < 8);
+    Q_ASSERT(bits >= 1 && bits <= 32);
+
+    unsigned nbytes = (shift + bits + 7) / 8;
+    unsigned lshift = bigEndian ? nbytes * 8 - shift - bits : shift;
+    quint64 mask = ((quint64(1) << bits) - 1) << lshift;
+    quint64 v = (quint64(value) << lshift) & mask;
+
+    // keep neighbouring bits
+    for (unsigned b = 0; b < nbytes; b++)
+    {
+        unsigned pos = 8 * (bigEndian ? nbytes - 1 - b : b);
+        uchar m = mask >> pos;
+        dst[b] = (dst[b] & ~m) | uchar(v >> pos);
+    }
+}
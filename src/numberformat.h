@@ -21,6 +21,7 @@
 #define NUMBERFORMAT_H
 
 #include <QString>
+#include <QtGlobal>
 
 enum NumberFormat
 {
@@ -32,6 +33,10 @@ enum NumberFormat
     NumberFormat_int32,
     NumberFormat_float,
     NumberFormat_double,
+    NumberFormat_uint12,        ///< bit packed, 2 samples in 3 bytes
+    NumberFormat_int12,         ///< bit packed, 2 samples in 3 bytes
+    NumberFormat_uint24,
+    NumberFormat_int24,
     NumberFormat_INVALID ///< used for error cases
 };
 
@@ -41,4 +46,41 @@ QString numberFormatToStr(NumberFormat nf);
 /// Convert string to `NumberFormat`
 NumberFormat strToNumberFormat(QString str);
 
+/// Returns size of a `NumberFormat` in bytes, 0 if it isn't whole bytes
+unsigned numberFormatSize(NumberFormat nf);
+
+/// Returns size of a `NumberFormat` in bits
+unsigned numberFormatBits(NumberFormat nf);
+
+/// Returns true if `NumberFormat` can hold negative values
+bool numberFormatIsSigned(NumberFormat nf);
+
+/// Returns true if `NumberFormat` is read with `unpackBits`
+bool numberFormatIsPacked(NumberFormat nf);
+
+/**
+ * Parses an integer format of arbitrary width such as "uint10" or
+ * "int5". Width can be from 1 to 32 bits.
+ *
+ * @return false if `str` isn't a valid integer format
+ */
+bool strToBitFormat(QString str, unsigned* bits, bool* isSigned);
+
+/**
+ * Unpacks `n` integers of `bits` width (1 to 32) spaced `stride`
+ * bytes apart. Values don't have to be byte aligned; each one starts
+ * `shift` bits (0 to 7) into its first byte.
+ *
+ * With little endian bits are counted from the LSB of each byte and
+ * lower bytes hold lower bits of a value. With big endian bits are
+ * counted from the MSB of each byte and values are stored MSB first.
+ */
+void unpackBits(const uchar* src, unsigned stride, unsigned n,
+                unsigned shift, unsigned bits, bool isSigned, bool bigEndian,
+                double* dst);
+
+/// Writes lower `bits` of `value` into `dst`, inverse of `unpackBits`
+void packBits(quint32 value, uchar* dst,
+              unsigned shift, unsigned bits, bool bigEndian);
+
 #endif // NUMBERFORMAT_H
@@ -35,6 +35,10 @@ NumberFormatBox::NumberFormatBox(QWidget *parent) :
     buttonGroup.addButton(ui->rbInt32,  NumberFormat_int32);
     buttonGroup.addButton(ui->rbFloat,  NumberFormat_float);
     buttonGroup.addButton(ui->rbDouble,  NumberFormat_double);
+    buttonGroup.addButton(ui->rbUint12, NumberFormat_uint12);
+    buttonGroup.addButton(ui->rbInt12,  NumberFormat_int12);
+    buttonGroup.addButton(ui->rbUint24, NumberFormat_uint24);
+    buttonGroup.addButton(ui->rbInt24,  NumberFormat_int24);
 
     QObject::connect(
         &buttonGroup, SIGNAL(buttonToggled(int, bool)),
@@ -0,0 +1,218 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <QtDebug>
+
+#include "bytestuffing.h"
+#include "packetreader.h"
+
+PacketReader::PacketReader(QIODevice* device, QObject* parent) :
+    AbstractReader(device, parent)
+{
+    paused = false;
+
+    _numChannels = _settingsWidget.numOfChannels();
+    encoding = _settingsWidget.encoding();
+    checksumType = _settingsWidget.checksumType();
+    updateLayout();
+    reset();
+
+    connect(&_settingsWidget, &PacketReaderSettings::encodingChanged,
+            [this](PacketReaderSettings::Encoding value)
+            {
+                encoding = value;
+                reset();
+            });
+
+    connect(&_settingsWidget, &PacketReaderSettings::numOfChannelsChanged,
+            [this](){updateLayout();});
+
+    connect(&_settingsWidget, &PacketReaderSettings::numberFormatChanged,
+            [this](){updateLayout();});
+
+    connect(&_settingsWidget, &PacketReaderSettings::layoutChanged,
+            [this](){updateLayout();});
+
+    connect(&_settingsWidget, &PacketReaderSettings::endiannessChanged,
+            [this](Endianness endianness){layout.setEndianness(endianness);});
+
+    connect(&_settingsWidget, &PacketReaderSettings::checksumChanged,
+            [this](ChecksumType type){checksumType = type;});
+}
+
+QWidget* PacketReader::settingsWidget()
+{
+    return &_settingsWidget;
+}
+
+unsigned PacketReader::numChannels() const
+{
+    return _numChannels;
+}
+
+void PacketReader::enable(bool enabled)
+{
+    reset();
+    AbstractReader::enable(enabled);
+}
+
+void PacketReader::setDevice(QIODevice* device)
+{
+    reset();
+    AbstractReader::setDevice(device);
+}
+
+void PacketReader::updateLayout()
+{
+    QString desc = _settingsWidget.layoutDescription();
+    if (desc.isEmpty() || !layout.parse(desc))
+    {
+        layout = FrameLayout(_settingsWidget.numOfChannels(),
+                             _settingsWidget.numberFormat());
+    }
+    layout.setEndianness(_settingsWidget.endianness());
+
+    unsigned nc = layout.numChannels();
+    if (nc != _numChannels)
+    {
+        _numChannels = nc;
+        updateNumChannels();
+        emit numOfChannelsChanged(nc);
+    }
+}
+
+void PacketReader::reset()
+{
+    numPending = 0;
+    synced = false;
+}
+
+unsigned PacketReader::readData()
+{
+    qint64 bytesAvailable = _device->bytesAvailable();
+    if (bytesAvailable <= 0) return 0;
+
+    // append new data after the incomplete packet
+    buffer.resize(numPending + bytesAvailable);
+    qint64 numRead = _device->read(buffer.data() + numPending, bytesAvailable);
+    if (numRead <= 0) return 0;
+
+    uchar* data = (uchar*) buffer.data();
+    unsigned size = numPending + numRead;
+    const uchar delimiter = encoding == PacketReaderSettings::Encoding::COBS ?
+        COBS_DELIMITER : SLIP_END;
+
+    // find packets, pending bytes are already known to have no delimiter
+    unsigned start = 0;         // start of current packet
+    unsigned payloadEnd = 0;    // payloads are collected at the beginning
+    unsigned scanFrom = numPending;
+    const uchar* found;
+    while (scanFrom < size &&
+           (found = (const uchar*) memchr(data + scanFrom, delimiter, size - scanFrom)))
+    {
+        unsigned end = found - data;
+        // data before the first delimiter can be a partial packet
+        if (synced)
+        {
+            payloadEnd += processPacket(data + start, end - start, data + payloadEnd);
+        }
+        synced = true;
+        start = end + 1;
+        scanFrom = start;
+    }
+
+    // commit all payloads at once
+    unsigned numPackages = payloadEnd / layout.size();
+    if (numPackages && !paused)
+    {
+        SamplePack samples(numPackages * layout.setsPerPackage(), _numChannels);
+        layout.decode(data, numPackages, &samples);
+        feedOut(samples);
+    }
+
+    // keep the incomplete packet for next read
+    numPending = size - start;
+    if (numPending > MAX_PACKET_SIZE)
+    {
+        qCritical() << "Packet is too long, discarding" << numPending << "bytes.";
+        reset();
+    }
+    else
+    {
+        memmove(data, data + start, numPending);
+    }
+
+    return numRead;
+}
+
+unsigned PacketReader::processPacket(uchar* packet, unsigned size, uchar* dest)
+{
+    // empty packets are used to flush the line, SLIP senders often start with END
+    if (size == 0) return 0;
+
+    int decodedSize = encoding == PacketReaderSettings::Encoding::COBS ?
+        cobsDecode(packet, size) : slipDecode(packet, size);
+    if (decodedSize < 0)
+    {
+        qCritical() << "Invalid packet encoding!";
+        return 0;
+    }
+
+    unsigned payloadSize = decodedSize;
+    if (checksumType != ChecksumType_None)
+    {
+        unsigned csSize = checksumSize(checksumType);
+        if (payloadSize < csSize)
+        {
+            qCritical() << "Packet is too short for checksum!";
+            return 0;
+        }
+        payloadSize -= csSize;
+
+        quint32 calculated = calcChecksum(checksumType, packet, payloadSize);
+        quint32 received = readChecksum(checksumType, packet + payloadSize,
+                                        layout.endianness() == LittleEndian);
+        if (calculated != received)
+        {
+            qCritical() << "Checksum failed! Received:" << received << "Calculated:" << calculated;
+            return 0;
+        }
+    }
+
+    if (payloadSize % layout.size() != 0)
+    {
+        qCritical() << QString("Packet payload size (%1) is not multiple of %2 (sample set size)!")
+            .arg(payloadSize).arg(layout.size());
+        return 0;
+    }
+
+    memmove(dest, packet, payloadSize);
+    return payloadSize;
+}
+
+void PacketReader::saveSettings(QSettings* settings)
+{
+    _settingsWidget.saveSettings(settings);
+}
+
+void PacketReader::loadSettings(QSettings* settings)
+{
+    _settingsWidget.loadSettings(settings);
+}
@@ -0,0 +1,87 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PACKETREADER_H
+#define PACKETREADER_H
+
+#include <QSettings>
+#include <QByteArray>
+
+#include "abstractreader.h"
+#include "packetreadersettings.h"
+#include "framelayout.h"
+
+/**
+ * Reads packets that are delimited with COBS or SLIP byte
+ * stuffing. Since the delimiter byte never appears inside a packet,
+ * every delimiter is a packet boundary and a corrupted packet never
+ * affects the next one.
+ *
+ * Payload of a packet is one or more sample sets in `FrameLayout`
+ * format, optionally followed by a checksum.
+ */
+class PacketReader : public AbstractReader
+{
+    Q_OBJECT
+
+public:
+    /// Packets longer than this are discarded
+    static const unsigned MAX_PACKET_SIZE = 64 * 1024;
+
+    explicit PacketReader(QIODevice* device, QObject *parent = 0);
+    QWidget* settingsWidget();
+    unsigned numChannels() const;
+    void enable(bool enabled = true) override;
+    void setDevice(QIODevice* device) override;
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+private:
+    PacketReaderSettings _settingsWidget;
+    unsigned _numChannels;
+    PacketReaderSettings::Encoding encoding;
+    FrameLayout layout;
+    ChecksumType checksumType;
+
+    /// Read buffer. Packets are decoded in place and their payloads
+    /// are moved to the beginning. It is reused between reads.
+    QByteArray buffer;
+    unsigned numPending;        ///< bytes of the incomplete packet at the start of `buffer`
+    bool synced;                ///< a delimiter is seen, next packet start is known
+
+    /// Updates `layout` from settings, also updates number of
+    /// channels if changed
+    void updateLayout();
+    /// Discards incomplete packet and waits for the next delimiter
+    void reset();
+    /**
+     * Decodes and checks a packet in place then moves its payload to
+     * `dest`.
+     *
+     * @param dest should be before or at `packet`
+     * @return payload size, 0 if packet is invalid
+     */
+    unsigned processPacket(uchar* packet, unsigned size, uchar* dest);
+
+    unsigned readData() override;
+};
+
+#endif // PACKETREADER_H
@@ -0,0 +1,167 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "utils.h"
+#include "defines.h"
+#include "setting_defines.h"
+#include "packetreadersettings.h"
+#include "ui_packetreadersettings.h"
+
+PacketReaderSettings::PacketReaderSettings(QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::PacketReaderSettings)
+{
+    ui->setupUi(this);
+
+    ui->spNumOfChannels->setMaximum(MAX_NUM_CHANNELS);
+
+    connect(ui->cbEncoding, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            [this](int index)
+            {
+                emit encodingChanged(static_cast<Encoding>(index));
+            });
+
+    connect(ui->spNumOfChannels, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int value)
+            {
+                emit numOfChannelsChanged(value);
+            });
+
+    connect(ui->nfBox, SIGNAL(selectionChanged(NumberFormat)),
+            this, SIGNAL(numberFormatChanged(NumberFormat)));
+
+    connect(ui->endiBox, SIGNAL(selectionChanged(Endianness)),
+            this, SIGNAL(endiannessChanged(Endianness)));
+
+    // layout overrides number format and number of channels
+    connect(ui->leLayout, &FrameLayoutEdit::descriptionChanged,
+            [this](QString desc)
+            {
+                ui->nfBox->setEnabled(desc.isEmpty());
+                ui->spNumOfChannels->setEnabled(desc.isEmpty());
+                emit layoutChanged(desc);
+            });
+
+    connect(ui->cbChecksum, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            [this](int index)
+            {
+                emit checksumChanged(static_cast<ChecksumType>(index));
+            });
+}
+
+PacketReaderSettings::~PacketReaderSettings()
+{
+    delete ui;
+}
+
+PacketReaderSettings::Encoding PacketReaderSettings::encoding()
+{
+    return static_cast<Encoding>(ui->cbEncoding->currentIndex());
+}
+
+unsigned PacketReaderSettings::numOfChannels()
+{
+    return ui->spNumOfChannels->value();
+}
+
+NumberFormat PacketReaderSettings::numberFormat()
+{
+    return ui->nfBox->currentSelection();
+}
+
+Endianness PacketReaderSettings::endianness()
+{
+    return ui->endiBox->currentSelection();
+}
+
+QString PacketReaderSettings::layoutDescription()
+{
+    return ui->leLayout->description();
+}
+
+ChecksumType PacketReaderSettings::checksumType()
+{
+    return static_cast<ChecksumType>(ui->cbChecksum->currentIndex());
+}
+
+void PacketReaderSettings::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Packet);
+    settings->setValue(SG_Packet_Encoding, encoding() == Encoding::COBS ? "cobs" : "slip");
+    settings->setValue(SG_Packet_NumOfChannels, numOfChannels());
+    settings->setValue(SG_Packet_NumberFormat, numberFormatToStr(numberFormat()));
+    settings->setValue(SG_Packet_Endianness,
+                       endianness() == LittleEndian ? "little" : "big");
+    settings->setValue(SG_Packet_Layout, ui->leLayout->text());
+    settings->setValue(SG_Packet_Checksum, checksumTypeToStr(checksumType()));
+    settings->endGroup();
+}
+
+void PacketReaderSettings::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Packet);
+
+    // load encoding
+    QString encodingSetting = settings->value(SG_Packet_Encoding, QString()).toString();
+    if (encodingSetting == "cobs")
+    {
+        ui->cbEncoding->setCurrentIndex((int) Encoding::COBS);
+    }
+    else if (encodingSetting == "slip")
+    {
+        ui->cbEncoding->setCurrentIndex((int) Encoding::SLIP);
+    } // else don't change
+
+    // load number of channels
+    ui->spNumOfChannels->setValue(
+        settings->value(SG_Packet_NumOfChannels, numOfChannels()).toInt());
+
+    // load number format
+    NumberFormat nfSetting =
+        strToNumberFormat(settings->value(SG_Packet_NumberFormat,
+                                          QString()).toString());
+    if (nfSetting == NumberFormat_INVALID) nfSetting = numberFormat();
+    ui->nfBox->setSelection(nfSetting);
+
+    // load endianness
+    QString endiannessSetting =
+        settings->value(SG_Packet_Endianness, QString()).toString();
+    if (endiannessSetting == "little")
+    {
+        ui->endiBox->setSelection(LittleEndian);
+    }
+    else if (endiannessSetting == "big")
+    {
+        ui->endiBox->setSelection(BigEndian);
+    } // else don't change
+
+    // load layout
+    ui->leLayout->setText(
+        settings->value(SG_Packet_Layout, ui->leLayout->text()).toString());
+
+    // load checksum
+    ChecksumType csSetting =
+        strToChecksumType(settings->value(SG_Packet_Checksum, QString()).toString());
+    if (csSetting != ChecksumType_INVALID)
+    {
+        ui->cbChecksum->setCurrentIndex(csSetting);
+    }
+
+    settings->endGroup();
+}
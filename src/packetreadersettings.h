@@ -0,0 +1,75 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PACKETREADERSETTINGS_H
+#define PACKETREADERSETTINGS_H
+
+#include <QWidget>
+#include <QSettings>
+
+#include "numberformatbox.h"
+#include "endiannessbox.h"
+#include "checksum.h"
+
+namespace Ui {
+class PacketReaderSettings;
+}
+
+class PacketReaderSettings : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /// Byte stuffing method used to delimit packets
+    enum class Encoding
+    {
+        COBS,                   ///< Consistent Overhead Byte Stuffing, 0x00 delimited
+        SLIP                    ///< RFC 1055, 0xC0 delimited
+    };
+
+    explicit PacketReaderSettings(QWidget *parent = 0);
+    ~PacketReaderSettings();
+
+    Encoding encoding();
+    unsigned numOfChannels();
+    NumberFormat numberFormat();
+    Endianness endianness();
+    /// Returns layout description, empty if not set or invalid
+    QString layoutDescription();
+    ChecksumType checksumType();
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+signals:
+    void encodingChanged(Encoding);
+    void numOfChannelsChanged(unsigned);
+    void numberFormatChanged(NumberFormat);
+    void endiannessChanged(Endianness);
+    /// Signaled with a valid layout description or empty string
+    void layoutChanged(QString);
+    void checksumChanged(ChecksumType);
+
+private:
+    Ui::PacketReaderSettings *ui;
+};
+
+#endif // PACKETREADERSETTINGS_H
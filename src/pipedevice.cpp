@@ -0,0 +1,241 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <QFileInfo>
+#include <QtDebug>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#endif
+
+#include "pipedevice.h"
+
+/// Poll interval for regular files after reaching their end
+const int FILE_POLL_INTERVAL = 100; // ms
+
+/// Return values of `readChunk()` other than number of bytes
+const qint64 READ_WOULD_BLOCK = -1;
+const qint64 READ_ERROR = -2;
+
+const char PipeDevice::STDIN_PATH[] = "-";
+
+PipeDevice::PipeDevice(QObject* parent) :
+    BufferedInputDevice(parent)
+{
+    fd = -1;
+    notifier = nullptr;
+    inputEnd = false;
+    suspended = false;
+
+    connect(&pollTimer, &QTimer::timeout, this, &PipeDevice::readAvailable);
+}
+
+PipeDevice::~PipeDevice()
+{
+    close();
+}
+
+bool PipeDevice::openPath(QString path)
+{
+    if (isOpen()) close();
+
+    bool isPipe;
+#ifdef Q_OS_UNIX
+    if (path == STDIN_PATH)
+    {
+        fd = STDIN_FILENO;
+        isPipe = true;
+    }
+    else
+    {
+        struct stat st;
+        if (stat(path.toLocal8Bit().constData(), &st) != 0)
+        {
+            setErrorString(strerror(errno));
+            return false;
+        }
+        isPipe = !S_ISREG(st.st_mode);
+
+        // A FIFO is opened for writing as well so that it never
+        // reaches EOF (and signals readability endlessly) when the
+        // last writer leaves. Next writer just continues the stream.
+        int flags = (S_ISFIFO(st.st_mode) ? O_RDWR : O_RDONLY) | O_NONBLOCK;
+        fd = ::open(path.toLocal8Bit().constData(), flags);
+        if (fd < 0)
+        {
+            setErrorString(strerror(errno));
+            return false;
+        }
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+#else
+    if (path == STDIN_PATH || !QFileInfo(path).isFile())
+    {
+        setErrorString(tr("Only regular files are supported on this platform"));
+        return false;
+    }
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+    {
+        setErrorString(file.errorString());
+        return false;
+    }
+    isPipe = false;
+#endif
+
+    _path = path;
+    resetBuffer(READ_CHUNK_SIZE);
+    inputEnd = false;
+    suspended = false;
+
+    if (isPipe)
+    {
+        notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated,
+                this, &PipeDevice::readAvailable);
+    }
+
+    // unbuffered: `read()` is served directly from the internal buffer
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    watch(true);
+    return true;
+}
+
+QString PipeDevice::path() const
+{
+    return _path;
+}
+
+bool PipeDevice::atInputEnd() const
+{
+    return inputEnd;
+}
+
+void PipeDevice::close()
+{
+    watch(false);
+    delete notifier;
+    notifier = nullptr;
+
+#ifdef Q_OS_UNIX
+    if (fd == STDIN_FILENO)
+    {
+        // stdin is shared with the parent process, restore blocking mode
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    }
+    else if (fd >= 0)
+    {
+        ::close(fd);
+    }
+#endif
+    fd = -1;
+    file.close();
+
+    resetBuffer();
+    QIODevice::close();
+}
+
+void PipeDevice::watch(bool enabled)
+{
+    if (notifier != nullptr)
+    {
+        notifier->setEnabled(enabled);
+    }
+    else if (enabled)
+    {
+        pollTimer.start(0);
+    }
+    else
+    {
+        pollTimer.stop();
+    }
+}
+
+qint64 PipeDevice::readChunk(char* data, qint64 maxSize)
+{
+#ifdef Q_OS_UNIX
+    while (true)
+    {
+        ssize_t n = ::read(fd, data, maxSize);
+        if (n >= 0) return n;
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return READ_WOULD_BLOCK;
+        setErrorString(strerror(errno));
+        return READ_ERROR;
+    }
+#else
+    qint64 n = file.read(data, maxSize);
+    if (n < 0) setErrorString(file.errorString());
+    return n < 0 ? READ_ERROR : n;
+#endif
+}
+
+void PipeDevice::readAvailable()
+{
+    compactBuffer();
+
+    bool received = false;
+    qint64 n = 0;
+    while (bufferedSize() < MAX_BUFFER_SIZE)
+    {
+        n = readChunk(beginAppend(READ_CHUNK_SIZE), READ_CHUNK_SIZE);
+        endAppend(n);
+        if (n <= 0) break;
+        received = true;
+    }
+
+    if (bufferedSize() >= MAX_BUFFER_SIZE)
+    {
+        // wait for the data to be consumed, see `dataConsumed()`
+        suspended = true;
+        watch(false);
+    }
+    else if (n == READ_ERROR)
+    {
+        qWarning() << "Error reading" << _path << ":" << errorString();
+        watch(false);
+    }
+    else if (n == 0 && notifier != nullptr)
+    {
+        // end of standard input (or a pipe like device)
+        inputEnd = true;
+        watch(false);
+    }
+    else if (notifier == nullptr)
+    {
+        // keep reading a file as fast as possible, slow down at its end
+        pollTimer.setInterval(n == 0 ? FILE_POLL_INTERVAL : 0);
+    }
+
+    if (received) emit readyRead();
+    if (inputEnd) emit readChannelFinished();
+}
+
+void PipeDevice::dataConsumed()
+{
+    if (suspended && bufferedSize() < MAX_BUFFER_SIZE / 2)
+    {
+        suspended = false;
+        watch(true);
+    }
+}
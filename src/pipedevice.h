@@ -0,0 +1,95 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PIPEDEVICE_H
+#define PIPEDEVICE_H
+
+#include <QFile>
+#include <QTimer>
+#include <QSocketNotifier>
+
+#include "bufferedinputdevice.h"
+
+/**
+ * Sequential read only device that reads from standard input, a
+ * named pipe (FIFO) or a regular file. Allows piping data from other
+ * tools into the readers without creating a pseudo terminal.
+ *
+ * Reads are non-blocking and done in large chunks into the internal
+ * buffer (see `BufferedInputDevice`). Pipes are watched with a
+ * socket notifier, regular files are polled so that a growing file
+ * is followed (like `tail -f`). Reading is suspended when
+ * `MAX_BUFFER_SIZE` bytes are waiting to be consumed.
+ *
+ * @note On platforms other than Unix only regular files are
+ * supported.
+ */
+class PipeDevice : public BufferedInputDevice
+{
+    Q_OBJECT
+
+public:
+    /// Path that selects the standard input
+    static const char STDIN_PATH[];
+    /// Size of a single read from the underlying file descriptor
+    static const int READ_CHUNK_SIZE = 256 * 1024;
+    /// Reading is suspended when this much data is waiting
+    static const int MAX_BUFFER_SIZE = 16 * 1024 * 1024;
+
+    explicit PipeDevice(QObject* parent = 0);
+    ~PipeDevice();
+
+    /**
+     * Opens the given path for reading. See `STDIN_PATH`.
+     *
+     * @return false if path cannot be opened, see `errorString()`
+     */
+    bool openPath(QString path);
+    /// Path that device is opened with
+    QString path() const;
+    /// Returns true if end of input is reached. Only standard input
+    /// has an end, FIFOs and files are followed until closed.
+    bool atInputEnd() const;
+
+    // reimplemented from QIODevice
+    void close() override;
+
+protected:
+    void dataConsumed() override;
+
+private:
+    QString _path;
+    int fd;                     ///< -1 if not using a file descriptor
+    QFile file;                 ///< used for regular files when `fd` isn't available
+    QSocketNotifier* notifier;  ///< only for pipes
+    QTimer pollTimer;           ///< only for regular files
+    bool inputEnd;
+    bool suspended;             ///< reading suspended due to full buffer
+
+    /// Reads a chunk from the source, returns 0 at end of input and
+    /// -1 if there is nothing to read at the moment or on error
+    qint64 readChunk(char* data, qint64 maxSize);
+    /// Enables/disables watching the source for new data
+    void watch(bool enabled);
+
+private slots:
+    void readAvailable();
+};
+
+#endif // PIPEDEVICE_H
@@ -1,13 +1,18 @@
 #include <QRectF>
 #include <QKeySequence>
 #include <QColor>
+#include <QPainter>
 #include <qwt_symbol.h>
 #include <qwt_plot_curve.h>
+#include <qwt_plot_canvas.h>
+#include <qwt_legend_data.h>
 #include <qwt_scale_map.h>
 #include <math.h>
 #include <algorithm>
+#include <limits>
 
 #include "plot.h"
+#include "plotcurve.h"
 #include "utils.h"
 
 // 常量，表示在某些情况下显示符号（数据点的表示）时的尺寸
@@ -25,6 +30,13 @@ Plot::Plot(QWidget* parent) :
     numOfSamples = 1;     // 初始化样本数量
     plotWidth = 1;        // 初始化绘图宽度
     showSymbols = Plot::ShowSymbolsAuto;  // 自动显示符号
+    rollMode = false;        // 默认关闭滚动（增量）绘制模式
+    inCanvasPaint = false;
+    rollLayerValid = false;  // 曲线缓存尚未生成
+    rollResidual = 0;
+    staticLayersValid = false;  // 静态图层（网格、图例等）尚未生成
+    curveImageReady = false;
+    curveImageDpr = 1;
 
     // 连接缩放器信号与槽
     QObject::connect(&zoomer, &Zoomer::unzoomed, this, &Plot::unzoomed);
@@ -50,6 +62,14 @@ Plot::Plot(QWidget* parent) :
             [this](QwtPlotItem *plotItem, bool on)
             {
                 if (symbolSize) updateSymbols();
+                invalidateStaticLayers();
+            });
+
+    // 曲线标题、颜色或图例属性变化时，图例需要重新绘制
+    connect(this, &QwtPlot::legendDataChanged,
+            [this](const QVariant&, const QList<QwtLegendData>&)
+            {
+                invalidateStaticLayers();
             });
 
     // 初始化“DEMO运行”标识
@@ -143,6 +163,7 @@ void Plot::showGrid(bool show)
 {
     grid.enableX(show);  // 启用或禁用 X 轴网格
     grid.enableY(show);  // 启用或禁用 Y 轴网格
+    invalidateStaticLayers();
     replot();  // 重新绘制图表
 }
 
@@ -151,6 +172,7 @@ void Plot::showMinorGrid(bool show)
 {
     grid.enableXMin(show);  // 启用或禁用 X 轴辅助网格
     grid.enableYMin(show);  // 启用或禁用 Y 轴辅助网格
+    invalidateStaticLayers();
     replot();  // 重新绘制图表
 }
 
@@ -158,6 +180,7 @@ void Plot::showMinorGrid(bool show)
 void Plot::showLegend(bool show)
 {
     legend.setVisible(show);  // 设置图例可见性
+    invalidateStaticLayers();
     replot();  // 重新绘制图表
 }
 
@@ -165,6 +188,7 @@ void Plot::showLegend(bool show)
 void Plot::showDemoIndicator(bool show)
 {
     demoIndicator.setVisible(show);  // 设置 DEMO 标识可见性
+    invalidateStaticLayers();
     replot();  // 重新绘制图表
 }
 
@@ -172,6 +196,7 @@ void Plot::showDemoIndicator(bool show)
 void Plot::showNoChannel(bool show)
 {
     noChannelIndicator.setVisible(show);  // 设置无可见通道标识可见性
+    invalidateStaticLayers();
     replot();  // 重新绘制图表
 }
 
@@ -216,6 +241,7 @@ void Plot::darkBackground(bool enabled)
         legend.setTextPen(QPen(Qt::black));  // 设置图例的文本颜色
     }
     updateSymbols();  // 更新符号
+    invalidateStaticLayers();
     replot();  // 重新绘制图表
 }
 
@@ -268,6 +294,7 @@ void Plot::setSymbols(ShowSymbols shown)
 void Plot::setLegendPosition(Qt::AlignmentFlag alignment)
 {
     legend.setAlignment(alignment);  // 设置图例的位置
+    invalidateStaticLayers();
     replot();  // 重新绘制图表
 }
 
@@ -348,3 +375,339 @@ void Plot::setPlotWidth(double width)
     plotWidth = width;  // 设置绘图宽度
     zoomer.setHViewSize(width);  // 设置水平视图的大小
 }
+
+// 比较两个刻度映射是否相同
+static bool isSameMap(const QwtScaleMap& a, const QwtScaleMap& b)
+{
+    return a.s1() == b.s1() && a.s2() == b.s2() &&
+        a.p1() == b.p1() && a.p2() == b.p2();
+}
+
+// 启用或禁用滚动（增量）绘制模式
+void Plot::setRollMode(bool enabled)
+{
+    rollMode = enabled;
+    rollLayer = QPixmap();  // 释放曲线缓存
+    replot();
+}
+
+// 完整重绘，曲线缓存将在绘制时重新生成
+void Plot::replot()
+{
+    rollLayerValid = false;
+    curveImageReady = false;  // 离屏图像可能已过时
+    QwtPlot::replot();
+}
+
+// 准备离屏绘制曲线，坐标轴计算需要在 GUI 线程中完成
+bool Plot::prepareCurveImage()
+{
+    curveImageReady = false;
+    if (rollMode) return false;
+
+    // QwtSymbol 使用 QPixmap 缓存符号，只能在 GUI 线程中绘制；PlotCurve
+    // 使用 QImage 缓存符号，可以在工作线程中绘制
+    for (auto item : itemList(QwtPlotItem::Rtti_PlotCurve))
+    {
+        if (item->isVisible() &&
+            static_cast<QwtPlotCurve*>(item)->symbol() != nullptr &&
+            dynamic_cast<PlotCurve*>(item) == nullptr)
+        {
+            return false;
+        }
+    }
+
+    updateAxes();
+    curveImageRect = canvas()->contentsRect();
+    if (curveImageRect.isEmpty()) return false;
+
+    curveImageDpr = canvas()->devicePixelRatio();
+    curveImageXMap = canvasMap(QwtPlot::xBottom);
+    curveImageYMap = canvasMap(QwtPlot::yLeft);
+    return true;
+}
+
+// 将曲线绘制到离屏图像中，可在工作线程中调用（QImage 可在非 GUI 线程中绘制）
+void Plot::renderCurveImage()
+{
+    const QSize size = curveImageRect.size() * curveImageDpr;
+    if (curveImage.size() != size)
+    {
+        curveImage = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        curveImage.setDevicePixelRatio(curveImageDpr);
+    }
+    curveImage.fill(Qt::transparent);
+
+    QPainter painter(&curveImage);
+    painter.translate(-curveImageRect.topLeft());
+    for (auto item : itemList(QwtPlotItem::Rtti_PlotCurve))
+    {
+        if (!item->isVisible()) continue;
+
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing,
+                              item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        item->draw(&painter, curveImageXMap, curveImageYMap, curveImageRect);
+        painter.restore();
+    }
+    painter.end();
+
+    curveImageReady = true;
+}
+
+// 使用离屏图像重绘
+void Plot::replotCurveImage()
+{
+    rollLayerValid = false;
+    QwtPlot::replot();
+}
+
+// 添加新样本后的增量重绘
+void Plot::rollReplot(unsigned numNewSamples)
+{
+    // 缩放状态下新样本不一定在视图中，进行完整重绘
+    if (!rollMode || !rollLayerValid || zoomer.zoomRectIndex() != 0 ||
+        numNewSamples == 0)
+    {
+        replot();
+        return;
+    }
+
+    // 自动缩放时 Y 轴范围可能随新数据变化，刻度变化时需要完整重绘
+    updateAxes();
+    const QwtScaleMap xMap = canvasMap(QwtPlot::xBottom);
+    const QwtScaleMap yMap = canvasMap(QwtPlot::yLeft);
+    const QRect cr = canvas()->contentsRect();
+    if (!isSameMap(xMap, rollXMap) || !isSameMap(yMap, rollYMap) ||
+        rollLayer.size() != cr.size() * canvas()->devicePixelRatio())
+    {
+        replot();
+        return;
+    }
+
+    // 找到第一条可见曲线，用于计算新样本对应的像素位移
+    const QwtPlotItemList curves = itemList(QwtPlotItem::Rtti_PlotCurve);
+    const QwtPlotCurve* refCurve = nullptr;
+    for (auto item : curves)
+    {
+        if (item->isVisible())
+        {
+            refCurve = static_cast<const QwtPlotCurve*>(item);
+            break;
+        }
+    }
+    if (refCurve == nullptr) return; // 没有可见曲线，无需绘制
+
+    if (numNewSamples + 1 >= refCurve->dataSize())
+    {
+        replot();
+        return;
+    }
+
+    // 位移的小数部分累积到下一次，避免误差累积
+    rollResidual += xMap.transform(refCurve->sample(numNewSamples).x()) -
+        xMap.transform(refCurve->sample(0).x());
+    int shift = qRound(rollResidual);
+    rollResidual -= shift;
+
+    if (shift < 0 || shift >= cr.width())
+    {
+        replot();
+        return;
+    }
+
+    // 将缓存图像左移
+    if (shift > 0)
+    {
+        const int dpr = canvas()->devicePixelRatio();
+        rollLayer.scroll(-shift * dpr, 0, rollLayer.rect());
+    }
+
+    QPainter painter(&rollLayer);
+
+    // 清除左移后露出的区域
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(QRectF(cr.width() - shift, 0, shift, cr.height()), Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.translate(-cr.topLeft());
+
+    // 只绘制最新的线段，包含前一个点以便与已有线段相连
+    for (auto item : curves)
+    {
+        if (!item->isVisible()) continue;
+
+        auto curve = static_cast<QwtPlotCurve*>(item);
+        int to = curve->dataSize() - 1;
+        int from = std::max(0, to - int(numNewSamples) - 1);
+
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing,
+                              curve->testRenderHint(QwtPlotItem::RenderAntialiased));
+        curve->drawSeries(&painter, xMap, yMap, cr, from, to);
+        painter.restore();
+    }
+    painter.end();
+
+    // 只刷新画布，不重新计算坐标轴
+    auto plotCanvas = qobject_cast<QwtPlotCanvas*>(canvas());
+    if (plotCanvas != nullptr) plotCanvas->invalidateBackingStore();
+    canvas()->update();
+}
+
+// 标记画布正在绘制，导出（QwtPlotRenderer）时不使用曲线缓存
+void Plot::drawCanvas(QPainter* painter)
+{
+    inCanvasPaint = true;
+    QwtPlot::drawCanvas(painter);
+    inCanvasPaint = false;
+}
+
+// 标记静态图层需要在下次绘制时重新生成
+void Plot::invalidateStaticLayers()
+{
+    staticLayersValid = false;
+}
+
+// 绘制所有绘图项。网格、图例等静态项从缓存图层绘制，只有刻度、尺寸或样式
+// 变化时才重新生成；数据变化时只绘制曲线（滚动模式下曲线也来自缓存图像）
+void Plot::drawItems(QPainter* painter, const QRectF& canvasRect,
+                     const QwtScaleMap maps[axisCnt]) const
+{
+    // 导出（QwtPlotRenderer）时不使用缓存
+    if (!inCanvasPaint)
+    {
+        QwtPlot::drawItems(painter, canvasRect, maps);
+        return;
+    }
+
+    const QwtScaleMap& xMap = maps[QwtPlot::xBottom];
+    const QwtScaleMap& yMap = maps[QwtPlot::yLeft];
+    const QSize layerSize = canvasRect.size().toSize() * canvas()->devicePixelRatio();
+
+    if (!staticLayersValid || underLayer.size() != layerSize ||
+        !isSameMap(xMap, staticXMap) || !isSameMap(yMap, staticYMap) ||
+        axisScaleDiv(QwtPlot::xBottom) != staticXDiv ||
+        axisScaleDiv(QwtPlot::yLeft) != staticYDiv)
+    {
+        renderStaticLayers(canvasRect, maps);
+    }
+
+    painter->drawPixmap(canvasRect.topLeft(), underLayer);
+
+    if (rollMode)
+    {
+        if (!rollLayerValid || rollLayer.size() != layerSize ||
+            !isSameMap(xMap, rollXMap) || !isSameMap(yMap, rollYMap))
+        {
+            renderRollLayer(canvasRect, maps);
+        }
+        painter->drawPixmap(canvasRect.topLeft(), rollLayer);
+    }
+    else if (curveImageReady && QRectF(curveImageRect) == canvasRect &&
+             isSameMap(xMap, curveImageXMap) && isSameMap(yMap, curveImageYMap))
+    {
+        // 离屏图像只使用一次，之后的绘制（如窗口重绘）直接绘制曲线
+        painter->drawImage(canvasRect.topLeft(), curveImage);
+        curveImageReady = false;
+    }
+    else
+    {
+        for (auto item : itemList(QwtPlotItem::Rtti_PlotCurve))
+        {
+            if (!item->isVisible()) continue;
+
+            painter->save();
+            painter->setRenderHint(QPainter::Antialiasing,
+                                   item->testRenderHint(QwtPlotItem::RenderAntialiased));
+            item->draw(painter, maps[item->xAxis()], maps[item->yAxis()], canvasRect);
+            painter->restore();
+        }
+    }
+
+    if (!overLayer.isNull())
+    {
+        painter->drawPixmap(canvasRect.topLeft(), overLayer);
+    }
+}
+
+// 重新生成曲线缓存图像
+void Plot::renderRollLayer(const QRectF& canvasRect,
+                           const QwtScaleMap maps[axisCnt]) const
+{
+    renderLayer(rollLayer, itemList(QwtPlotItem::Rtti_PlotCurve), canvasRect, maps);
+
+    rollXMap = maps[QwtPlot::xBottom];
+    rollYMap = maps[QwtPlot::yLeft];
+    rollResidual = 0;
+    rollLayerValid = true;
+}
+
+// 重新生成静态图层，z 值低于曲线的项（网格）绘制在曲线下方，其余（图例、
+// 标识）绘制在曲线上方
+void Plot::renderStaticLayers(const QRectF& canvasRect,
+                              const QwtScaleMap maps[axisCnt]) const
+{
+    const QwtPlotItemList curves = itemList(QwtPlotItem::Rtti_PlotCurve);
+    double curveZ = curves.isEmpty() ? std::numeric_limits<double>::max() :
+        curves.first()->z();
+    for (auto curve : curves) curveZ = std::min(curveZ, curve->z());
+
+    QwtPlotItemList underItems, overItems;
+    for (auto item : itemList()) // 已按 z 值排序
+    {
+        if (item->rtti() == QwtPlotItem::Rtti_PlotCurve) continue;
+
+        if (item->z() < curveZ)
+        {
+            underItems << item;
+        }
+        else
+        {
+            overItems << item;
+        }
+    }
+
+    renderLayer(underLayer, underItems, canvasRect, maps);
+    if (overItems.isEmpty())
+    {
+        overLayer = QPixmap();
+    }
+    else
+    {
+        renderLayer(overLayer, overItems, canvasRect, maps);
+    }
+
+    staticXMap = maps[QwtPlot::xBottom];
+    staticYMap = maps[QwtPlot::yLeft];
+    staticXDiv = axisScaleDiv(QwtPlot::xBottom);
+    staticYDiv = axisScaleDiv(QwtPlot::yLeft);
+    staticLayersValid = true;
+}
+
+// 将给定的绘图项绘制到与画布同尺寸的透明图像中
+void Plot::renderLayer(QPixmap& layer, const QwtPlotItemList& items,
+                       const QRectF& canvasRect,
+                       const QwtScaleMap maps[axisCnt]) const
+{
+    const int dpr = canvas()->devicePixelRatio();
+    const QSize layerSize = canvasRect.size().toSize() * dpr;
+    if (layer.size() != layerSize)
+    {
+        layer = QPixmap(layerSize);
+        layer.setDevicePixelRatio(dpr);
+    }
+    layer.fill(Qt::transparent);
+
+    QPainter painter(&layer);
+    painter.translate(-canvasRect.topLeft());
+    for (auto item : items)
+    {
+        if (!item->isVisible()) continue;
+
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing,
+                              item->testRenderHint(QwtPlotItem::RenderAntialiased));
+        item->draw(&painter, maps[item->xAxis()], maps[item->yAxis()], canvasRect);
+        painter.restore();
+    }
+}
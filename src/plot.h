@@ -23,7 +23,11 @@
 #include <QColor>
 #include <QList>
 #include <QAction>
+#include <QPixmap>
+#include <QImage>
 #include <qwt_plot.h>
+#include <qwt_scale_map.h>
+#include <qwt_scale_div.h>
 #include <qwt_plot_grid.h>
 #include <qwt_plot_shapeitem.h>
 #include <qwt_plot_legenditem.h>
@@ -53,6 +57,37 @@ public:
     /// Set displayed channels for value tracking (can be null)
     void setDispChannels(QVector<const StreamChannel*> channels);
 
+    /**
+     * Updates the plot after `numNewSamples` are added to the curves.
+     *
+     * In roll mode cached curve image is shifted and only the newest
+     * segments are drawn. Falls back to a full `replot()` when this
+     * isn't possible (zoomed, scale changed etc.).
+     */
+    void rollReplot(unsigned numNewSamples);
+
+    /**
+     * Prepares the plot for `renderCurveImage()`, updates axes and
+     * stores the canvas geometry. Must be called from GUI thread.
+     *
+     * @return `false` if curves can't be rendered off-screen (roll
+     * mode, `QwtSymbol`s shown on non `PlotCurve` curves, empty canvas)
+     */
+    bool prepareCurveImage();
+
+    /**
+     * Renders curves into an off-screen image to be composited by
+     * next `replotCurveImage()`. Can be called from a worker thread as
+     * long as plot and curve data isn't modified until it returns.
+     */
+    void renderCurveImage();
+
+    /// Replots using the image rendered by `renderCurveImage()` for curves
+    void replotCurveImage();
+
+    // re-implemented from QwtPlot
+    void drawCanvas(QPainter* painter) override;
+
 public slots:
     void showGrid(bool show = true);
     void showMinorGrid(bool show = true);
@@ -77,10 +112,21 @@ public slots:
 
     void setPlotWidth(double width);
 
+    /// Enable/disable incremental (roll mode) painting of curves
+    void setRollMode(bool enabled);
+
+    /// Full replot, invalidates the roll mode curve cache
+    void replot() override;
+
 protected:
     /// update the display of symbols depending on `symbolSize`
     void updateSymbols();
 
+    /// Draws static items from cached layers and curves on top of
+    /// them (from roll mode cache when enabled)
+    void drawItems(QPainter* painter, const QRectF& canvasRect,
+                   const QwtScaleMap maps[axisCnt]) const override;
+
 private:
     bool isAutoScaled;
     double yMin, yMax;
@@ -97,6 +143,45 @@ private:
     QwtPlotTextLabel noChannelIndicator;
     ShowSymbols showSymbols;
 
+    bool rollMode;
+    bool inCanvasPaint;               ///< `drawCanvas` is in progress
+    mutable bool rollLayerValid;      ///< `rollLayer` can be shifted
+    mutable QPixmap rollLayer;        ///< cached image of curves
+    mutable QwtScaleMap rollXMap;     ///< X map `rollLayer` is drawn with
+    mutable QwtScaleMap rollYMap;     ///< Y map `rollLayer` is drawn with
+    mutable double rollResidual;      ///< sub-pixel shift not yet applied
+
+    mutable bool curveImageReady;     ///< `curveImage` can be composited at next paint
+    QImage curveImage;                ///< curves rendered by `renderCurveImage()`
+    QRect curveImageRect;             ///< canvas rect `curveImage` is rendered for
+    int curveImageDpr;                ///< device pixel ratio of `curveImage`
+    QwtScaleMap curveImageXMap;       ///< X map `curveImage` is rendered with
+    QwtScaleMap curveImageYMap;       ///< Y map `curveImage` is rendered with
+
+    mutable bool staticLayersValid;   ///< `underLayer` and `overLayer` are up to date
+    mutable QPixmap underLayer;       ///< items drawn below curves (grid)
+    mutable QPixmap overLayer;        ///< items drawn above curves (legend, indicators)
+    mutable QwtScaleMap staticXMap;   ///< X map static layers are drawn with
+    mutable QwtScaleMap staticYMap;   ///< Y map static layers are drawn with
+    mutable QwtScaleDiv staticXDiv;   ///< X scale div static layers are drawn with
+    mutable QwtScaleDiv staticYDiv;   ///< Y scale div static layers are drawn with
+
+    /// Draws all visible curves into `rollLayer` from scratch
+    void renderRollLayer(const QRectF& canvasRect,
+                         const QwtScaleMap maps[axisCnt]) const;
+
+    /// Draws all visible non-curve items into `underLayer` and `overLayer`
+    void renderStaticLayers(const QRectF& canvasRect,
+                            const QwtScaleMap maps[axisCnt]) const;
+
+    /// Draws `items` into a transparent `layer` of canvas size
+    void renderLayer(QPixmap& layer, const QwtPlotItemList& items,
+                     const QRectF& canvasRect,
+                     const QwtScaleMap maps[axisCnt]) const;
+
+    /// Marks static layers to be redrawn at next paint, call on style changes
+    void invalidateStaticLayers();
+
     void resetAxes();
     void resizeEvent(QResizeEvent * event);
     void calcSymbolSize();
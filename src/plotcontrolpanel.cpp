@@ -22,12 +22,14 @@
 #include <QCheckBox>
 #include <QStyledItemDelegate>
 #include <QColorDialog>
+#include <QInputDialog>
 
 #include <math.h>
 
 #include "plotcontrolpanel.h"
 #include "ui_plotcontrolpanel.h"
 #include "setting_defines.h"
+#include "expression.h"
 
 /// Confirm if #samples is being set to a value greater than this
 const int NUMSAMPLES_CONFIRM_AT = 1000000;
@@ -72,6 +74,7 @@ PlotControlPanel::PlotControlPanel(QWidget *parent) :
     hideAllAct(tr("Hide All"), this),
     resetGainsAct(tr("Reset All Gain"), this),
     resetOffsetsAct(tr("Reset All Offset"), this),
+    resetCalibrationsAct(tr("Reset All Calibration"), this),
     resetMenu(tr("Reset Menu"), this)
 {
     ui->setupUi(this);
@@ -79,6 +82,7 @@ PlotControlPanel::PlotControlPanel(QWidget *parent) :
     delegate = new SpinBoxDelegate();
     ui->tvChannelInfo->setItemDelegate(delegate);
 
+    _infoModel = NULL;
     warnNumOfSamples = true;    // TODO: load from settings
     _numOfSamples = ui->spNumOfSamples->value();
 
@@ -178,6 +182,7 @@ PlotControlPanel::PlotControlPanel(QWidget *parent) :
     resetMenu.addAction(&resetColorsAct);
     resetMenu.addAction(&resetGainsAct);
     resetMenu.addAction(&resetOffsetsAct);
+    resetMenu.addAction(&resetCalibrationsAct);
     resetAct.setMenu(&resetMenu);
     ui->tbReset->setDefaultAction(&resetAct);
 
@@ -185,6 +190,9 @@ PlotControlPanel::PlotControlPanel(QWidget *parent) :
     hideAllAct.setToolTip(tr("Hide all channels"));
     ui->tbShowAll->setDefaultAction(&showAllAct);
     ui->tbHideAll->setDefaultAction(&hideAllAct);
+
+    // math channels
+    connect(ui->tbMath, &QToolButton::clicked, this, &PlotControlPanel::onMathChannels);
 }
 
 PlotControlPanel::~PlotControlPanel()
@@ -285,6 +293,56 @@ void PlotControlPanel::onColorSelect()
     }
 }
 
+// 编辑数学（派生）通道表达式，每行一个表达式
+void PlotControlPanel::onMathChannels()
+{
+    if (_infoModel == NULL) return;
+
+    QStringList oldExprs = _infoModel->expressions();
+    bool ok;
+    QString text = QInputDialog::getMultiLineText(
+        this, tr("Math Channels"),
+        tr("Enter one expression per line, ex: \"ch1 - ch2\", \"sqrt(ch1^2 + ch2^2)\".\n"
+           "Each expression is appended as a new channel."),
+        oldExprs.join("\n"), &ok);
+    if (!ok) return;
+
+    QStringList exprs;
+    for (auto line : text.split('\n'))
+    {
+        line = line.trimmed();
+        if (!line.isEmpty()) exprs.append(line);
+    }
+
+    // 派生通道位于输入通道之后，只能引用输入通道
+    unsigned numInputs = _infoModel->rowCount() - oldExprs.size();
+    for (auto& expr : exprs)
+    {
+        Expression e;
+        QString error;
+        if (!e.compile(expr, numInputs, &error))
+        {
+            QMessageBox::critical(this, tr("Invalid Expression"),
+                                  tr("\"%1\": %2").arg(expr).arg(error));
+            return;
+        }
+    }
+
+    // 通道数随表达式改变（同步更新）
+    _infoModel->setExpressions(exprs);
+
+    // 以表达式命名新的或改变的派生通道
+    unsigned first = _infoModel->rowCount() - exprs.size();
+    for (int i = 0; i < exprs.size(); i++)
+    {
+        if (i >= oldExprs.size() || oldExprs[i] != exprs[i])
+        {
+            _infoModel->setData(_infoModel->index(first + i, ChannelInfoModel::COLUMN_NAME),
+                                exprs[i], Qt::EditRole);
+        }
+    }
+}
+
 // 当自动缩放选项被选中或取消时触发
 void PlotControlPanel::onAutoScaleChecked(bool checked)
 {
@@ -427,6 +485,7 @@ void PlotControlPanel::onPlotWidthChanged()
 // 设置通道信息模型
 void PlotControlPanel::setChannelInfoModel(ChannelInfoModel* model)
 {
+    _infoModel = model;
     ui->tvChannelInfo->setModel(model);
 
     // 连接选择模型的信号与槽，用于更新颜色选择器
@@ -479,6 +538,7 @@ void PlotControlPanel::setChannelInfoModel(ChannelInfoModel* model)
     connect(&resetColorsAct, &QAction::triggered, model, &ChannelInfoModel::resetColors);
     connect(&resetGainsAct, &QAction::triggered, model, &ChannelInfoModel::resetGains);
     connect(&resetOffsetsAct, &QAction::triggered, model, &ChannelInfoModel::resetOffsets);
+    connect(&resetCalibrationsAct, &QAction::triggered, model, &ChannelInfoModel::resetCalibrations);
     connect(&showAllAct, &QAction::triggered, [model]{model->resetVisibility(true);});
     connect(&hideAllAct, &QAction::triggered, [model]{model->resetVisibility(false);});
 }
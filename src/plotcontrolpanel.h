@@ -73,9 +73,10 @@ private:
     bool warnNumOfSamples;
 
     QAction resetAct, resetNamesAct, resetColorsAct, showAllAct,
-        hideAllAct, resetGainsAct, resetOffsetsAct;
+        hideAllAct, resetGainsAct, resetOffsetsAct, resetCalibrationsAct;
     QMenu resetMenu;
     QStyledItemDelegate* delegate;
+    ChannelInfoModel* _infoModel;
 
     /// Show a confirmation dialog before setting #samples to a big value
     bool askNSConfirmation(int value);
@@ -92,6 +93,7 @@ private slots:
     void onXScaleChanged();
     void onPlotWidthChanged();
     void onColorSelect();
+    void onMathChannels();
 };
 
 #endif // PLOTCONTROLPANEL_H
@@ -0,0 +1,113 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QPainter>
+#include <QPaintEngine>
+#include <qwt_scale_map.h>
+#include <math.h>
+#include <algorithm>
+#include <limits>
+
+#include "plotcurve.h"
+
+PlotCurve::PlotCurve(const QString& title) :
+    QwtPlotCurve(title)
+{
+    symbolStyle = QwtSymbol::NoSymbol;
+}
+
+void PlotCurve::drawSymbols(QPainter* painter, const QwtSymbol& symbol,
+                            const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                            const QRectF& canvasRect, int from, int to) const
+{
+    // 矢量输出（如 SVG 导出）使用 Qwt 的符号绘制
+    if (painter->paintEngine()->type() != QPaintEngine::Raster ||
+        painter->transform().isScaling())
+    {
+        QwtPlotCurve::drawSymbols(painter, symbol, xMap, yMap, canvasRect, from, to);
+        return;
+    }
+
+    const int dpr = painter->device()->devicePixelRatio();
+    updateSymbolImage(symbol, dpr);
+    if (symbolImage.isNull()) return;
+
+    // 符号部分可见的点也需要绘制
+    const QRectF clipRect = canvasRect.adjusted(-symbolRect.right(), -symbolRect.bottom(),
+                                                -symbolRect.left(), -symbolRect.top());
+
+    // 与上一个已绘制符号的距离小于符号尺寸时会重叠，跳过
+    const double minDx = std::max(1, symbol.size().width());
+    const double minDy = std::max(1, symbol.size().height());
+    double lastX = -std::numeric_limits<double>::max();
+    double lastY = -std::numeric_limits<double>::max();
+
+    for (int i = from; i <= to; i++)
+    {
+        const QPointF s = sample(i);
+        const double x = xMap.transform(s.x());
+        const double y = yMap.transform(s.y());
+
+        // 只绘制画布内的点
+        if (!clipRect.contains(x, y)) continue;
+
+        if (fabs(x - lastX) < minDx && fabs(y - lastY) < minDy) continue;
+        lastX = x;
+        lastY = y;
+
+        painter->drawImage(QPointF(round(x) + symbolRect.left(),
+                                   round(y) + symbolRect.top()), symbolImage);
+    }
+}
+
+void PlotCurve::updateSymbolImage(const QwtSymbol& symbol, int dpr) const
+{
+    if (!symbolImage.isNull() && symbolImage.devicePixelRatio() == dpr &&
+        symbol.style() == symbolStyle && symbol.size() == symbolSize &&
+        symbol.pen() == symbolPen && symbol.brush() == symbolBrush)
+    {
+        return;
+    }
+
+    symbolStyle = symbol.style();
+    symbolSize = symbol.size();
+    symbolPen = symbol.pen();
+    symbolBrush = symbol.brush();
+
+    symbolRect = symbol.boundingRect();
+    if (symbolRect.isEmpty())
+    {
+        symbolImage = QImage();
+        return;
+    }
+
+    symbolImage = QImage(symbolRect.size() * dpr, QImage::Format_ARGB32_Premultiplied);
+    symbolImage.setDevicePixelRatio(dpr);
+    symbolImage.fill(Qt::transparent);
+
+    // 使用不带缓存的符号绘制，QwtSymbol 的缓存是 QPixmap，只能在 GUI 线程中使用
+    QwtSymbol uncached(symbolStyle, symbolBrush, symbolPen, symbolSize);
+    uncached.setCachePolicy(QwtSymbol::NoCache);
+
+    QPainter painter(&symbolImage);
+    painter.setRenderHint(QPainter::Antialiasing,
+                          testRenderHint(QwtPlotItem::RenderAntialiased));
+    painter.translate(-symbolRect.topLeft());
+    uncached.drawSymbol(&painter, QPointF(0, 0));
+}
@@ -0,0 +1,64 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PLOTCURVE_H
+#define PLOTCURVE_H
+
+#include <QImage>
+#include <QPen>
+#include <QBrush>
+#include <qwt_plot_curve.h>
+#include <qwt_symbol.h>
+
+/**
+ * Curve with a faster symbol renderer.
+ *
+ * Instead of drawing a `QwtSymbol` for each point, symbol is rendered
+ * once into an image (re-rendered only when symbol style or color
+ * changes) and this image is blitted for each point that is inside
+ * the canvas. Symbols that would overlap the previously drawn symbol
+ * are skipped, so that zoomed views of dense data stay interactive.
+ *
+ * Unlike `QwtSymbol` pixmap cache, the image can be drawn from a
+ * worker thread. Vector outputs (SVG export etc.) still get the
+ * regular `QwtSymbol` drawing.
+ */
+class PlotCurve : public QwtPlotCurve
+{
+public:
+    explicit PlotCurve(const QString& title = QString());
+
+protected:
+    void drawSymbols(QPainter* painter, const QwtSymbol& symbol,
+                     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                     const QRectF& canvasRect, int from, int to) const override;
+
+private:
+    mutable QImage symbolImage;    ///< cached symbol image
+    mutable QRect symbolRect;      ///< `symbolImage` rect relative to the point
+    mutable QwtSymbol::Style symbolStyle;
+    mutable QSize symbolSize;
+    mutable QPen symbolPen;
+    mutable QBrush symbolBrush;
+
+    /// Re-renders `symbolImage` if given symbol is different than the cached one
+    void updateSymbolImage(const QwtSymbol& symbol, int dpr) const;
+};
+
+#endif // PLOTCURVE_H
@@ -1,11 +1,15 @@
 #include <algorithm>         // 引入标准库算法操作，如std::none_of
 #include <QMetaEnum>         // 用于处理Qt的枚举类型
 #include <QSvgGenerator>     // 用于生成SVG格式的文件
+#include <QThread>           // 用于获取处理器核心数量
+#include <QtConcurrent>      // 多图模式下并行绘制曲线
+#include <QScrollBar>        // 多图模式下滚动时重绘新显示的图
 #include <qwt_symbol.h>      // Qwt库中的绘图符号支持
 #include <qwt_plot_renderer.h> // Qwt库中的绘图渲染支持
 
 #include "plot.h"            // 包含绘图组件的定义
 #include "plotmanager.h"     // 当前类的定义
+#include "plotcurve.h"       // 带有快速符号绘制的曲线
 #include "utils.h"           // 一些通用工具方法
 #include "setting_defines.h" // 全局设置的定义
 
@@ -32,7 +36,8 @@ PlotManager::PlotManager(QWidget* plotArea, PlotMenu* menu,
 
     // 监听流的通道数量变化，更新绘图
     connect(stream, &Stream::numChannelsChanged, this, &PlotManager::onNumChannelsChanged);
-    connect(stream, &Stream::dataAdded, this, &PlotManager::replot); // 数据更新时重绘
+    connect(stream, &Stream::dataAdded, this, &PlotManager::onDataAdded); // 数据更新时重绘
+    lastTotalSamples = stream->totalSamples();
 
     // 添加流的所有初始曲线
     for (unsigned int i = 0; i < stream->numChannels(); i++)
@@ -88,6 +93,8 @@ void PlotManager::construct(QWidget* plotArea, PlotMenu* menu)
     emptyPlot = NULL;          // 空绘图指针初始化为NULL
     inScaleSync = false;       // 默认不同步刻度
     lineThickness = 1;         // 初始线条粗细为1
+    rollMode = false;          // 默认关闭滚动绘制模式
+    lastTotalSamples = 0;
 
     // 初始化布局为单绘图模式
     isMulti = false;
@@ -107,6 +114,8 @@ void PlotManager::construct(QWidget* plotArea, PlotMenu* menu)
             this, &PlotManager::setMulti);
     connect(&menu->unzoomAction, &QAction::triggered,
             this, &PlotManager::unzoom);
+    connect(&menu->rollModeAction, SELECT<bool>::OVERLOAD_OF(&QAction::toggled),
+            this, &PlotManager::setRollMode);
 
     connect(&menu->showLegendAction, SELECT<bool>::OVERLOAD_OF(&QAction::toggled),
             this, &PlotManager::showLegend);
@@ -119,6 +128,7 @@ void PlotManager::construct(QWidget* plotArea, PlotMenu* menu)
     showLegend(menu->showLegendAction.isChecked());
     setLegendPosition(menu->legendPosition());
     setMulti(menu->showMultiAction.isChecked());
+    setRollMode(menu->rollModeAction.isChecked());
 }
 
 
@@ -173,6 +183,9 @@ void PlotManager::onChannelInfoChanged(const QModelIndex &topLeft,
                                        const QModelIndex &bottomRight,
                                        const QVector<int> &roles)
 {
+    // 统计列的更新与曲线无关，忽略以免频繁重绘
+    if (ChannelInfoModel::isStatsColumn(topLeft.column())) return;
+
     int start = topLeft.row(); // 变化范围的开始行索引
     int end = bottomRight.row(); // 变化范围的结束行索引
 
@@ -246,6 +259,8 @@ void PlotManager::setMulti(bool enabled)
     {
         delete plotWidgets.takeLast(); // 删除列表中最后一个小部件
     }
+    outOfViewPlots.clear();
+    axisExtents.clear();
 
     // 设置新的布局
     setupLayout(isMulti);
@@ -316,6 +331,11 @@ void PlotManager::setupLayout(bool multiPlot)
         _plotArea->layout()->setContentsMargins(0, 0, 0, 0); // 设置边距为0
 
         layout = new QVBoxLayout(scrolledPlotArea); // 设置滚动区域内部布局
+
+        // 滚动到视图中的图如果之前被跳过，需要重绘
+        auto scrollBar = scrollArea->verticalScrollBar();
+        connect(scrollBar, &QScrollBar::valueChanged, this, &PlotManager::replotExposed);
+        connect(scrollBar, &QScrollBar::rangeChanged, this, &PlotManager::replotExposed);
     }
     else
     {
@@ -348,6 +368,7 @@ Plot* PlotManager::addPlotWidget()
     plot->showLegend(_menu->showLegendAction.isChecked());
     plot->setLegendPosition(_menu->legendPosition());
     plot->setSymbols(_menu->showSymbols());
+    plot->setRollMode(rollMode);
 
     plot->showDemoIndicator(isDemoShown); // 显示演示指示器
     plot->setYAxis(_autoScaled, _yMin, _yMax);
@@ -383,6 +404,13 @@ void PlotManager::syncScales()
     // 设置同步状态为正在进行
     inScaleSync = true;
 
+    // 记录之前的刻度宽度，用于判断是否需要重绘
+    QVector<double> prevExtents;
+    for (auto plot : plotWidgets)
+    {
+        prevExtents.append(plot->axisWidget(QwtPlot::yLeft)->scaleDraw()->minimumExtent());
+    }
+
     // 查找最大刻度
     double maxExtent = 0;
     for (auto plot : plotWidgets)
@@ -392,27 +420,49 @@ void PlotManager::syncScales()
 
         // 获取Y轴刻度组件
         QwtScaleWidget* scaleWidget = plot->axisWidget(QwtPlot::yLeft);
-        QwtScaleDraw* scaleDraw = scaleWidget->scaleDraw();
-        scaleDraw->setMinimumExtent(0);
+        const QwtScaleDiv& scaleDiv = plot->axisScaleDiv(QwtPlot::yLeft);
 
-        // 获取刻度的大小
-        const double extent = scaleDraw->extent(scaleWidget->font());
-        if (extent > maxExtent)
-            maxExtent = extent;
+        // 测量刻度大小需要计算所有刻度标签的尺寸，只在刻度变化时重新计算
+        auto it = axisExtents.find(plot);
+        if (it == axisExtents.end() || it->scaleDiv != scaleDiv)
+        {
+            QwtScaleDraw* scaleDraw = scaleWidget->scaleDraw();
+            const double minExtent = scaleDraw->minimumExtent();
+            scaleDraw->setMinimumExtent(0);
+            it = axisExtents.insert(plot, {scaleDiv, scaleDraw->extent(scaleWidget->font())});
+            scaleDraw->setMinimumExtent(minExtent);
+        }
+
+        if (it->extent > maxExtent)
+            maxExtent = it->extent;
     }
 
-    // 应用最大刻度到所有图窗口
-    for (auto plot : plotWidgets)
+    // 应用最大刻度到所有图窗口，刻度宽度未变化的图不需要重新布局
+    bool extentChanged = false;
+    for (int i = 0; i < plotWidgets.size(); i++)
     {
-        QwtScaleWidget* scaleWidget = plot->axisWidget(QwtPlot::yLeft);
+        if (prevExtents[i] == maxExtent) continue;
+        extentChanged = true;
+
+        QwtScaleWidget* scaleWidget = plotWidgets[i]->axisWidget(QwtPlot::yLeft);
         scaleWidget->scaleDraw()->setMinimumExtent(maxExtent);
         scaleWidget->updateGeometry();
     }
 
-    // 重绘所有图窗口
-    for (auto plot : plotWidgets)
+    // 刻度宽度变化时才需要重绘所有图窗口，否则布局不变，之前的绘制仍然有效
+    if (extentChanged)
     {
-        plot->replot();
+        for (auto plot : plotWidgets)
+        {
+            if (isInView(plot))
+            {
+                plot->replot();
+            }
+            else
+            {
+                outOfViewPlots.insert(plot);
+            }
+        }
     }
 
     // 重置同步状态
@@ -423,7 +473,7 @@ void PlotManager::syncScales()
 // 添加曲线
 void PlotManager::addCurve(QString title, const XFrameBuffer* xBuf, const FrameBuffer* yBuf)
 {
-    auto curve = new QwtPlotCurve(title); // 创建一个新的曲线
+    auto curve = new PlotCurve(title); // 创建一个新的曲线
     auto series = new FrameBufferSeries(xBuf, yBuf); // 创建数据系列
     curve->setSamples(series); // 设置样本数据
     _addCurve(curve); // 添加曲线到管理器中
@@ -489,6 +539,7 @@ void PlotManager::removeCurves(unsigned number)
             delete curves.takeLast(); // 删除最后一个曲线
             if (isMulti) // 如果是多图表模式，删除对应的小部件
             {
+                removePlotWidget(plotWidgets.last());
                 delete plotWidgets.takeLast();
             }
         }
@@ -518,13 +569,122 @@ Plot* PlotManager::plotWidget(unsigned curveIndex)
 // 重绘所有图形小部件
 void PlotManager::replot()
 {
+    // 多图模式下各图的曲线在线程池中（每个核心一个线程）并行绘制到离屏
+    // 图像，然后在 GUI 线程中合成
+    QVector<Plot*> offscreenPlots;
+    if (isMulti && QThread::idealThreadCount() > 1)
+    {
+        for (auto plot : plotWidgets)
+        {
+            if (plot->isVisible() && isInView(plot) && plot->prepareCurveImage())
+            {
+                offscreenPlots.append(plot);
+            }
+        }
+    }
+
+    if (offscreenPlots.size() > 1)
+    {
+        QtConcurrent::blockingMap(offscreenPlots,
+                                  [](Plot* plot) { plot->renderCurveImage(); });
+    }
+    else
+    {
+        offscreenPlots.clear();
+    }
+
     for (auto plot : plotWidgets)
     {
-        plot->replot(); // 重绘每个小部件
+        // 滚动到视图外的图不绘制，滚动到视图中时再重绘
+        if (!isInView(plot))
+        {
+            outOfViewPlots.insert(plot);
+            continue;
+        }
+        outOfViewPlots.remove(plot);
+
+        if (offscreenPlots.contains(plot))
+        {
+            plot->replotCurveImage(); // 使用离屏图像重绘
+        }
+        else
+        {
+            plot->replot(); // 重绘每个小部件
+        }
     }
     if (isMulti) syncScales(); // 如果是多图表模式，调用同步坐标轴
 }
 
+// 新数据到达时更新绘图，滚动模式下只绘制新增的样本
+void PlotManager::onDataAdded()
+{
+    quint64 total = _stream->totalSamples();
+    unsigned numNew = total - lastTotalSamples;
+    lastTotalSamples = total;
+
+    if (!rollMode)
+    {
+        replot();
+        return;
+    }
+
+    // 刻度变化时 Plot 会进行完整重绘，多图模式下通过 scaleDivChanged 同步刻度
+    for (auto plot : plotWidgets)
+    {
+        if (!plot->isVisible()) continue;
+
+        if (!isInView(plot))
+        {
+            outOfViewPlots.insert(plot);
+        }
+        else if (outOfViewPlots.remove(plot))
+        {
+            plot->replot(); // 曲线缓存已过时
+        }
+        else
+        {
+            plot->rollReplot(numNew);
+        }
+    }
+}
+
+// 多图模式下，已显示但被滚动到视图外的图不需要绘制
+bool PlotManager::isInView(Plot* plot) const
+{
+    if (!isMulti || !plot->isVisible()) return true;
+    return !plot->visibleRegion().isEmpty();
+}
+
+// 删除图形小部件前清除与其相关的记录
+void PlotManager::removePlotWidget(Plot* plot)
+{
+    outOfViewPlots.remove(plot);
+    axisExtents.remove(plot);
+}
+
+// 重绘之前被跳过、现在滚动到视图中的图
+void PlotManager::replotExposed()
+{
+    for (auto plot : outOfViewPlots.values())
+    {
+        if (isInView(plot))
+        {
+            outOfViewPlots.remove(plot);
+            plot->replot();
+        }
+    }
+}
+
+// 启用或禁用滚动（增量）绘制模式，快照不使用该模式
+void PlotManager::setRollMode(bool enabled)
+{
+    rollMode = enabled && _stream != nullptr;
+    for (auto plot : plotWidgets)
+    {
+        plot->setRollMode(rollMode);
+    }
+}
+
 // 显示或隐藏网格线
 void PlotManager::showGrid(bool show)
 {
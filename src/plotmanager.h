@@ -27,8 +27,11 @@
 #include <QList>
 #include <QSettings>
 #include <QMenu>
+#include <QSet>
+#include <QHash>
 
 #include <qwt_plot_curve.h>
+#include <qwt_scale_div.h>
 #include "plot.h"
 #include "framebufferseries.h"
 #include "stream.h"
@@ -61,6 +64,8 @@ public slots:
     void setMulti(bool enabled);
     /// Update all plot widgets
     void replot();
+    /// Enable/Disable incremental painting of newly added samples
+    void setRollMode(bool enabled);
     /// Enable display of a "DEMO" label on each plot
     void showDemoIndicator(bool show = true);
     /// Set the Y axis
@@ -99,6 +104,17 @@ private:
     Plot::ShowSymbols showSymbols;
     bool inScaleSync; ///< scaleSync is in progress
     int lineThickness;
+    bool rollMode;
+    quint64 lastTotalSamples; ///< `Stream::totalSamples` at last update
+    QSet<Plot*> outOfViewPlots; ///< plots skipped while scrolled out of view
+
+    /// Y axis extent of a plot calculated for a certain scale
+    struct AxisExtent
+    {
+        QwtScaleDiv scaleDiv;
+        double extent;
+    };
+    QHash<Plot*, AxisExtent> axisExtents; ///< cache for `syncScales`
 
     /// Common constructor
     void construct(QWidget* plotArea, PlotMenu* menu);
@@ -112,6 +128,10 @@ private:
     void _addCurve(QwtPlotCurve* curve);
     /// Check and make sure "no visible channels" text is shown
     void checkNoVisChannels();
+    /// Returns `false` if plot is scrolled out of view in multi plot mode
+    bool isInView(Plot* plot) const;
+    /// Forgets a plot widget that is about to be deleted
+    void removePlotWidget(Plot* plot);
 
 private slots:
     void showGrid(bool show = true);
@@ -123,12 +143,16 @@ private slots:
     void setSymbols(Plot::ShowSymbols shown);
 
     void onNumChannelsChanged(unsigned value);
+    /// Called when new data is added to the stream
+    void onDataAdded();
     void onChannelInfoChanged(const QModelIndex & topLeft,
                               const QModelIndex & bottomRight,
                               const QVector<int> & roles = QVector<int> ());
 
     /// Synchronize Y axes to be the same width (so that X axes are in line)
     void syncScales();
+    /// Replots plots that were skipped while out of view and now scrolled into view
+    void replotExposed();
 };
 
 #endif // PLOTMANAGER_H
@@ -32,6 +32,7 @@ PlotMenu::PlotMenu(QWidget* parent) :
     darkBackgroundAction("&Dark Background", this),
     showLegendAction("&Legend", this),
     showMultiAction("Multi &Plot", this),
+    rollModeAction("&Roll Mode", this),
     setSymbolsAction("&Symbols", this),
     setSymbolsAutoAct("Show When &Zoomed", this),
     setSymbolsShowAct("Always &Show", this),
@@ -49,6 +50,7 @@ PlotMenu::PlotMenu(QWidget* parent) :
     darkBackgroundAction.setToolTip("Enable Dark Plot Background");
     showLegendAction.setToolTip("Display the Legend on Plot");
     showMultiAction.setToolTip("Display All Channels Separately");
+    rollModeAction.setToolTip("Only Draw Newly Added Samples While Scrolling");
     setSymbolsAction.setToolTip("Show/Hide symbols");
 
     showGridAction.setShortcut(QKeySequence("G"));
@@ -59,12 +61,14 @@ PlotMenu::PlotMenu(QWidget* parent) :
     darkBackgroundAction.setCheckable(true);
     showLegendAction.setCheckable(true);
     showMultiAction.setCheckable(true);
+    rollModeAction.setCheckable(true);
 
     showGridAction.setChecked(false);
     showMinorGridAction.setChecked(false);
     darkBackgroundAction.setChecked(false);
     showLegendAction.setChecked(true);
     showMultiAction.setChecked(false);
+    rollModeAction.setChecked(false);
 
     // minor grid is only enabled when _major_ grid is enabled
     showMinorGridAction.setEnabled(false);
@@ -144,6 +148,7 @@ PlotMenu::PlotMenu(QWidget* parent) :
     addAction(&showLegendAction);
     addAction(&setLegendPosAction);
     addAction(&showMultiAction);
+    addAction(&rollModeAction);
     addAction(&setSymbolsAction);
 }
 
@@ -211,6 +216,7 @@ void PlotMenu::saveSettings(QSettings* settings)
     settings->setValue(SG_Plot_MinorGrid, showMinorGridAction.isChecked());
     settings->setValue(SG_Plot_Legend, showLegendAction.isChecked());
     settings->setValue(SG_Plot_MultiPlot, showMultiAction.isChecked());
+    settings->setValue(SG_Plot_RollMode, rollModeAction.isChecked());
 
     // save symbol option
     QString showSymbolsStr;
@@ -265,6 +271,8 @@ void PlotMenu::loadSettings(QSettings* settings)
         settings->value(SG_Plot_Legend, showLegendAction.isChecked()).toBool());
     showMultiAction.setChecked(
         settings->value(SG_Plot_MultiPlot, showMultiAction.isChecked()).toBool());
+    rollModeAction.setChecked(
+        settings->value(SG_Plot_RollMode, rollModeAction.isChecked()).toBool());
 
     // load symbol option
     QString showSymbolsStr = settings->value(SG_Plot_Symbols, QString()).toString();
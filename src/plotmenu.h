@@ -51,6 +51,7 @@ public:
     QAction darkBackgroundAction;
     QAction showLegendAction;
     QAction showMultiAction;
+    QAction rollModeAction;
 
     /// Returns a bundle of current view settings (menu selections)
     PlotViewSettings viewSettings() const;
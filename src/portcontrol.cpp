@@ -26,6 +26,8 @@
 #include <QLineEdit>
 #include <QMap>
 #include <QtDebug>
+#include <string.h>
+#include <limits.h>
 
 #include "setting_defines.h"
 #include "utils.h"
@@ -51,6 +53,10 @@ PortControl::PortControl(QSerialPort* port, QWidget* parent) :
     serialPort = port;
     connect(serialPort, SIGNAL(error(QSerialPort::SerialPortError)),
             this, SLOT(onPortError(QSerialPort::SerialPortError)));
+    connect(&pipeDevice, &QIODevice::readChannelFinished, [this]()
+            {
+                qDebug() << "End of input:" << pipeDevice.path();
+            });
 
     // setup actions
     openAction.setCheckable(true);
@@ -265,7 +271,15 @@ void PortControl::selectFlowControl(int flowControl)
 
 void PortControl::togglePort()
 {
-    if (serialPort->isOpen())
+    if (pipeDevice.isOpen())
+    {
+        // readers should let go of the device before it's closed
+        emit deviceChanged(nullptr);
+        pipeDevice.close();
+        qDebug() << "Closed input:" << pipeDevice.path();
+        emit portToggled(false);
+    }
+    else if (serialPort->isOpen())
     {
         pinUpdateTimer.stop();
         serialPort->close();
@@ -300,6 +314,13 @@ void PortControl::togglePort()
             portName = static_cast<PortListItem*>(portList.item(portIndex))->portName();
         }
 
+        if (portName.startsWith(PIPE_PORT_PREFIX))
+        {
+            openPipe(portName.mid(strlen(PIPE_PORT_PREFIX)));
+            openAction.setChecked(isOpen());
+            return;
+        }
+
         serialPort->setPortName(ui->cbPortList->currentData(PortNameRole).toString());
 
         // open port
@@ -324,7 +345,21 @@ void PortControl::togglePort()
             emit portToggled(true);
         }
     }
-    openAction.setChecked(serialPort->isOpen());
+    openAction.setChecked(isOpen());
+}
+
+void PortControl::openPipe(QString path)
+{
+    if (!pipeDevice.openPath(path))
+    {
+        qCritical() << "Can't open input" << path << ":" << pipeDevice.errorString();
+        return;
+    }
+
+    qDebug() << "Opened input:" << path;
+    // other inputs are closed on `portToggled` so device is changed after
+    emit portToggled(true);
+    emit deviceChanged(&pipeDevice);
 }
 
 void PortControl::selectListedPort(QString portName)
@@ -333,16 +368,19 @@ void PortControl::selectListedPort(QString portName)
     portName = portName.split(" ")[0];
 
     QSerialPortInfo portInfo(portName);
-    if (portInfo.isNull())
+    if (portInfo.isNull() && !portName.startsWith(PIPE_PORT_PREFIX))
     {
         qWarning() << "Device doesn't exist:" << portName;
     }
 
+    QString openName = pipeDevice.isOpen() ?
+        PIPE_PORT_PREFIX + pipeDevice.path() : serialPort->portName();
+
     // has selection actually changed
-    if (portName != serialPort->portName())
+    if (portName != openName)
     {
         // if another port is already open, close it by toggling
-        if (serialPort->isOpen())
+        if (isOpen())
         {
             togglePort();
 
@@ -525,14 +563,42 @@ void PortControl::selectBaudrate(QString baudRate)
 
 void PortControl::openPort()
 {
-    if (!serialPort->isOpen())
+    if (!isOpen())
     {
         openAction.trigger();
     }
 }
 
+void PortControl::closePort()
+{
+    if (isOpen())
+    {
+        openAction.trigger();
+    }
+}
+
+bool PortControl::isOpen() const
+{
+    return serialPort->isOpen() || pipeDevice.isOpen();
+}
+
+QIODevice* PortControl::device()
+{
+    if (pipeDevice.isOpen())
+    {
+        return &pipeDevice;
+    }
+    else
+    {
+        return serialPort;
+    }
+}
+
 unsigned PortControl::maxBitRate() const
 {
+    // pipe input has no bit rate limit
+    if (pipeDevice.isOpen()) return UINT_MAX;
+
     float baud = serialPort->baudRate();
     float dataBits = serialPort->dataBits();
     float parityBits = serialPort->parity() == QSerialPort::NoParity ? 0 : 1;
@@ -567,7 +633,7 @@ void PortControl::saveSettings(QSettings* settings)
 void PortControl::loadSettings(QSettings* settings)
 {
     // make sure the port is closed
-    if (serialPort->isOpen()) togglePort();
+    if (isOpen()) togglePort();
 
     settings->beginGroup(SettingGroup_Port);
 
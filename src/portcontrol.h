@@ -31,6 +31,7 @@
 #include <QTimer>
 
 #include "portlist.h"
+#include "pipedevice.h"
 
 namespace Ui {
 class PortControl;
@@ -50,6 +51,11 @@ public:
     void selectPort(QString portName);
     void selectBaudrate(QString baudRate);
     void openPort();
+    void closePort();
+    /// Returns true if serial port or pipe input is open
+    bool isOpen() const;
+    /// Returns the pipe input if it's open, serial port otherwise
+    QIODevice* device();
     /// Returns maximum bit rate for current baud rate
     unsigned maxBitRate() const;
 
@@ -71,12 +77,16 @@ private:
     QAction loadPortListAction;
     QComboBox tbPortList;
     PortList portList;
+    /// Used instead of the serial port when a `PIPE_PORT_PREFIX` port is selected
+    PipeDevice pipeDevice;
 
     /// Used to refresh pinout signal leds periodically
     QTimer pinUpdateTimer;
 
     /// Returns the currently selected (entered) "portName" in the UI
     QString selectedPortName();
+    /// Opens the pipe input with given path
+    void openPipe(QString path);
     /// Returns currently selected parity as text to be saved in settings
     QString currentParityText();
     /// Returns currently selected flow control as text to be saved in settings
@@ -102,6 +112,9 @@ private slots:
 
 signals:
     void portToggled(bool open);
+    /// Emitted when the pipe input is opened and (with `nullptr`)
+    /// before it's closed.
+    void deviceChanged(QIODevice* device);
 };
 
 #endif // PORTCONTROL_H
@@ -50,8 +50,12 @@ void PortListItem::construct(QString name, QString description, quint16 vid, qui
     {
         text += QString(" ") + description;
     }
+    if (name.startsWith(PIPE_PORT_PREFIX))
+    {
+        // pipe and file inputs have no icon
+    }
     // Note: in some cases internal ports or RS232 ports may have VID&PID
-    if (vid && pid && !name.contains("tty"))
+    else if (vid && pid && !name.contains("tty"))
     {
         text += QString("[%1:").arg(vid, 4, 16, QChar('0'));
         text += QString("%1]").arg(pid, 4, 16, QChar('0'));
@@ -93,6 +97,7 @@ void PortList::loadPortList()
     {
         appendRow(new PortListItem(&portInfo));
     }
+    appendRow(new PortListItem(QString(PIPE_PORT_PREFIX) + "-", "(standard input)"));
     for (auto portName : userEnteredPorts)
     {
         appendRow(new PortListItem(portName));
@@ -25,6 +25,10 @@
 #include <QList>
 #include <QSerialPortInfo>
 
+/// Port names starting with this prefix select a `PipeDevice` with
+/// the rest of the name as path, "file:-" is the standard input
+const char PIPE_PORT_PREFIX[] = "file:";
+
 enum PortListRoles
 {
     PortNameRole = Qt::UserRole+1  // portName as QString
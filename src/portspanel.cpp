@@ -0,0 +1,254 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QIntValidator>
+#include <QSerialPortInfo>
+
+#include "portspanel.h"
+#include "setting_defines.h"
+
+PortsPanel::PortsPanel(Merger* merger, ChannelInfoModel* infoModel, QWidget* parent) :
+    QWidget(parent),
+    pbAdd(tr("Add Port")),
+    pbRemove(tr("Remove Port"))
+{
+    this->merger = merger;
+    this->infoModel = infoModel;
+    paused = false;
+
+    auto buttons = new QHBoxLayout();
+    buttons->addWidget(&pbAdd);
+    buttons->addWidget(&pbRemove);
+    auto label = new QLabel(tr("Channels of additional ports are appended after the main port's channels."));
+    label->setWordWrap(true);
+    buttons->addWidget(label, 1);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(buttons);
+    layout->addWidget(&tabWidget, 1);
+
+    pbRemove.setEnabled(false);
+    connect(&pbAdd, &QPushButton::clicked, this, &PortsPanel::onAdd);
+    connect(&pbRemove, &QPushButton::clicked, this, &PortsPanel::onRemove);
+
+    connect(infoModel, &QAbstractItemModel::rowsInserted,
+            [this](){updateChannelNames();});
+}
+
+PortsPanel::~PortsPanel()
+{
+    while (!entries.isEmpty())
+    {
+        removePort(entries.size() - 1);
+    }
+}
+
+PortsPanel::Entry& PortsPanel::addPort()
+{
+    Entry e;
+    e.port = new InputPort(this);
+    e.input = merger->addInput();
+    e.port->source()->connectSink(e.input);
+    e.port->formatPanel()->pause(paused);
+
+    e.cbPortName = new QComboBox();
+    e.cbPortName->setEditable(true);
+    for (auto& info : QSerialPortInfo::availablePorts())
+    {
+        e.cbPortName->addItem(info.portName());
+    }
+
+    e.cbBaudRate = new QComboBox();
+    e.cbBaudRate->setEditable(true);
+    e.cbBaudRate->setValidator(new QIntValidator(0, 1000000000, e.cbBaudRate));
+    for (auto baudRate : QSerialPortInfo::standardBaudRates())
+    {
+        e.cbBaudRate->addItem(QString::number(baudRate));
+    }
+    e.cbBaudRate->setCurrentText("9600");
+
+    e.pbOpen = new QPushButton(tr("Open"));
+    e.pbOpen->setCheckable(true);
+
+    auto portForm = new QFormLayout();
+    portForm->addRow(tr("Port:"), e.cbPortName);
+    portForm->addRow(tr("Baud Rate:"), e.cbBaudRate);
+    portForm->addRow(e.pbOpen);
+
+    e.page = new QWidget();
+    auto pageLayout = new QHBoxLayout(e.page);
+    pageLayout->addLayout(portForm);
+    pageLayout->addWidget(e.port->formatPanel(), 1);
+
+    auto port = e.port;
+    auto input = e.input;
+    auto cbPortName = e.cbPortName;
+    auto cbBaudRate = e.cbBaudRate;
+    auto pbOpen = e.pbOpen;
+    auto page = e.page;
+    connect(pbOpen, &QPushButton::toggled,
+            [this, port, cbPortName, cbBaudRate, pbOpen](bool checked)
+            {
+                if (checked == port->isOpen()) return;
+
+                if (!checked)
+                {
+                    port->close();
+                    return;
+                }
+
+                QString error = port->open(cbPortName->currentText(),
+                                           cbBaudRate->currentText().toInt());
+                if (!error.isEmpty())
+                {
+                    pbOpen->blockSignals(true);
+                    pbOpen->setChecked(false);
+                    pbOpen->blockSignals(false);
+                    QMessageBox::critical(this, tr("Port Error"),
+                                          tr("Couldn't open port %1: %2")
+                                          .arg(cbPortName->currentText()).arg(error));
+                }
+            });
+
+    connect(port, &InputPort::portToggled,
+            [this, input, cbPortName, cbBaudRate, pbOpen](bool open)
+            {
+                merger->setInputActive(input, open);
+
+                pbOpen->blockSignals(true);
+                pbOpen->setChecked(open);
+                pbOpen->blockSignals(false);
+                pbOpen->setText(open ? tr("Close") : tr("Open"));
+                cbPortName->setEnabled(!open);
+                cbBaudRate->setEnabled(!open);
+
+                if (open) updateChannelNames();
+            });
+
+    connect(cbPortName, &QComboBox::currentTextChanged,
+            [this, page](QString text)
+            {
+                tabWidget.setTabText(tabWidget.indexOf(page), text);
+            });
+
+    entries.append(e);
+    tabWidget.addTab(e.page, e.cbPortName->currentText());
+    tabWidget.setCurrentWidget(e.page);
+    pbRemove.setEnabled(true);
+
+    return entries.last();
+}
+
+void PortsPanel::removePort(int index)
+{
+    Entry e = entries.takeAt(index);
+
+    // port must be closed before its reader is destroyed
+    delete e.port;
+    merger->removeInput(e.input);
+    delete e.page;
+
+    pbRemove.setEnabled(!entries.isEmpty());
+}
+
+void PortsPanel::onAdd()
+{
+    addPort();
+}
+
+void PortsPanel::onRemove()
+{
+    int index = tabWidget.currentIndex();
+    if (index >= 0) removePort(index);
+}
+
+void PortsPanel::pause(bool enabled)
+{
+    paused = enabled;
+    for (auto& e : entries)
+    {
+        e.port->formatPanel()->pause(enabled);
+    }
+}
+
+void PortsPanel::updateChannelNames()
+{
+    for (auto& e : entries)
+    {
+        QString portName = e.cbPortName->currentText();
+        if (portName.isEmpty()) continue;
+
+        unsigned offset = merger->channelOffset(e.input);
+        unsigned nc = e.port->source()->numChannels();
+        for (unsigned i = 0; i < nc; i++)
+        {
+            unsigned ci = offset + i;
+            if ((int) ci >= infoModel->rowCount()) break;
+
+            if (infoModel->name(ci) == ChannelInfoModel::tr("Channel %1").arg(ci + 1))
+            {
+                infoModel->setData(infoModel->index(ci, ChannelInfoModel::COLUMN_NAME),
+                                   QString("%1: Channel %2").arg(portName).arg(i + 1));
+            }
+        }
+    }
+}
+
+void PortsPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Ports);
+    settings->beginWriteArray(SG_Ports_Port, entries.size());
+    for (int i = 0; i < entries.size(); i++)
+    {
+        settings->setArrayIndex(i);
+        auto& e = entries[i];
+        settings->setValue(SG_Ports_PortName, e.cbPortName->currentText());
+        settings->setValue(SG_Ports_BaudRate, e.cbBaudRate->currentText().toInt());
+        e.port->formatPanel()->saveSettings(settings);
+    }
+    settings->endArray();
+    settings->endGroup();
+}
+
+void PortsPanel::loadSettings(QSettings* settings)
+{
+    while (!entries.isEmpty())
+    {
+        removePort(entries.size() - 1);
+    }
+
+    settings->beginGroup(SettingGroup_Ports);
+    unsigned size = settings->beginReadArray(SG_Ports_Port);
+    for (unsigned i = 0; i < size; i++)
+    {
+        settings->setArrayIndex(i);
+        auto& e = addPort();
+        e.cbPortName->setCurrentText(settings->value(SG_Ports_PortName).toString());
+        e.cbBaudRate->setCurrentText(
+            settings->value(SG_Ports_BaudRate, e.cbBaudRate->currentText()).toString());
+        e.port->formatPanel()->loadSettings(settings);
+    }
+    settings->endArray();
+    settings->endGroup();
+}
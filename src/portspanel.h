@@ -0,0 +1,87 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PORTSPANEL_H
+#define PORTSPANEL_H
+
+#include <QWidget>
+#include <QTabWidget>
+#include <QComboBox>
+#include <QPushButton>
+#include <QSettings>
+#include <QList>
+
+#include "inputport.h"
+#include "merger.h"
+#include "channelinfomodel.h"
+
+/**
+ * Manages additional input ports.
+ *
+ * Each port has its own data format selection and reads in its own
+ * thread. Channels of additional ports are appended after the
+ * channels of the main port by `Merger`. Default channel names are
+ * replaced with port name prefixed names.
+ */
+class PortsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PortsPanel(Merger* merger, ChannelInfoModel* infoModel, QWidget* parent = 0);
+    ~PortsPanel();
+
+    /// Stores ports and their data format settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads ports from a `QSettings`, ports are not opened
+    void loadSettings(QSettings* settings);
+
+public slots:
+    void pause(bool enabled);
+
+private:
+    struct Entry
+    {
+        InputPort* port;
+        Sink* input;            ///< `Merger` input that port is connected to
+        QWidget* page;
+        QComboBox* cbPortName;
+        QComboBox* cbBaudRate;
+        QPushButton* pbOpen;
+    };
+
+    Merger* merger;
+    ChannelInfoModel* infoModel;
+    QTabWidget tabWidget;
+    QPushButton pbAdd, pbRemove;
+    QList<Entry> entries;
+    bool paused;
+
+    /// Adds a new port, returns its entry
+    Entry& addPort();
+    void removePort(int index);
+    /// Gives port prefixed names to channels that still have default names
+    void updateChannelNames();
+
+private slots:
+    void onAdd();
+    void onRemove();
+};
+
+#endif // PORTSPANEL_H
@@ -43,6 +43,7 @@ RecordPanel::RecordPanel(Stream* stream, QWidget *parent) :
 {
     overwriteSelected = false;
     _stream = stream;
+    _tap = stream;
 
     ui->setupUi(this);
 
@@ -66,6 +67,12 @@ RecordPanel::RecordPanel(Stream* stream, QWidget *parent) :
                 recorder.disableBuffering = enabled;
             });
 
+    connect(ui->cbSummary, &QCheckBox::toggled,
+            [this](bool enabled)
+            {
+                recorder.writeSummary = enabled;
+            });
+
     connect(ui->cbWindowsLE, &QCheckBox::toggled,
             [this](bool enabled)
             {
@@ -80,6 +87,7 @@ RecordPanel::RecordPanel(Stream* stream, QWidget *parent) :
 
 
     connect(&recordAction, &QAction::toggled, ui->cbWindowsLE, &QWidget::setDisabled);
+    connect(&recordAction, &QAction::toggled, ui->cbSummary, &QWidget::setDisabled);
     connect(&recordAction, &QAction::toggled, ui->cbTimestamp, &QWidget::setDisabled);
     connect(&recordAction, &QAction::toggled, ui->leSeparator, &QWidget::setDisabled);
     connect(&recordAction, &QAction::toggled, ui->pbBrowse, &QWidget::setDisabled);
@@ -307,6 +315,12 @@ bool RecordPanel::confirmOverwrite(QString fileName)
     }
 }
 
+void RecordPanel::setTap(Sink* tap)
+{
+    Q_ASSERT(!recordAction.isChecked());
+    _tap = tap;
+}
+
 bool RecordPanel::startRecording(QString fileName)
 {
     QStringList channelNames;
@@ -318,7 +332,7 @@ bool RecordPanel::startRecording(QString fileName)
 
     if (recorder.startRecording(fileName, getSeparator(), channelNames, currentTimestampOption()))
     {
-        _stream->connectFollower(&recorder);
+        _tap->connectFollower(&recorder);
         return true;
     }
     else
@@ -330,7 +344,7 @@ bool RecordPanel::startRecording(QString fileName)
 void RecordPanel::stopRecording(void)
 {
     recorder.stopRecording();
-    _stream->disconnectFollower(&recorder);
+    _tap->disconnectFollower(&recorder);
 }
 
 void RecordPanel::onPortClose()
@@ -372,6 +386,7 @@ void RecordPanel::saveSettings(QSettings* settings)
     settings->setValue(SG_Record_Separator, ui->leSeparator->text());
     settings->setValue(SG_Record_Decimals, ui->spDecimals->text());
     settings->setValue(SG_Record_Timestamp, ui->cbTimestamp->isChecked());
+    settings->setValue(SG_Record_Summary, ui->cbSummary->isChecked());
 
     QString tsFormatStr;
     auto tsOpt = static_cast<DataRecorder::TimestampOption>(ui->cbTimestampFormat->currentData().toInt());
@@ -411,6 +426,8 @@ void RecordPanel::loadSettings(QSettings* settings)
     ui->spDecimals->setValue(settings->value(SG_Record_Decimals, ui->spDecimals->value()).toInt());
     ui->cbTimestamp->setChecked(
         settings->value(SG_Record_Timestamp, ui->cbTimestamp->isChecked()).toBool());
+    ui->cbSummary->setChecked(
+        settings->value(SG_Record_Summary, ui->cbSummary->isChecked()).toBool());
 
     // load timestamp format
     QString tsFormatStr = settings->value(SG_Record_TimestampFormat, "").toString();
@@ -44,6 +44,13 @@ public:
 
     bool recordPaused();
 
+    /**
+     * Sets the sink that recorder follows to get data. By default
+     * recorder follows the stream. Must not be called during
+     * recording.
+     */
+    void setTap(Sink* tap);
+
     /// Stores settings into a `QSettings`
     void saveSettings(QSettings* settings);
     /// Loads settings from a `QSettings`.
@@ -65,6 +72,7 @@ private:
     bool overwriteSelected;
     DataRecorder recorder;
     Stream* _stream;
+    Sink* _tap;                 ///< recorder is connected as a follower of this
 
     /**
      * @brief Increments the file name.
@@ -0,0 +1,225 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtConcurrent>
+#include <QStandardPaths>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QtDebug>
+
+#include "sessioncheckpoint.h"
+
+const char SessionCheckpoint::RESTORED_DIR[] = "restored";
+
+SessionCheckpoint::SessionCheckpoint(const Stream* stream, QString dir, QObject* parent) :
+    QObject(parent),
+    lockFile(dir + "/session.lock")
+{
+    _stream = stream;
+    _dir = dir;
+    lastTotal = 0;
+    job.dir = dir;
+    job.numSamples = 0;
+
+    connect(&timer, &QTimer::timeout, this, &SessionCheckpoint::checkpoint);
+}
+
+SessionCheckpoint::~SessionCheckpoint()
+{
+    stop();
+}
+
+QString SessionCheckpoint::defaultDirectory()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 4, 0)
+    QString base = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+#else
+    QString base = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+#endif
+    return base + "/session";
+}
+
+QString SessionCheckpoint::directory() const
+{
+    return _dir;
+}
+
+bool SessionCheckpoint::isActive() const
+{
+    return timer.isActive();
+}
+
+bool SessionCheckpoint::lock()
+{
+    if (lockFile.isLocked()) return true;
+
+    // a lock left by a crashed instance is removed by `QLockFile`
+    return QDir().mkpath(_dir) && lockFile.tryLock(0);
+}
+
+QStringList SessionCheckpoint::lastSessionFiles()
+{
+    QStringList files;
+    if (isActive() || !lock()) return files;
+
+    for (unsigned ci = 0; QFileInfo(fileName(_dir, ci)).isFile(); ci++)
+    {
+        files << fileName(_dir, ci);
+    }
+    return files;
+}
+
+QStringList SessionCheckpoint::takeLastSessionFiles()
+{
+    QStringList files = lastSessionFiles();
+    if (files.isEmpty()) return files;
+
+    // only the last restored session is kept
+    QDir restoredDir(QString("%1/%2").arg(_dir).arg(RESTORED_DIR));
+    if (restoredDir.exists()) restoredDir.removeRecursively();
+    if (!QDir().mkpath(restoredDir.path()))
+    {
+        qCritical() << "Couldn't create directory for restored files:" << restoredDir.path();
+        return QStringList();
+    }
+
+    QStringList moved;
+    for (auto f : files)
+    {
+        QString newName = restoredDir.filePath(QFileInfo(f).fileName());
+        if (!QFile::rename(f, newName))
+        {
+            qCritical() << "Couldn't move last session file:" << f;
+            break;
+        }
+        moved << newName;
+    }
+    return moved;
+}
+
+void SessionCheckpoint::start(int intervalMs)
+{
+    if (isActive()) return;
+
+    if (!lock())
+    {
+        qWarning() << "Session data isn't saved, directory is in use:" << _dir;
+        return;
+    }
+
+    for (auto f : lastSessionFiles())
+    {
+        QFile::remove(f);
+    }
+
+    // first checkpoint saves what's already in the stream
+    lastTotal = 0;
+    timer.start(intervalMs);
+}
+
+void SessionCheckpoint::stop()
+{
+    bool active = isActive();
+    timer.stop();
+    waitForFinished();
+
+    for (auto buf : job.buffers)
+    {
+        QString f = buf->fileName();
+        delete buf;
+        // session ended properly, nothing to restore
+        if (active) QFile::remove(f);
+    }
+    job.buffers.clear();
+    job.numSamples = 0;
+
+    lockFile.unlock();
+}
+
+void SessionCheckpoint::waitForFinished()
+{
+    watcher.waitForFinished();
+}
+
+void SessionCheckpoint::checkpoint()
+{
+    if (!isActive()) return;
+    // skip, next checkpoint will contain the data
+    if (watcher.isRunning()) return;
+
+    quint64 total = _stream->totalSamples();
+    unsigned ns = _stream->numSamples();
+    unsigned nc = _stream->numChannels();
+    unsigned n = qMin(total - lastTotal, quint64(ns));
+
+    if (n == 0 && (int) nc == job.buffers.size() && ns == job.numSamples) return;
+
+    // only new samples are copied
+    job.numSamples = ns;
+    job.samples.resize(nc);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        const FrameBuffer* y = _stream->channel(ci)->yData();
+        QVector<double>& s = job.samples[ci];
+        s.resize(n);
+        for (unsigned i = 0; i < n; i++)
+        {
+            s[i] = y->sample(ns - n + i);
+        }
+    }
+    lastTotal = total;
+
+    watcher.setFuture(QtConcurrent::run(&SessionCheckpoint::write, &job));
+}
+
+QString SessionCheckpoint::fileName(QString dir, unsigned channel)
+{
+    return QString("%1/channel_%2%3").arg(dir).arg(channel).arg(MappedBuffer::FILE_SUFFIX);
+}
+
+void SessionCheckpoint::write(Job* job)
+{
+    int nc = job->samples.size();
+
+    // follow the number of channels
+    while (job->buffers.size() > nc)
+    {
+        auto buf = job->buffers.takeLast();
+        QString f = buf->fileName();
+        delete buf;
+        QFile::remove(f);
+    }
+    while (job->buffers.size() < nc)
+    {
+        job->buffers << new MappedBuffer(job->numSamples,
+                                         fileName(job->dir, job->buffers.size()));
+    }
+
+    for (int ci = 0; ci < nc; ci++)
+    {
+        MappedBuffer* buf = job->buffers[ci];
+        // resizing keeps the end, same as stream buffers
+        if (buf->size() != job->numSamples) buf->resize(job->numSamples);
+
+        QVector<double>& s = job->samples[ci];
+        if (!s.isEmpty()) buf->addSamples(s.data(), s.size());
+        buf->sync();
+    }
+}
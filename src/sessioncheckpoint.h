@@ -0,0 +1,131 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SESSIONCHECKPOINT_H
+#define SESSIONCHECKPOINT_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QTimer>
+#include <QLockFile>
+#include <QFutureWatcher>
+
+#include "stream.h"
+#include "mappedbuffer.h"
+
+/**
+ * Periodically saves the channel buffers of a `Stream` to buffer
+ * files (see `MappedBuffer`) so that data is not lost if the
+ * application crashes.
+ *
+ * At every checkpoint only the samples added since the previous
+ * checkpoint are copied from the stream and appended to the files on
+ * a worker thread, so the cost is proportional to the new data, not
+ * the buffer size.
+ *
+ * Files are removed when checkpointing is stopped normally; files
+ * found at startup belong to a session that didn't end properly. See
+ * `lastSessionFiles()`.
+ */
+class SessionCheckpoint : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Default checkpoint interval
+    static const int DEFAULT_INTERVAL_MS = 5000;
+    /// Sub directory that restored files of the last session are moved to
+    static const char RESTORED_DIR[];
+
+    /**
+     * @param stream stream to save
+     * @param dir directory to keep the files in, created if it
+     * doesn't exist
+     */
+    SessionCheckpoint(const Stream* stream, QString dir, QObject* parent = 0);
+    ~SessionCheckpoint();
+
+    /// Returns the default directory for session files
+    static QString defaultDirectory();
+
+    QString directory() const;
+    /// Returns true if checkpoints are being taken
+    bool isActive() const;
+
+    /**
+     * Returns buffer files left by a session that didn't end
+     * properly. Empty if there are none or if another instance is
+     * using the directory.
+     */
+    QStringList lastSessionFiles();
+    /**
+     * Moves files of the last session into `RESTORED_DIR` sub
+     * directory, so that they can be kept open (ex: loaded as a
+     * snapshot) while new checkpoints are taken. Files restored
+     * before are removed.
+     *
+     * @return new file names, empty if there are none
+     */
+    QStringList takeLastSessionFiles();
+    /// Waits for the checkpoint that is being written
+    void waitForFinished();
+
+public slots:
+    /**
+     * Starts taking checkpoints. Files of the last session are
+     * overwritten. Does nothing if another instance is using the
+     * directory.
+     */
+    void start(int intervalMs = DEFAULT_INTERVAL_MS);
+    /// Stops taking checkpoints and removes the files
+    void stop();
+    /// Starts a checkpoint now if active, skipped if previous one is
+    /// still being written
+    void checkpoint();
+
+private:
+    /// Data shared with the worker thread
+    struct Job
+    {
+        QString dir;
+        unsigned numSamples;              ///< buffer size
+        QVector<QVector<double>> samples; ///< new samples per channel
+        QList<MappedBuffer*> buffers;     ///< owned by the worker while running
+    };
+
+    const Stream* _stream;
+    QString _dir;
+    QLockFile lockFile;
+    quint64 lastTotal;          ///< `Stream::totalSamples()` at last checkpoint
+    Job job;
+    QFutureWatcher<void> watcher;
+    QTimer timer;
+
+    /// Locks the directory for this instance
+    bool lock();
+    /// Returns the file name for a channel
+    static QString fileName(QString dir, unsigned channel);
+    /// Worker thread entry
+    static void write(Job* job);
+};
+
+#endif // SESSIONCHECKPOINT_H
@@ -26,11 +26,16 @@ const char SettingGroup_DataFormat[] = "DataFormat";
 const char SettingGroup_Binary[] = "DataFormat_Binary";
 const char SettingGroup_ASCII[] = "DataFormat_ASCII";
 const char SettingGroup_CustomFrame[] = "DataFormat_CustomFrame";
+const char SettingGroup_Packet[] = "DataFormat_Packet";
 const char SettingGroup_Channels[] = "Channels";
 const char SettingGroup_Plot[] = "Plot";
 const char SettingGroup_Commands[] = "Commands";
 const char SettingGroup_Record[] = "Record";
 const char SettingGroup_TextView[] = "TextView";
+const char SettingGroup_Trigger[] = "Trigger";
+const char SettingGroup_Filter[] = "Filter";
+const char SettingGroup_Ports[] = "Ports";
+const char SettingGroup_Network[] = "Network";
 const char SettingGroup_UpdateCheck[] = "UpdateCheck";
 
 // mainwindow setting keys
@@ -56,6 +61,8 @@ const char SG_DataFormat_Format[] = "format";
 const char SG_Binary_NumOfChannels[] = "numOfChannels";
 const char SG_Binary_NumberFormat[] = "numberFormat";
 const char SG_Binary_Endianness[] = "endianness";
+const char SG_Binary_Layout[] = "layout";
+const char SG_Binary_AutoAlign[] = "autoAlign";
 
 // ascii reader keys
 const char SG_ASCII_NumOfChannels[] = "numOfChannels";
@@ -64,6 +71,8 @@ const char SG_ASCII_CustomDelimiter[] = "customDelimiter";
 const char SG_ASCII_FilterMode[] = "filterMode";
 const char SG_ASCII_FilterPrefix[] = "filterPrefix";
 const char SG_ASCII_Hex[] = "hex";
+const char SG_ASCII_KeyValue[] = "keyValue";
+const char SG_ASCII_Keys[] = "keys";
 
 // framed reader keys
 const char SG_CustomFrame_NumOfChannels[] = "numOfChannels";
@@ -73,8 +82,18 @@ const char SG_CustomFrame_FixedFrameSize[] = "frameSize";
 const char SG_CustomFrame_NumberFormat[] = "numberFormat";
 const char SG_CustomFrame_Endianness[] = "endianness";
 const char SG_CustomFrame_Checksum[] = "checksum";
+const char SG_CustomFrame_ChecksumType[] = "checksumType";
+const char SG_CustomFrame_Layout[] = "layout";
 const char SG_CustomFrame_DebugMode[] = "debugMode";
 
+// packet reader keys
+const char SG_Packet_Encoding[] = "encoding";
+const char SG_Packet_NumOfChannels[] = "numOfChannels";
+const char SG_Packet_NumberFormat[] = "numberFormat";
+const char SG_Packet_Endianness[] = "endianness";
+const char SG_Packet_Layout[] = "layout";
+const char SG_Packet_Checksum[] = "checksumType";
+
 // channel info keys
 const char SG_Channels_Channel[] = "channel";
 const char SG_Channels_Name[] = "name";
@@ -84,6 +103,8 @@ const char SG_Channels_Gain[] = "gain";
 const char SG_Channels_GainEn[] = "gainEnabled";
 const char SG_Channels_Offset[] = "offset";
 const char SG_Channels_OffsetEn[] = "offsetEnabled";
+const char SG_Channels_Calibration[] = "calibration";
+const char SG_Channels_Expressions[] = "expressions";
 
 // plot settings keys
 const char SG_Plot_NumOfSamples[] = "numOfSamples";
@@ -100,6 +121,7 @@ const char SG_Plot_MinorGrid[] = "minorGrid";
 const char SG_Plot_Legend[] = "legend";
 const char SG_Plot_LegendPos[] = "legendPos";
 const char SG_Plot_MultiPlot[] = "multiPlot";
+const char SG_Plot_RollMode[] = "rollMode";
 const char SG_Plot_Symbols[] = "symbols";
 const char SG_Plot_LineThickness[] = "lineThickness";
 
@@ -119,11 +141,39 @@ const char SG_Record_DisableBuffering[] = "disableBuffering";
 const char SG_Record_Timestamp[]        = "timestamp";
 const char SG_Record_TimestampFormat[]  = "timestampFormat";
 const char SG_Record_Decimals[]         = "decimals";
+const char SG_Record_Summary[]          = "summary";
 
 // text view settings keys
 const char SG_TextView_NumLines[] = "numLines";
 const char SG_TextView_Decimals[] = "decimals";
 
+// trigger settings keys
+const char SG_Trigger_Enabled[] = "enabled";
+const char SG_Trigger_Channel[] = "channel";
+const char SG_Trigger_Edge[] = "edge";
+const char SG_Trigger_Level[] = "level";
+const char SG_Trigger_PreDepth[] = "preDepth";
+const char SG_Trigger_PostDepth[] = "postDepth";
+const char SG_Trigger_Mode[] = "mode";
+
+// filter settings keys
+const char SG_Filter_Enabled[] = "enabled";
+const char SG_Filter_IirType[] = "iirType";
+const char SG_Filter_IirOrder[] = "iirOrder";
+const char SG_Filter_IirCutoff[] = "iirCutoff";
+const char SG_Filter_Decimation[] = "decimation";
+const char SG_Filter_FirTaps[] = "firTaps";
+
+// additional input ports settings keys
+const char SG_Ports_Port[] = "port";
+const char SG_Ports_PortName[] = "portName";
+const char SG_Ports_BaudRate[] = "baudRate";
+
+// network settings keys
+const char SG_Network_Mode[] = "mode";
+const char SG_Network_Host[] = "host";
+const char SG_Network_Port[] = "port";
+
 // update check settings keys
 const char SG_UpdateCheck_Periodic[]  = "periodicCheck";
 const char SG_UpdateCheck_LastCheck[] = "lastCheck";
@@ -27,9 +27,13 @@
 #include <QPointF>
 #include <QIcon>
 #include <QtDebug>
+#include <QFileInfo>
+#include <QDir>
+#include <limits.h>
 
 #include "mainwindow.h"
 #include "snapshotmanager.h"
+#include "mappedbuffer.h"
 
 SnapshotManager::SnapshotManager(MainWindow* mainWindow,
                                  Stream* stream) :
@@ -44,7 +48,7 @@ SnapshotManager::SnapshotManager(MainWindow* mainWindow,
     _takeSnapshotAction.setToolTip("Take a snapshot of current plot");
     _takeSnapshotAction.setShortcut(QKeySequence("Ctrl+P"));
     _takeSnapshotAction.setIcon(QIcon::fromTheme("camera"));
-    loadSnapshotAction.setToolTip("Load snapshots from CSV files");
+    loadSnapshotAction.setToolTip("Load snapshots from CSV or buffer (*.spbuf) files");
     clearAction.setToolTip("Delete all snapshots");
     connect(&_takeSnapshotAction, SIGNAL(triggered(bool)),
             this, SLOT(takeSnapshot()));
@@ -129,10 +133,19 @@ void SnapshotManager::loadSnapshots()
 {
     auto files = QFileDialog::getOpenFileNames(_mainWindow, tr("Load CSV File"));
 
+    QStringList bufferFiles;
     for (auto f : files)
     {
-        if (!f.isNull()) loadSnapshotFromFile(f);
+        if (f.endsWith(MappedBuffer::FILE_SUFFIX))
+        {
+            bufferFiles << f;
+        }
+        else if (!f.isNull())
+        {
+            loadSnapshotFromFile(f);
+        }
     }
+    if (!bufferFiles.isEmpty()) loadSnapshotFromBuffers(bufferFiles);
 
     updateMenu();
 }
@@ -210,6 +223,49 @@ void SnapshotManager::loadSnapshotFromFile(QString fileName)
     addSnapshot(snapshot, false);
 }
 
+void SnapshotManager::loadSnapshotFromBuffers(QStringList fileNames)
+{
+    QList<MappedBuffer*> buffers;
+    QStringList channelNames;
+    unsigned numSamples = UINT_MAX;
+    for (auto fileName : fileNames)
+    {
+        QString error;
+        auto buf = MappedBuffer::open(fileName, &error);
+        if (buf == nullptr)
+        {
+            qCritical() << "Couldn't open buffer file" << fileName << ":" << error;
+            continue;
+        }
+        buffers << buf;
+        channelNames << QFileInfo(fileName).completeBaseName();
+        numSamples = qMin(numSamples, buf->numValid());
+    }
+
+    // only the samples that are written to all buffers are loaded
+    if (!buffers.isEmpty() && numSamples > 0)
+    {
+        auto snapshot = new Snapshot(
+            _mainWindow, QFileInfo(fileNames[0]).dir().dirName(),
+            ChannelInfoModel(channelNames), false);
+
+        for (auto buf : buffers)
+        {
+            snapshot->xData.append(new IndexBuffer(numSamples));
+            snapshot->yData.append(
+                new ReadOnlyBuffer(buf, buf->size() - numSamples, numSamples));
+        }
+
+        addSnapshot(snapshot);
+    }
+    else if (!buffers.isEmpty())
+    {
+        qWarning() << "Buffer files don't contain any data.";
+    }
+
+    qDeleteAll(buffers);
+}
+
 QMenu* SnapshotManager::menu()
 {
     return &_menu;
@@ -46,6 +46,9 @@ public:
 
     bool isAllSaved(); ///< returns `true` if all snapshots are saved to a file
 
+    /// Loads buffer files (see `MappedBuffer`) as a snapshot, each file is a channel
+    void loadSnapshotFromBuffers(QStringList fileNames);
+
 private:
     MainWindow* _mainWindow;
     Stream* _stream;
@@ -0,0 +1,268 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <string.h>
+#include <QtConcurrent>
+
+#include "spectrum.h"
+
+/// Spectrum update period
+#define UPDATE_INTERVAL_MS 100
+/// Maximum number of frames transformed in an update
+#define MAX_FRAMES 3
+/// Lower limit of magnitude in dB
+#define MIN_DB (-200.)
+
+Spectrum::Spectrum(QObject* parent) :
+    QObject(parent)
+{
+    _fftSize = 0;
+    _averaging = 1;
+    fft = nullptr;
+    total = 0;
+    lastEnd = 0;
+    setFftSize(DEFAULT_FFT_SIZE);
+
+    connect(&watcher, &QFutureWatcher<void>::finished,
+            this, &Spectrum::onWorkerFinished);
+    connect(&updateTimer, &QTimer::timeout, this, &Spectrum::startUpdate);
+    updateTimer.start(UPDATE_INTERVAL_MS);
+}
+
+Spectrum::~Spectrum()
+{
+    waitWorker();
+    delete fft;
+}
+
+unsigned Spectrum::numBins() const
+{
+    return _fftSize / 2 + 1;
+}
+
+unsigned Spectrum::numChannels() const
+{
+    return rings.size();
+}
+
+const QVector<double>& Spectrum::magnitude(unsigned channel) const
+{
+    Q_ASSERT(channel < numChannels());
+    return _magnitude[channel];
+}
+
+void Spectrum::setFftSize(unsigned n)
+{
+    Q_ASSERT(FFT::isValidSize(n) && n <= MAX_FFT_SIZE);
+    if (n == _fftSize) return;
+
+    waitWorker();
+
+    _fftSize = n;
+    hop = n / 2;
+    ringSize = 2 * n;
+
+    delete fft;
+    fft = new FFT(n);
+
+    window.resize(n);
+    windowSum = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+        window[i] = 0.5 - 0.5 * cos(2 * M_PI * i / n);
+        windowSum += window[i];
+    }
+
+    reset();
+}
+
+void Spectrum::setAveraging(unsigned n)
+{
+    _averaging = qMax(n, 1u);
+}
+
+void Spectrum::clear()
+{
+    waitWorker();
+    reset();
+}
+
+void Spectrum::reset()
+{
+    for (auto& ring : rings)
+    {
+        ring.fill(0, ringSize);
+    }
+    total = 0;
+    lastEnd = 0;
+    job.average.clear();
+    job.result.clear();
+    for (auto& mag : _magnitude)
+    {
+        mag.clear();
+    }
+}
+
+void Spectrum::waitWorker()
+{
+    if (watcher.isRunning())
+    {
+        watcher.waitForFinished();
+    }
+}
+
+void Spectrum::setNumChannels(unsigned nc, bool x)
+{
+    waitWorker();
+    rings.resize(nc);
+    _magnitude.resize(nc);
+    reset();
+
+    Sink::setNumChannels(nc, x);
+}
+
+void Spectrum::feedIn(const SamplePack& data)
+{
+    unsigned ns = data.numSamples();
+    // only the last `ringSize` samples can be kept
+    unsigned skip = ns > ringSize ? ns - ringSize : 0;
+    unsigned n = ns - skip;
+    unsigned pos = (total + skip) % ringSize;
+    unsigned first = qMin(n, ringSize - pos);
+
+    for (unsigned ci = 0; ci < numChannels(); ci++)
+    {
+        const double* src = data.data(ci) + skip;
+        double* ring = rings[ci].data();
+        memcpy(ring + pos, src, first * sizeof(double));
+        memcpy(ring, src + first, (n - first) * sizeof(double));
+    }
+    total += ns;
+
+    Sink::feedIn(data);
+}
+
+void Spectrum::copyFrame(unsigned ci, quint64 end, double* dest) const
+{
+    unsigned pos = (end - _fftSize) % ringSize;
+    unsigned first = qMin(_fftSize, ringSize - pos);
+    const double* ring = rings[ci].constData();
+    memcpy(dest, ring + pos, first * sizeof(double));
+    memcpy(dest + first, ring, (_fftSize - first) * sizeof(double));
+}
+
+void Spectrum::startUpdate()
+{
+    if (watcher.isRunning() || rings.isEmpty()) return;
+
+    // latest frame end on hop grid
+    quint64 last = (total / hop) * hop;
+    if (last < _fftSize || last <= lastEnd) return;
+
+    // collect newest frames that are still in the ring, oldest first
+    QVector<quint64> ends;
+    for (quint64 end = last;
+         ends.size() < MAX_FRAMES && end > lastEnd && end >= _fftSize &&
+             end + ringSize >= total + _fftSize;
+         end -= hop)
+    {
+        ends.prepend(end);
+    }
+    lastEnd = last;
+    if (ends.isEmpty()) return;
+
+    unsigned nc = numChannels();
+    job.frames.resize(nc);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        job.frames[ci].resize(ends.size() * _fftSize);
+        for (int f = 0; f < ends.size(); f++)
+        {
+            copyFrame(ci, ends[f], job.frames[ci].data() + f * _fftSize);
+        }
+    }
+    job.numFrames = ends.size();
+    job.fft = fft;
+    job.window = window.constData();
+    job.windowSum = windowSum;
+    job.averaging = _averaging;
+
+    watcher.setFuture(QtConcurrent::run(&Spectrum::compute, &job));
+}
+
+void Spectrum::compute(Job* job)
+{
+    const unsigned n = job->fft->size();
+    const unsigned nb = job->fft->numBins();
+    const unsigned nc = job->frames.size();
+    // amplitude of a sine at bin center is |X| * 2 / sum(window)
+    const double scale = 2. / job->windowSum;
+
+    QVector<double> windowed(n), re(nb), im(nb);
+    job->average.resize(nc);
+    job->result.resize(nc);
+
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        QVector<double>& avg = job->average[ci];
+        bool first = avg.size() != (int) nb;
+        if (first) avg.fill(0, nb);
+
+        for (unsigned f = 0; f < job->numFrames; f++)
+        {
+            const double* frame = job->frames[ci].constData() + f * n;
+            for (unsigned i = 0; i < n; i++)
+            {
+                windowed[i] = frame[i] * job->window[i];
+            }
+
+            job->fft->transform(windowed.constData(), re.data(), im.data());
+
+            double k = first ? 1. : 1. / job->averaging;
+            for (unsigned b = 0; b < nb; b++)
+            {
+                double mag = sqrt(re[b] * re[b] + im[b] * im[b]) * scale;
+                avg[b] += (mag - avg[b]) * k;
+            }
+            first = false;
+        }
+
+        QVector<double>& result = job->result[ci];
+        result.resize(nb);
+        for (unsigned b = 0; b < nb; b++)
+        {
+            result[b] = avg[b] > 0 ? qMax(20 * log10(avg[b]), MIN_DB) : MIN_DB;
+        }
+    }
+}
+
+void Spectrum::onWorkerFinished()
+{
+    // channels or size may have changed while worker was running
+    if (job.result.size() != (int) numChannels()) return;
+
+    for (unsigned ci = 0; ci < numChannels(); ci++)
+    {
+        if (job.result[ci].size() != (int) numBins()) return;
+        _magnitude[ci].swap(job.result[ci]);
+    }
+
+    emit updated();
+}
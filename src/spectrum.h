@@ -0,0 +1,128 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <QObject>
+#include <QVector>
+#include <QTimer>
+#include <QFutureWatcher>
+
+#include "sink.h"
+#include "fft.h"
+
+/**
+ * Computes averaged magnitude spectrum of each channel.
+ *
+ * Incoming samples are only copied into per channel ring buffers in
+ * `feedIn()`. At a fixed rate (independent of the input rate) latest
+ * frames are taken from the rings and transformed on a worker
+ * thread. Frames are Hann windowed and overlap by half of the FFT
+ * size. If input is faster than what can be computed in an update
+ * period, older frames are skipped.
+ *
+ * Results are exponentially averaged linear magnitudes converted to
+ * dB, normalized so that a sine of amplitude A reads 20*log10(A).
+ */
+class Spectrum : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    /// Default FFT size
+    static const unsigned DEFAULT_FFT_SIZE = 1024;
+    /// Maximum FFT size
+    static const unsigned MAX_FFT_SIZE = 1 << 20;
+
+    explicit Spectrum(QObject* parent = 0);
+    ~Spectrum();
+
+    unsigned fftSize() const {return _fftSize;};
+    unsigned averaging() const {return _averaging;};
+    /// Number of bins of a channel spectrum
+    unsigned numBins() const;
+    /// Number of channels
+    unsigned numChannels() const;
+    /// Magnitude of a channel in dB, `numBins()` long. Empty until
+    /// first update.
+    const QVector<double>& magnitude(unsigned channel) const;
+
+public slots:
+    /// Sets FFT size, must be a power of 2. Resets the averages.
+    void setFftSize(unsigned n);
+    /// Sets averaging factor, 1 means no averaging
+    void setAveraging(unsigned n);
+    /// Clears averages and buffered samples
+    void clear();
+
+signals:
+    /// Emitted when new magnitudes are ready
+    void updated();
+
+protected:
+    void feedIn(const SamplePack& data) override;
+    void setNumChannels(unsigned nc, bool x) override;
+
+private:
+    /// Data shared with the worker thread
+    struct Job
+    {
+        const FFT* fft;
+        const double* window;
+        double windowSum;
+        unsigned averaging;
+        unsigned numFrames;
+        QVector<QVector<double>> frames;  ///< `numFrames` frames per channel
+        QVector<QVector<double>> average; ///< linear magnitude averages
+        QVector<QVector<double>> result;  ///< averages in dB
+    };
+
+    unsigned _fftSize;
+    unsigned _averaging;
+    unsigned hop;                       ///< frame advance
+    unsigned ringSize;
+    FFT* fft;
+    QVector<double> window;
+    double windowSum;
+
+    QVector<QVector<double>> rings;     ///< input ring buffer per channel
+    quint64 total;                      ///< total number of samples written
+    quint64 lastEnd;                    ///< end of last processed frame
+
+    Job job;
+    QFutureWatcher<void> watcher;
+    QTimer updateTimer;
+    QVector<QVector<double>> _magnitude;
+
+    /// Waits for the worker to finish if it's running
+    void waitWorker();
+    /// Resets rings, averages and results
+    void reset();
+    /// Copies `fftSize` samples ending at `end` from channel ring to `dest`
+    void copyFrame(unsigned ci, quint64 end, double* dest) const;
+    /// Worker thread entry
+    static void compute(Job* job);
+
+private slots:
+    void startUpdate();
+    void onWorkerFinished();
+};
+
+#endif // SPECTRUM_H
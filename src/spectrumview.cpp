@@ -0,0 +1,213 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <qwt_plot_grid.h>
+
+#include "spectrumview.h"
+#include "utils.h"
+
+SpectrumView::SpectrumView(Stream* stream, PlotMenu* menu, QWidget* parent) :
+    QWidget(parent)
+{
+    _stream = stream;
+
+    for (unsigned n = 256; n <= Spectrum::MAX_FFT_SIZE; n *= 2)
+    {
+        fftSizeBox.addItem(QString::number(n), n);
+    }
+    fftSizeBox.setCurrentIndex(fftSizeBox.findData(spectrum.fftSize()));
+    fftSizeBox.setToolTip(tr("Number of samples in a transform"));
+
+    averagingBox.setRange(1, 1000);
+    averagingBox.setValue(spectrum.averaging());
+    averagingBox.setToolTip(tr("Averaging factor, 1 disables averaging"));
+
+    waterfallBox.setText(tr("Waterfall"));
+    waterfallBox.setToolTip(tr("Show spectrogram of selected channel"));
+    waterfallChannelBox.setRange(1, 1);
+    waterfallChannelBox.setPrefix(tr("Channel "));
+    waterfallChannelBox.setEnabled(false);
+    rangeMinBox.setRange(-400, 400);
+    rangeMinBox.setValue(-120);
+    rangeMinBox.setSuffix(" dB");
+    rangeMinBox.setToolTip(tr("Waterfall color range minimum"));
+    rangeMaxBox.setRange(-400, 400);
+    rangeMaxBox.setValue(0);
+    rangeMaxBox.setSuffix(" dB");
+    rangeMaxBox.setToolTip(tr("Waterfall color range maximum"));
+    rangeMinBox.setEnabled(false);
+    rangeMaxBox.setEnabled(false);
+    waterfall.setVisible(false);
+    onWaterfallRangeChanged();
+
+    auto controls = new QHBoxLayout();
+    controls->addWidget(new QLabel(tr("FFT Size:")));
+    controls->addWidget(&fftSizeBox);
+    controls->addWidget(new QLabel(tr("Averaging:")));
+    controls->addWidget(&averagingBox);
+    controls->addWidget(&waterfallBox);
+    controls->addWidget(&waterfallChannelBox);
+    controls->addWidget(&rangeMinBox);
+    controls->addWidget(&rangeMaxBox);
+    controls->addStretch();
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(&plot, 1);
+    layout->addWidget(&waterfall, 1);
+
+    plot.setAxisTitle(QwtPlot::xBottom, tr("Frequency (cycles/sample)"));
+    plot.setAxisTitle(QwtPlot::yLeft, tr("Magnitude (dB)"));
+    plot.setAxisScale(QwtPlot::xBottom, 0, 0.5);
+    plot.setAxisAutoScale(QwtPlot::yLeft);
+
+    auto grid = new QwtPlotGrid();
+    grid->setPen(Qt::darkGray);
+    grid->attach(&plot);
+
+    connect(&fftSizeBox, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            this, &SpectrumView::onFftSizeSelected);
+    connect(&averagingBox, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int value){spectrum.setAveraging(value);});
+
+    connect(&waterfallBox, &QCheckBox::toggled,
+            [this](bool checked)
+            {
+                waterfall.clear();
+                waterfall.setVisible(checked);
+                waterfallChannelBox.setEnabled(checked);
+                rangeMinBox.setEnabled(checked);
+                rangeMaxBox.setEnabled(checked);
+            });
+    connect(&waterfallChannelBox, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            &waterfall, &Waterfall::clear);
+    connect(&rangeMinBox, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            this, &SpectrumView::onWaterfallRangeChanged);
+    connect(&rangeMaxBox, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            this, &SpectrumView::onWaterfallRangeChanged);
+
+    connect(&spectrum, &Spectrum::updated, this, &SpectrumView::updateCurves);
+    connect(_stream->infoModel(), &QAbstractItemModel::dataChanged,
+            [this](const QModelIndex& topLeft)
+            {
+                if (!ChannelInfoModel::isStatsColumn(topLeft.column())) updateCurveStyles();
+            });
+
+    connect(&menu->darkBackgroundAction, SELECT<bool>::OVERLOAD_OF(&QAction::toggled),
+            this, &SpectrumView::darkBackground);
+    darkBackground(menu->darkBackgroundAction.isChecked());
+
+    _stream->connectFollower(&spectrum);
+    updateCurveList();
+}
+
+SpectrumView::~SpectrumView()
+{
+    _stream->disconnectFollower(&spectrum);
+    for (auto curve : curves)
+    {
+        curve->detach();
+        delete curve;
+    }
+}
+
+void SpectrumView::updateCurveList()
+{
+    unsigned nc = spectrum.numChannels();
+    while ((unsigned) curves.size() < nc)
+    {
+        auto curve = new PlotCurve();
+        curve->setPaintAttribute(QwtPlotCurve::FilterPoints, true);
+        curve->attach(&plot);
+        curves.append(curve);
+    }
+    waterfallChannelBox.setMaximum(qMax(nc, 1u));
+    while ((unsigned) curves.size() > nc)
+    {
+        auto curve = curves.takeLast();
+        curve->detach();
+        delete curve;
+    }
+    updateCurveStyles();
+}
+
+void SpectrumView::updateCurveStyles()
+{
+    for (int ci = 0; ci < curves.size() && ci < (int) _stream->numChannels(); ci++)
+    {
+        auto ch = _stream->channel(ci);
+        curves[ci]->setTitle(ch->name());
+        curves[ci]->setPen(ch->color());
+        curves[ci]->setVisible(ch->visible());
+    }
+    plot.replot();
+}
+
+void SpectrumView::updateCurves()
+{
+    if ((unsigned) curves.size() != spectrum.numChannels())
+    {
+        updateCurveList();
+    }
+
+    unsigned nb = spectrum.numBins();
+    if ((unsigned) freqs.size() != nb)
+    {
+        freqs.resize(nb);
+        for (unsigned i = 0; i < nb; i++)
+        {
+            freqs[i] = double(i) / spectrum.fftSize();
+        }
+    }
+
+    for (int ci = 0; ci < curves.size(); ci++)
+    {
+        auto& mag = spectrum.magnitude(ci);
+        if (mag.isEmpty()) continue;
+        curves[ci]->setSamples(freqs.constData(), mag.constData(), nb);
+    }
+    plot.replot();
+
+    unsigned wci = waterfallChannelBox.value() - 1;
+    if (waterfall.isVisible() && wci < spectrum.numChannels())
+    {
+        auto& mag = spectrum.magnitude(wci);
+        waterfall.addRow(mag.constData(), mag.size());
+    }
+}
+
+void SpectrumView::onWaterfallRangeChanged()
+{
+    waterfall.setRange(rangeMinBox.value(), rangeMaxBox.value());
+}
+
+void SpectrumView::onFftSizeSelected(int index)
+{
+    spectrum.setFftSize(fftSizeBox.itemData(index).toUInt());
+}
+
+void SpectrumView::darkBackground(bool enabled)
+{
+    plot.setCanvasBackground(QBrush(enabled ? Qt::black : Qt::white));
+    plot.replot();
+}
@@ -0,0 +1,76 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPECTRUMVIEW_H
+#define SPECTRUMVIEW_H
+
+#include <QWidget>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QList>
+#include <qwt_plot.h>
+
+#include "stream.h"
+#include "plotmenu.h"
+#include "plotcurve.h"
+#include "spectrum.h"
+#include "waterfall.h"
+
+/// Displays magnitude spectrum of stream channels and optionally a
+/// waterfall of a selected channel
+class SpectrumView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumView(Stream* stream,
+                          PlotMenu* menu,
+                          QWidget* parent = 0);
+    ~SpectrumView();
+
+public slots:
+    /// Enable/disable dark background
+    void darkBackground(bool enabled);
+
+private:
+    Stream* _stream;
+    Spectrum spectrum;
+    QwtPlot plot;
+    QList<PlotCurve*> curves;
+    QComboBox fftSizeBox;
+    QSpinBox averagingBox;
+    QCheckBox waterfallBox;
+    QSpinBox waterfallChannelBox;
+    QSpinBox rangeMinBox;
+    QSpinBox rangeMaxBox;
+    Waterfall waterfall;
+    QVector<double> freqs;    ///< x values of bins
+
+    /// Creates/removes curves to match the channel count
+    void updateCurveList();
+
+private slots:
+    void updateCurves();
+    void updateCurveStyles();
+    void onFftSizeSelected(int index);
+    void onWaterfallRangeChanged();
+};
+
+#endif // SPECTRUMVIEW_H
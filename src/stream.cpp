@@ -17,16 +17,31 @@
 */
 
 #include "stream.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtDebug>
+
 #include "ringbuffer.h"
+#include "mappedbuffer.h"
 #include "indexbuffer.h"
 #include "linindexbuffer.h"
 
+/// Minimum interval between statistics updates of channel info model
+#define STATS_UPDATE_INTERVAL_MS 200
+
+const char Stream::PREVIOUS_BUFFER_DIR[] = "previous";
+const char Stream::OPEN_MARKER_FILE[] = "buffers.open";
+
 // Stream类的构造函数：初始化流数据（数据通道和样本数量）
 Stream::Stream(unsigned nc, bool x, unsigned ns) :
     _infoModel(nc)  // 初始化通道信息模型
 {
     _numSamples = ns;  // 设置样本数
     _paused = false;   // 默认未暂停数据流
+    _totalSamples = 0; // 尚未添加任何样本
+    _triggerEnabled = false; // 默认不使用触发模式
+    _applyGainOffset = true; // 默认由 Stream 应用增益和偏移
 
     xAsIndex = true;   // 默认将X轴作为索引
     xMin = 0;          // X轴最小值
@@ -48,9 +63,10 @@ Stream::Stream(unsigned nc, bool x, unsigned ns) :
     // 创建数据通道
     for (unsigned i = 0; i < nc; i++)
     {
-        auto c = new StreamChannel(i, xData, new RingBuffer(ns), &_infoModel);
+        auto c = new StreamChannel(i, xData, makeYBuffer(i), &_infoModel);
         channels.append(c);  // 将通道添加到列表中
     }
+    _stats.fill(ChannelStats(ns), nc);  // 每个通道的统计，窗口为缓冲区大小（有上限）
 }
 
 // Stream类的析构函数：释放所有通道和缓冲区
@@ -61,6 +77,7 @@ Stream::~Stream()
         delete ch;  // 删除每个数据通道
     }
     delete xData;  // 删除X轴数据缓冲区
+    closeBufferDirectory();  // 正常结束，删除标记文件
 }
 
 // 判断是否存在X轴数据
@@ -81,6 +98,12 @@ unsigned Stream::numSamples() const
     return _numSamples;
 }
 
+// 获取已添加的样本总数（每通道）
+quint64 Stream::totalSamples() const
+{
+    return _totalSamples;
+}
+
 // 获取指定索引的通道（只读）
 const StreamChannel* Stream::channel(unsigned index) const
 {
@@ -117,6 +140,39 @@ ChannelInfoModel* Stream::infoModel()
     return const_cast<ChannelInfoModel*>(static_cast<const Stream&>(*this).infoModel());
 }
 
+// 获取触发器
+Trigger* Stream::trigger()
+{
+    return &_trigger;
+}
+
+// 获取通道统计
+const ChannelStats& Stream::stats(unsigned index) const
+{
+    Q_ASSERT(index < numChannels());
+    return _stats[index];
+}
+
+// 将统计结果更新到通道信息模型
+void Stream::publishStats()
+{
+    _infoModel.updateStats(_stats);
+    statsTimer.restart();
+}
+
+// 是否启用了触发模式
+bool Stream::triggerEnabled() const
+{
+    return _triggerEnabled;
+}
+
+// 启用或禁用触发模式
+void Stream::setTriggerEnabled(bool enabled)
+{
+    _triggerEnabled = enabled;
+    _trigger.reset();
+}
+
 // 设置通道数目，并根据新的通道数进行适当调整
 void Stream::setNumChannels(unsigned nc, bool x)
 {
@@ -128,7 +184,7 @@ void Stream::setNumChannels(unsigned nc, bool x)
     {
         for (unsigned i = oldNum; i < nc; i++)
         {
-            auto c = new StreamChannel(i, xData, new RingBuffer(_numSamples), &_infoModel);
+            auto c = new StreamChannel(i, xData, makeYBuffer(i), &_infoModel);
             channels.append(c);  // 增加新的通道
         }
     }
@@ -162,7 +218,13 @@ void Stream::setNumChannels(unsigned nc, bool x)
 
     if (nc != oldNum)
     {
+        _stats.resize(nc);
+        for (auto& st : _stats)
+        {
+            st.setWindow(_numSamples);  // 通道数改变时重新开始统计
+        }
         _infoModel.setNumOfChannels(nc);  // 更新信息模型中的通道数
+        publishStats();
         emit numChannelsChanged(nc);  // 发出通道数变化的信号
     }
 
@@ -182,44 +244,121 @@ XFrameBuffer* Stream::makeXBuffer() const
     }
 }
 
-// 应用增益和偏移量，调整样本数据
-const SamplePack* Stream::applyGainOffset(const SamplePack& pack) const
+// 创建通道数据缓冲区：设置了缓冲区目录时使用内存映射文件
+WFrameBuffer* Stream::makeYBuffer(unsigned index) const
 {
-    Q_ASSERT(infoModel()->gainOrOffsetEn());  // 确保增益或偏移已启用
+    if (_bufferDir.isEmpty())
+    {
+        return new RingBuffer(_numSamples);
+    }
+    else
+    {
+        return new MappedBuffer(_numSamples, bufferFileName(_bufferDir, index));
+    }
+}
 
-    SamplePack* mPack = new SamplePack(pack);  // 创建样本副本
-    unsigned ns = pack.numSamples();  // 获取样本数
+QString Stream::bufferFileName(QString dir, unsigned index)
+{
+    return QString("%1/channel_%2%3").arg(dir).arg(index).arg(MappedBuffer::FILE_SUFFIX);
+}
 
-    for (unsigned ci = 0; ci < numChannels(); ci++)
+// 将上次会话留下的有效缓冲区文件移到子目录，避免被新缓冲区覆盖
+QStringList Stream::moveAsidePreviousBuffers(QString dir)
+{
+    QStringList files;
+    for (unsigned ci = 0; QFileInfo(bufferFileName(dir, ci)).isFile(); ci++)
     {
-        bool gainEn = infoModel()->gainEn(ci);  // 获取当前通道增益启用状态
-        bool offsetEn = infoModel()->offsetEn(ci);  // 获取当前通道偏移启用状态
-        if (gainEn || offsetEn)
+        QString error;
+        MappedBuffer* buf = MappedBuffer::open(bufferFileName(dir, ci), &error);
+        if (buf == nullptr)
         {
-            double* mdata = mPack->data(ci);  // 获取副本中的数据
-
-            double gain = infoModel()->gain(ci);  // 获取增益
-            double offset = infoModel()->offset(ci);  // 获取偏移
-
-            // 如果增益启用，应用增益
-            if (gainEn)
-            {
-                for (unsigned i = 0; i < ns; i++)
-                {
-                    mdata[i] *= gain;
-                }
-            }
-            // 如果偏移启用，应用偏移
-            if (offsetEn)
-            {
-                for (unsigned i = 0; i < ns; i++)
-                {
-                    mdata[i] += offset;
-                }
-            }
+            qWarning() << "Ignoring invalid buffer file" << bufferFileName(dir, ci) << ":" << error;
+            break;
         }
+        delete buf;
+        files << bufferFileName(dir, ci);
+    }
+    if (files.isEmpty()) return files;
+
+    // only one previous session is kept
+    QDir prevDir(QString("%1/%2").arg(dir).arg(PREVIOUS_BUFFER_DIR));
+    if (prevDir.exists()) prevDir.removeRecursively();
+    if (!QDir().mkpath(prevDir.path()))
+    {
+        qCritical() << "Couldn't create directory for previous buffers:" << prevDir.path();
+        return QStringList();
     }
 
+    QStringList moved;
+    for (auto f : files)
+    {
+        QString newName = prevDir.filePath(QFileInfo(f).fileName());
+        if (!QFile::rename(f, newName))
+        {
+            qCritical() << "Couldn't move previous buffer file:" << f;
+            break;
+        }
+        moved << newName;
+    }
+    return moved;
+}
+
+// 删除当前缓冲区目录的标记文件（正常关闭）
+void Stream::closeBufferDirectory()
+{
+    if (_bufferDir.isEmpty()) return;
+    QFile::remove(QString("%1/%2").arg(_bufferDir).arg(OPEN_MARKER_FILE));
+}
+
+QStringList Stream::previousBufferFiles() const
+{
+    return _previousBuffers;
+}
+
+// 设置缓冲区目录并重新创建所有通道的缓冲区
+void Stream::setBufferDirectory(QString dir)
+{
+    if (dir == _bufferDir) return;
+
+    if (!dir.isEmpty() && !QDir().mkpath(dir))
+    {
+        qCritical() << "Couldn't create buffer directory:" << dir;
+        return;
+    }
+    closeBufferDirectory();
+    _previousBuffers.clear();
+    _bufferDir = dir;
+
+    if (!dir.isEmpty())
+    {
+        // 标记文件仍存在说明上次会话没有正常结束，保留其缓冲区文件
+        QFile marker(QString("%1/%2").arg(dir).arg(OPEN_MARKER_FILE));
+        if (marker.exists()) _previousBuffers = moveAsidePreviousBuffers(dir);
+        if (!marker.open(QIODevice::WriteOnly))
+        {
+            qWarning() << "Couldn't create buffer directory marker:" << marker.fileName();
+        }
+    }
+
+    for (unsigned i = 0; i < numChannels(); i++)
+    {
+        delete channels[i];
+        channels[i] = new StreamChannel(i, xData, makeYBuffer(i), &_infoModel);
+    }
+}
+
+QString Stream::bufferDirectory() const
+{
+    return _bufferDir;
+}
+
+// 应用校准、增益和偏移量，调整样本数据
+const SamplePack* Stream::applyGainOffset(const SamplePack& pack) const
+{
+    Q_ASSERT(infoModel()->gainOrOffsetEn() || infoModel()->calibrationEn());  // 确保增益、偏移或校准已启用
+
+    SamplePack* mPack = new SamplePack(pack);  // 创建样本副本
+    infoModel()->apply(mPack);                 // 在副本上应用校准、增益和偏移
     return mPack;
 }
 
@@ -239,20 +378,50 @@ void Stream::feedIn(const SamplePack& pack)
 
     // 如果需要应用增益和偏移，修改样本数据
     const SamplePack* mPack = nullptr;
-    if (infoModel()->gainOrOffsetEn())
+    if (_applyGainOffset &&
+        (infoModel()->gainOrOffsetEn() || infoModel()->calibrationEn()))
         mPack = applyGainOffset(pack);
 
+    const SamplePack& gPack = (mPack == nullptr) ? pack : *mPack;  // 处理后的数据
+
+    // 触发模式下只有完整的触发帧写入缓冲区，绘图只在触发时更新
+    const SamplePack* bufPack = &gPack;
+    if (_triggerEnabled)
+    {
+        bufPack = _trigger.feed(gPack);
+    }
+
+    if (bufPack != nullptr)
+    {
+        ns = bufPack->numSamples();
+        for (unsigned ci = 0; ci < numChannels(); ci++)
+        {
+            auto buf = static_cast<WFrameBuffer*>(channels[ci]->yData());  // 获取数据通道的缓冲区
+            buf->addSamples(bufPack->data(ci), ns);  // 将数据添加到缓冲区
+        }
+        _totalSamples += ns;  // 更新样本计数
+    }
+
+    // 统计所有输入数据（包括触发帧以外的数据），逐样本增量更新
     for (unsigned ci = 0; ci < numChannels(); ci++)
     {
-        auto buf = static_cast<RingBuffer*>(channels[ci]->yData());  // 获取数据通道的缓冲区
-        double* data = (mPack == nullptr) ? pack.data(ci) : mPack->data(ci);  // 获取处理后的数据
-        buf->addSamples(data, ns);  // 将数据添加到缓冲区
+        _stats[ci].add(gPack.data(ci), pack.numSamples());
+    }
+    if (!statsTimer.isValid() || statsTimer.elapsed() >= STATS_UPDATE_INTERVAL_MS)
+    {
+        publishStats();
     }
 
-    Sink::feedIn((mPack == nullptr) ? pack : *mPack);  // 将数据传递给基类处理
+    Sink::feedIn(gPack);  // 将数据传递给基类处理（记录等仍然接收所有数据）
 
     if (mPack != nullptr) delete mPack;  // 释放副本
-    emit dataAdded();  // 发出数据添加的信号
+    if (bufPack != nullptr) emit dataAdded();  // 发出数据添加的信号
+}
+
+// 启用或禁用增益、偏移和校准的应用
+void Stream::setApplyGainOffset(bool enabled)
+{
+    _applyGainOffset = enabled;
 }
 
 // 暂停或恢复数据流
@@ -266,8 +435,14 @@ void Stream::clear()
 {
     for (auto c : channels)
     {
-        static_cast<RingBuffer*>(c->yData())->clear();  // 清空每个通道的数据
+        static_cast<WFrameBuffer*>(c->yData())->clear();  // 清空每个通道的数据
+    }
+    _trigger.reset();
+    for (auto& st : _stats)
+    {
+        st.clear();
     }
+    publishStats();
 }
 
 // 设置样本数目
@@ -279,8 +454,13 @@ void Stream::setNumSamples(unsigned value)
     xData->resize(value);  // 调整X轴数据的大小
     for (auto c : channels)
     {
-        static_cast<RingBuffer*>(c->yData())->resize(value);  // 调整每个通道缓冲区的大小
+        static_cast<WFrameBuffer*>(c->yData())->resize(value);  // 调整每个通道缓冲区的大小
+    }
+    for (auto& st : _stats)
+    {
+        st.setWindow(value);  // 统计窗口跟随缓冲区大小，但不超过 ChannelStats::MAX_WINDOW
     }
+    publishStats();
 }
 
 // 设置X轴的表示方式（索引或线性）
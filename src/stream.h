@@ -23,13 +23,17 @@
 #include <QObject>
 #include <QModelIndex>
 #include <QVector>
+#include <QStringList>
 #include <QSettings>
+#include <QElapsedTimer>
 
 #include "sink.h"
 #include "source.h"
 #include "channelinfomodel.h"
 #include "streamchannel.h"
 #include "framebuffer.h"
+#include "trigger.h"
+#include "channelstats.h"
 
 /**
  * Main waveform storage class. It consists of channels. Channels are
@@ -55,12 +59,58 @@ public:
     unsigned numChannels() const;
 
     unsigned numSamples() const;
+    /// Returns total number of samples (per channel) added to the
+    /// stream so far. Can be used to find out how many new samples
+    /// arrived since last check.
+    quint64 totalSamples() const;
     const StreamChannel* channel(unsigned index) const;
     StreamChannel* channel(unsigned index);
     QVector<const StreamChannel*> allChannels() const;
     const ChannelInfoModel* infoModel() const;
     ChannelInfoModel* infoModel();
 
+    /// Returns trigger settings, used only when trigger is enabled
+    Trigger* trigger();
+    bool triggerEnabled() const;
+
+    /**
+     * Enables applying calibration, gain and offset of channels to
+     * incoming data (enabled by default). Should be disabled when
+     * data is already processed by an earlier stage, see
+     * `Filter::setInfoModel()`.
+     */
+    void setApplyGainOffset(bool enabled);
+
+    /// Returns statistics of a channel. Window of the statistics is
+    /// the buffer size (`numSamples()`), capped at
+    /// `ChannelStats::MAX_WINDOW`.
+    const ChannelStats& stats(unsigned index) const;
+
+    /**
+     * Keeps channel data in memory-mapped files (one per channel) in
+     * given directory instead of memory. Empty string selects memory.
+     *
+     * While buffers are in `dir` a `OPEN_MARKER_FILE` is kept there,
+     * it's removed when the directory is left or the stream is
+     * destroyed. If the marker is found (previous session didn't end
+     * properly) valid buffer files in `dir` are not overwritten, they
+     * are moved into `PREVIOUS_BUFFER_DIR` sub directory, see
+     * `previousBufferFiles()`.
+     *
+     * @important Existing channel buffers are re-created, should be
+     * set before channels are given to plots.
+     */
+    void setBufferDirectory(QString dir);
+    QString bufferDirectory() const;
+
+    /// Sub directory of buffer directory that keeps previous session
+    static const char PREVIOUS_BUFFER_DIR[];
+    /// File in buffer directory that marks it in use
+    static const char OPEN_MARKER_FILE[];
+    /// Returns buffer files of a previous session that didn't end
+    /// properly in channel order, empty if there are none
+    QStringList previousBufferFiles() const;
+
     /// Saves channel information
     void saveSettings(QSettings* settings) const;
     /// Load channel information
@@ -92,11 +142,26 @@ public slots:
     /// Clears buffer data (fills with 0)
     void clear();
 
+    /**
+     * Enables trigger mode. When enabled only complete triggered
+     * frames are added to the buffers, followers still receive all
+     * the data.
+     */
+    void setTriggerEnabled(bool enabled);
+
 private:
     unsigned _numSamples;
     bool _paused;
+    quint64 _totalSamples;
+    bool _triggerEnabled;
+    bool _applyGainOffset;
+    Trigger _trigger;
+    QVector<ChannelStats> _stats;
+    QElapsedTimer statsTimer;   ///< limits stats updates of `_infoModel`
 
     bool _hasx;
+    QString _bufferDir;
+    QStringList _previousBuffers;
     XFrameBuffer* xData;
     QList<StreamChannel*> channels;
 
@@ -106,20 +171,33 @@ private:
     double xMin, xMax;
 
     /**
-     * Applies gain and offset to given pack.
+     * Applies calibration, gain and offset (in this order) to given pack.
      *
      * Caller is responsible for deleting returned `SamplePack`.
      *
-     * @note Should be called only when gain or offset is enabled. Guard with
-     * `ChannelInfoModel::gainOrOffsetEn()`.
+     * @note Should be called only when gain, offset or calibration is
+     * enabled. Guard with `ChannelInfoModel::gainOrOffsetEn()` and
+     * `ChannelInfoModel::calibrationEn()`.
      *
      * @param pack input data
      * @return modified data
      */
     const SamplePack* applyGainOffset(const SamplePack& pack) const;
 
+    /// Updates statistics columns of `_infoModel`
+    void publishStats();
+
     /// Returns a new virtual X buffer for settings
     XFrameBuffer* makeXBuffer() const;
+    /// Returns a new data buffer for given channel, see `setBufferDirectory()`
+    WFrameBuffer* makeYBuffer(unsigned index) const;
+    /// Returns buffer file name of a channel in given directory
+    static QString bufferFileName(QString dir, unsigned index);
+    /// Moves valid buffer files in `dir` to `PREVIOUS_BUFFER_DIR`,
+    /// returns new file names
+    static QStringList moveAsidePreviousBuffers(QString dir);
+    /// Removes `OPEN_MARKER_FILE` of current buffer directory
+    void closeBufferDirectory();
 };
 
 
@@ -0,0 +1,127 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QMutexLocker>
+
+#include "threadrelay.h"
+
+ThreadRelay::ThreadRelay(QObject* parent) :
+    QObject(parent)
+{
+    flushRequested = false;
+    pendingSamples = 0;
+    _droppedPacks = 0;
+    ncChanged = false;
+    pendingNc = _numChannels = 0;
+    pendingX = _hasX = false;
+}
+
+ThreadRelay::~ThreadRelay()
+{
+    qDeleteAll(pending);
+}
+
+bool ThreadRelay::hasX() const
+{
+    return _hasX;
+}
+
+unsigned ThreadRelay::numChannels() const
+{
+    return _numChannels;
+}
+
+quint64 ThreadRelay::droppedPacks() const
+{
+    QMutexLocker locker(&mutex);
+    return _droppedPacks;
+}
+
+void ThreadRelay::requestFlush()
+{
+    if (flushRequested) return;
+
+    flushRequested = true;
+    QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+}
+
+void ThreadRelay::feedIn(const SamplePack& data)
+{
+    unsigned size = data.numSamples() * data.numChannels();
+    {
+        QMutexLocker locker(&mutex);
+        // a single pack is always accepted into an empty queue
+        if (!pending.isEmpty() && pendingSamples + size > MAX_PENDING_SAMPLES)
+        {
+            _droppedPacks++;
+            return;
+        }
+    }
+
+    // copy outside of the lock
+    auto copy = new SamplePack(data);
+
+    QMutexLocker locker(&mutex);
+    pending.append(copy);
+    pendingSamples += size;
+    requestFlush();
+}
+
+void ThreadRelay::setNumChannels(unsigned nc, bool x)
+{
+    QMutexLocker locker(&mutex);
+    // data queued with previous number of channels is dropped
+    qDeleteAll(pending);
+    pending.clear();
+    pendingSamples = 0;
+    pendingNc = nc;
+    pendingX = x;
+    ncChanged = true;
+    requestFlush();
+}
+
+void ThreadRelay::flush()
+{
+    QList<SamplePack*> packs;
+    bool changed;
+    {
+        QMutexLocker locker(&mutex);
+        packs.swap(pending);
+        pendingSamples = 0;
+        changed = ncChanged;
+        ncChanged = false;
+        flushRequested = false;
+        if (changed)
+        {
+            _numChannels = pendingNc;
+            _hasX = pendingX;
+        }
+    }
+
+    if (changed) updateNumChannels();
+
+    for (auto pack : packs)
+    {
+        if (pack->numChannels() == _numChannels)
+        {
+            feedOut(*pack);
+        }
+        delete pack;
+    }
+}
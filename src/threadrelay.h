@@ -0,0 +1,87 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef THREADRELAY_H
+#define THREADRELAY_H
+
+#include <QObject>
+#include <QMutex>
+#include <QList>
+
+#include "sink.h"
+#include "source.h"
+
+/**
+ * Passes data from a source running in another thread to sinks in the
+ * thread of this object.
+ *
+ * `feedIn()` and `setNumChannels()` can be called from any thread,
+ * data is queued and fed out from the event loop of the relay's
+ * thread. Multiple packs received before the event loop gets to run
+ * are fed out together.
+ *
+ * Queue is limited to `MAX_PENDING_SAMPLES`, packs arriving while it's
+ * full (relay's thread can't keep up) are dropped and counted.
+ */
+class ThreadRelay : public QObject, public Sink, public Source
+{
+    Q_OBJECT
+
+public:
+    /// Maximum number of samples (of all channels) waiting in the queue
+    static const unsigned MAX_PENDING_SAMPLES = 1 << 22;
+
+    explicit ThreadRelay(QObject* parent = 0);
+    ~ThreadRelay();
+
+    /// Number of packs dropped because the queue was full, thread safe
+    quint64 droppedPacks() const;
+
+    // implementations for `Source`
+    bool hasX() const override;
+    unsigned numChannels() const override;
+
+protected:
+    // implementations for `Sink`, thread safe
+    void feedIn(const SamplePack& data) override;
+    void setNumChannels(unsigned nc, bool x) override;
+
+private:
+    mutable QMutex mutex;
+    // following are protected by `mutex`
+    QList<SamplePack*> pending;
+    unsigned pendingSamples;    ///< total samples of `pending` packs
+    quint64 _droppedPacks;
+    bool flushRequested;
+    bool ncChanged;
+    unsigned pendingNc;
+    bool pendingX;
+
+    unsigned _numChannels;
+    bool _hasX;
+
+    /// Requests `flush()` from the event loop, `mutex` must be locked
+    void requestFlush();
+
+private slots:
+    /// Feeds out queued data in relay's thread
+    void flush();
+};
+
+#endif // THREADRELAY_H
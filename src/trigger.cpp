@@ -0,0 +1,288 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <QtGlobal>
+
+#include "trigger.h"
+
+/// Number of samples checked at once by `findCrossing`
+#define SCAN_BLOCK_SIZE (16)
+
+/// Returns 1 if there is a crossing between `prev` and `cur`
+static inline int isCrossing(double prev, double cur, double level,
+                             int rising, int falling)
+{
+    return (rising & (prev < level) & (cur >= level)) |
+        (falling & (prev >= level) & (cur < level));
+}
+
+/**
+ * Finds the first `level` crossing in `data[from, n)`. A crossing at
+ * index `i` is between samples `i-1` and `i`.
+ *
+ * Data is checked in blocks without branching so that the inner loop
+ * can be vectorized by the compiler. Block containing the crossing is
+ * then checked one by one.
+ *
+ * @return index of the sample after the crossing or -1 if not found
+ */
+static int findCrossing(const double* data, int from, int n, double level,
+                        Trigger::Edge edge)
+{
+    const int rising = edge != Trigger::Falling;
+    const int falling = edge != Trigger::Rising;
+
+    int i = std::max(from, 1);
+    for (; i + SCAN_BLOCK_SIZE <= n; i += SCAN_BLOCK_SIZE)
+    {
+        int found = 0;
+        for (int j = i; j < i + SCAN_BLOCK_SIZE; j++)
+        {
+            found |= isCrossing(data[j-1], data[j], level, rising, falling);
+        }
+        if (found) break;
+    }
+
+    for (; i < n; i++)
+    {
+        if (isCrossing(data[i-1], data[i], level, rising, falling)) return i;
+    }
+
+    return -1;
+}
+
+Trigger::Trigger()
+{
+    _channel = 0;
+    _edge = Rising;
+    _level = 0;
+    _mode = Auto;
+    _preDepth = 0;
+    _postDepth = 1;
+    _armed = true;
+    scanPos = 0;
+    triggerPos = -1;
+    sinceLastFrame = 0;
+    frame = nullptr;
+}
+
+Trigger::~Trigger()
+{
+    if (frame != nullptr) delete frame;
+}
+
+unsigned Trigger::channel() const
+{
+    return _channel;
+}
+
+Trigger::Edge Trigger::edge() const
+{
+    return _edge;
+}
+
+double Trigger::level() const
+{
+    return _level;
+}
+
+Trigger::Mode Trigger::mode() const
+{
+    return _mode;
+}
+
+unsigned Trigger::preDepth() const
+{
+    return _preDepth;
+}
+
+unsigned Trigger::postDepth() const
+{
+    return _postDepth;
+}
+
+unsigned Trigger::frameLength() const
+{
+    return _preDepth + _postDepth;
+}
+
+bool Trigger::isArmed() const
+{
+    return _armed;
+}
+
+void Trigger::setChannel(unsigned channel)
+{
+    _channel = channel;
+    arm();
+}
+
+void Trigger::setEdge(Edge edge)
+{
+    _edge = edge;
+}
+
+void Trigger::setLevel(double level)
+{
+    _level = level;
+}
+
+void Trigger::setMode(Mode mode)
+{
+    _mode = mode;
+    arm();
+}
+
+void Trigger::setDepth(unsigned pre, unsigned post)
+{
+    Q_ASSERT(pre + post > 0);
+
+    _preDepth = pre;
+    _postDepth = post;
+    arm();
+}
+
+void Trigger::arm()
+{
+    _armed = true;
+    triggerPos = -1;
+    sinceLastFrame = 0;
+}
+
+void Trigger::reset()
+{
+    buffer.clear();
+    scanPos = 0;
+    arm();
+}
+
+unsigned Trigger::bufferSize() const
+{
+    return buffer.isEmpty() ? 0 : buffer[0].size();
+}
+
+const SamplePack* Trigger::feed(const SamplePack& pack)
+{
+    const unsigned nc = pack.numChannels();
+    const unsigned ns = pack.numSamples();
+
+    if ((unsigned) buffer.size() != nc)
+    {
+        reset();
+        buffer.resize(nc);
+    }
+
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        const double* data = pack.data(ci);
+        buffer[ci].reserve(buffer[ci].size() + ns);
+        for (unsigned i = 0; i < ns; i++)
+        {
+            buffer[ci].append(data[i]);
+        }
+    }
+    sinceLastFrame += ns;
+
+    const int size = bufferSize();
+    const unsigned ch = std::min(_channel, nc - 1);
+    bool published = false;
+
+    while (_armed)
+    {
+        if (triggerPos < 0)
+        {
+            int t = findCrossing(buffer[ch].constData(), scanPos, size, _level, _edge);
+            if (t < 0)
+            {
+                scanPos = size;
+                break;
+            }
+            // not enough samples before trigger point (just started)
+            if (t < (int) _preDepth)
+            {
+                scanPos = t + 1;
+                continue;
+            }
+            triggerPos = t;
+        }
+
+        // wait for post trigger samples
+        if (size < triggerPos + (int) _postDepth) break;
+
+        copyFrame(triggerPos - _preDepth);
+        published = true;
+        // with no post trigger samples, step over the trigger point
+        scanPos = triggerPos + std::max((int) _postDepth, 1);
+        triggerPos = -1;
+
+        if (_mode == Single) _armed = false;
+    }
+
+    if (!_armed) scanPos = size;
+
+    // free running when there is no trigger for a frame length
+    if (!published && _mode == Auto && triggerPos < 0 &&
+        sinceLastFrame >= frameLength() && size >= (int) frameLength())
+    {
+        copyFrame(size - frameLength());
+        published = true;
+    }
+
+    if (published) sinceLastFrame = 0;
+
+    trimBuffer();
+
+    return published ? frame : nullptr;
+}
+
+void Trigger::copyFrame(unsigned start)
+{
+    const unsigned nc = buffer.size();
+    const unsigned len = frameLength();
+
+    if (frame == nullptr || frame->numChannels() != nc || frame->numSamples() != len)
+    {
+        if (frame != nullptr) delete frame;
+        frame = new SamplePack(len, nc);
+    }
+
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        std::copy_n(buffer[ci].constData() + start, len, frame->data(ci));
+    }
+}
+
+void Trigger::trimBuffer()
+{
+    const int size = bufferSize();
+
+    // keep history for pre trigger samples and previous sample for crossing check
+    int keepFrom = (triggerPos < 0 ? scanPos : triggerPos) - (int) _preDepth - 1;
+    // keep a frame length for auto mode
+    keepFrom = std::min(keepFrom, size - (int) frameLength());
+    if (keepFrom <= 0) return;
+
+    for (auto& data : buffer)
+    {
+        data.remove(0, keepFrom);
+    }
+    scanPos -= keepFrom;
+    if (triggerPos >= 0) triggerPos -= keepFrom;
+}
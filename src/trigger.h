@@ -0,0 +1,116 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRIGGER_H
+#define TRIGGER_H
+
+#include <QVector>
+
+#include "samplepack.h"
+
+/**
+ * Oscilloscope like trigger engine.
+ *
+ * Incoming data is scanned for `level` crossings on the trigger
+ * channel. When a crossing is found, a frame consisting of
+ * `preDepth` samples before the crossing and `postDepth` samples
+ * after (including) the crossing is captured. Only complete frames
+ * are published.
+ *
+ * In `Normal` mode frames are captured only on trigger. `Auto` mode
+ * publishes the latest samples as an (untriggered) frame if there is
+ * no trigger for a frame length. In `Single` mode trigger is disarmed
+ * after the first frame and should be re-armed with `arm()`.
+ */
+class Trigger
+{
+public:
+    enum Edge
+    {
+        Rising,
+        Falling,
+        Both
+    };
+
+    enum Mode
+    {
+        Auto,
+        Normal,
+        Single
+    };
+
+    Trigger();
+    ~Trigger();
+
+    unsigned channel() const;
+    Edge edge() const;
+    double level() const;
+    Mode mode() const;
+    unsigned preDepth() const;
+    unsigned postDepth() const;
+    /// Returns frame length (`preDepth + postDepth`)
+    unsigned frameLength() const;
+    /// Returns `false` if disarmed after a frame in single mode
+    bool isArmed() const;
+
+    void setChannel(unsigned channel);
+    void setEdge(Edge edge);
+    void setLevel(double level);
+    /// Changing mode re-arms the trigger
+    void setMode(Mode mode);
+    /// Sets number of samples captured before and after trigger point.
+    void setDepth(unsigned pre, unsigned post);
+
+    /// Re-arms the trigger, discards any partially captured frame
+    void arm();
+    /// Discards all stored samples and partially captured frame
+    void reset();
+
+    /**
+     * Feeds new samples to the trigger.
+     *
+     * @return latest frame that is completed with this data or
+     * `nullptr` if none. Returned pack is owned by `Trigger` and
+     * stays valid until next call.
+     */
+    const SamplePack* feed(const SamplePack& pack);
+
+private:
+    unsigned _channel;
+    Edge _edge;
+    double _level;
+    Mode _mode;
+    unsigned _preDepth, _postDepth;
+    bool _armed;
+
+    /// Stored samples of each channel, oldest first
+    QVector<QVector<double>> buffer;
+    int scanPos;    ///< index in `buffer` to continue trigger search
+    int triggerPos; ///< index of captured trigger point, -1 if none
+    unsigned sinceLastFrame; ///< number of samples since last published frame
+    SamplePack* frame;
+
+    unsigned bufferSize() const;
+    /// Copies a frame starting from `start` into `frame`
+    void copyFrame(unsigned start);
+    /// Drops samples that won't be needed anymore
+    void trimBuffer();
+};
+
+#endif // TRIGGER_H
@@ -0,0 +1,161 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "triggerpanel.h"
+#include "ui_triggerpanel.h"
+
+#include "setting_defines.h"
+#include "utils.h"
+
+TriggerPanel::TriggerPanel(Stream* stream, QWidget *parent) :
+    QWidget(parent),
+    ui(new Ui::TriggerPanel)
+{
+    _stream = stream;
+    ui->setupUi(this);
+
+    connect(ui->cbEnable, &QCheckBox::toggled, _stream, &Stream::setTriggerEnabled);
+
+    connect(ui->spChannel, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int value)
+            {
+                _stream->trigger()->setChannel(value - 1);
+            });
+
+    connect(ui->cbEdge, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            [this](int index)
+            {
+                _stream->trigger()->setEdge((Trigger::Edge) index);
+            });
+
+    connect(ui->spLevel, SELECT<double>::OVERLOAD_OF(&QDoubleSpinBox::valueChanged),
+            [this](double value)
+            {
+                _stream->trigger()->setLevel(value);
+            });
+
+    connect(ui->spPreDepth, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int)
+            {
+                updateDepth();
+            });
+    connect(ui->spPostDepth, SELECT<int>::OVERLOAD_OF(&QSpinBox::valueChanged),
+            [this](int)
+            {
+                updateDepth();
+            });
+
+    connect(ui->cbMode, SELECT<int>::OVERLOAD_OF(&QComboBox::currentIndexChanged),
+            [this](int index)
+            {
+                _stream->trigger()->setMode((Trigger::Mode) index);
+                ui->pbArm->setEnabled(index == Trigger::Single);
+                updateStatus();
+            });
+
+    connect(ui->pbArm, &QPushButton::clicked, [this]()
+            {
+                _stream->trigger()->arm();
+                updateStatus();
+            });
+
+    connect(_stream, &Stream::numChannelsChanged, this, &TriggerPanel::onNumChannelsChanged);
+    connect(_stream, &Stream::dataAdded, this, &TriggerPanel::updateStatus);
+
+    // apply initial settings
+    onNumChannelsChanged(_stream->numChannels());
+    _stream->trigger()->setLevel(ui->spLevel->value());
+    updateDepth();
+    ui->pbArm->setEnabled(false);
+    updateStatus();
+}
+
+TriggerPanel::~TriggerPanel()
+{
+    delete ui;
+}
+
+void TriggerPanel::setNumOfSamples(int value)
+{
+    ui->spPreDepth->setMaximum(value - 1);
+    updateDepth();
+}
+
+void TriggerPanel::updateDepth()
+{
+    int maxPost = ui->spPreDepth->maximum() + 1 - ui->spPreDepth->value();
+    // fill the plot width if post trigger depth was at its limit
+    bool fill = ui->spPostDepth->value() == ui->spPostDepth->maximum();
+    ui->spPostDepth->blockSignals(true);
+    ui->spPostDepth->setMaximum(maxPost);
+    if (fill) ui->spPostDepth->setValue(maxPost);
+    ui->spPostDepth->blockSignals(false);
+
+    _stream->trigger()->setDepth(ui->spPreDepth->value(), ui->spPostDepth->value());
+}
+
+void TriggerPanel::updateStatus()
+{
+    if (_stream->trigger()->isArmed())
+    {
+        ui->lStatus->setText("Armed");
+    }
+    else
+    {
+        ui->lStatus->setText("Stopped");
+    }
+}
+
+void TriggerPanel::onNumChannelsChanged(unsigned value)
+{
+    ui->spChannel->setMaximum(value);
+}
+
+void TriggerPanel::saveSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Trigger);
+    settings->setValue(SG_Trigger_Enabled, ui->cbEnable->isChecked());
+    settings->setValue(SG_Trigger_Channel, ui->spChannel->value());
+    settings->setValue(SG_Trigger_Edge, ui->cbEdge->currentIndex());
+    settings->setValue(SG_Trigger_Level, ui->spLevel->value());
+    settings->setValue(SG_Trigger_PreDepth, ui->spPreDepth->value());
+    settings->setValue(SG_Trigger_PostDepth, ui->spPostDepth->value());
+    settings->setValue(SG_Trigger_Mode, ui->cbMode->currentIndex());
+    settings->endGroup();
+}
+
+void TriggerPanel::loadSettings(QSettings* settings)
+{
+    settings->beginGroup(SettingGroup_Trigger);
+    ui->spChannel->setValue(
+        settings->value(SG_Trigger_Channel, ui->spChannel->value()).toInt());
+    ui->cbEdge->setCurrentIndex(
+        settings->value(SG_Trigger_Edge, ui->cbEdge->currentIndex()).toInt());
+    ui->spLevel->setValue(
+        settings->value(SG_Trigger_Level, ui->spLevel->value()).toDouble());
+    ui->spPreDepth->setValue(
+        settings->value(SG_Trigger_PreDepth, ui->spPreDepth->value()).toInt());
+    ui->spPostDepth->setValue(
+        settings->value(SG_Trigger_PostDepth, ui->spPostDepth->value()).toInt());
+    ui->cbMode->setCurrentIndex(
+        settings->value(SG_Trigger_Mode, ui->cbMode->currentIndex()).toInt());
+    ui->cbEnable->setChecked(
+        settings->value(SG_Trigger_Enabled, ui->cbEnable->isChecked()).toBool());
+    settings->endGroup();
+}
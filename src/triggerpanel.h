@@ -0,0 +1,63 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TRIGGERPANEL_H
+#define TRIGGERPANEL_H
+
+#include <QWidget>
+#include <QSettings>
+
+#include "stream.h"
+
+namespace Ui {
+class TriggerPanel;
+}
+
+/// Settings panel for `Stream` trigger
+class TriggerPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TriggerPanel(Stream* stream, QWidget *parent = 0);
+    ~TriggerPanel();
+
+    /// Stores settings into a `QSettings`
+    void saveSettings(QSettings* settings);
+    /// Loads settings from a `QSettings`.
+    void loadSettings(QSettings* settings);
+
+public slots:
+    /// Limits trigger depth to plot width
+    void setNumOfSamples(int value);
+
+private:
+    Ui::TriggerPanel *ui;
+    Stream* _stream;
+
+    /// Updates post trigger depth limit and applies depth to trigger
+    void updateDepth();
+    /// Updates the armed/stopped status display
+    void updateStatus();
+
+private slots:
+    void onNumChannelsChanged(unsigned value);
+};
+
+#endif // TRIGGERPANEL_H
@@ -0,0 +1,99 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtDebug>
+
+#include "udpdevice.h"
+
+/// Initial capacity of the receive buffer
+const int INITIAL_BUFFER_SIZE = 64 * 1024;
+
+UdpDevice::UdpDevice(QObject* parent) :
+    BufferedInputDevice(parent)
+{
+    _datagramsReceived = 0;
+
+    connect(&socket, &QUdpSocket::readyRead, this, &UdpDevice::onSocketReadyRead);
+    connect(&socket, SIGNAL(error(QAbstractSocket::SocketError)),
+            this, SLOT(onSocketError(QAbstractSocket::SocketError)));
+}
+
+bool UdpDevice::bind(quint16 port, const QHostAddress& address)
+{
+    if (isOpen()) close();
+
+    if (!socket.bind(address, port))
+    {
+        setErrorString(socket.errorString());
+        return false;
+    }
+    socket.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,
+                           SOCKET_BUFFER_SIZE);
+
+    resetBuffer(INITIAL_BUFFER_SIZE);
+    _datagramsReceived = 0;
+
+    // unbuffered: `read()` is served directly from the receive buffer
+    return open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+quint16 UdpDevice::localPort() const
+{
+    return socket.localPort();
+}
+
+quint64 UdpDevice::datagramsReceived() const
+{
+    return _datagramsReceived;
+}
+
+void UdpDevice::close()
+{
+    socket.close();
+    resetBuffer();
+    QIODevice::close();
+}
+
+void UdpDevice::onSocketReadyRead()
+{
+    compactBuffer();
+
+    bool received = false;
+    while (socket.hasPendingDatagrams())
+    {
+        qint64 size = socket.pendingDatagramSize();
+        if (size < 0) break;
+
+        qint64 read = socket.readDatagram(beginAppend(size), size);
+        endAppend(read);
+        if (read > 0)
+        {
+            _datagramsReceived++;
+            received = true;
+        }
+    }
+
+    if (received) emit readyRead();
+}
+
+void UdpDevice::onSocketError(QAbstractSocket::SocketError error)
+{
+    Q_UNUSED(error);
+    qWarning() << "UDP socket error:" << socket.errorString();
+}
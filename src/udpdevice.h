@@ -0,0 +1,72 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UDPDEVICE_H
+#define UDPDEVICE_H
+
+#include <QUdpSocket>
+#include <QHostAddress>
+
+#include "bufferedinputdevice.h"
+
+/**
+ * Sequential read only device that receives UDP datagrams.
+ *
+ * `QUdpSocket` can only be read with `read()` when it's connected to
+ * a single peer. This device accepts datagrams from any sender and
+ * presents them as a continuous byte stream so that it can be used
+ * with any of the readers.
+ *
+ * Datagrams are received directly at the end of the internal buffer
+ * (see `BufferedInputDevice`), there is no intermediate datagram
+ * object.
+ */
+class UdpDevice : public BufferedInputDevice
+{
+    Q_OBJECT
+
+public:
+    /// Size of the socket receive buffer requested from the OS
+    static const int SOCKET_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    explicit UdpDevice(QObject* parent = 0);
+
+    /**
+     * Binds to given port and opens the device for reading.
+     *
+     * @param port 0 selects a free port, see `localPort()`
+     */
+    bool bind(quint16 port, const QHostAddress& address = QHostAddress::Any);
+    quint16 localPort() const;
+    /// Number of datagrams received since bind
+    quint64 datagramsReceived() const;
+
+    // reimplemented from QIODevice
+    void close() override;
+
+private:
+    QUdpSocket socket;
+    quint64 _datagramsReceived;
+
+private slots:
+    void onSocketReadyRead();
+    void onSocketError(QAbstractSocket::SocketError error);
+};
+
+#endif // UDPDEVICE_H
@@ -0,0 +1,129 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QPainter>
+#include <QColor>
+
+#include "waterfall.h"
+
+/// Number of colors in color map
+#define NUM_COLORS 256
+
+Waterfall::Waterfall(QWidget* parent) :
+    QWidget(parent)
+{
+    head = 0;
+    rowSize = 0;
+    rangeMin = -120;
+    rangeMax = 0;
+
+    // dark blue -> blue -> cyan -> yellow -> red
+    const QColor stops[] = {QColor(0, 0, 32), QColor(0, 0, 255), QColor(0, 255, 255),
+                            QColor(255, 255, 0), QColor(255, 0, 0)};
+    const int numStops = sizeof(stops) / sizeof(stops[0]);
+    colorMap.resize(NUM_COLORS);
+    for (int i = 0; i < NUM_COLORS; i++)
+    {
+        double pos = double(i) / (NUM_COLORS - 1) * (numStops - 1);
+        int s = qMin(int(pos), numStops - 2);
+        double t = pos - s;
+        colorMap[i] = qRgb(stops[s].red() + (stops[s+1].red() - stops[s].red()) * t,
+                           stops[s].green() + (stops[s+1].green() - stops[s].green()) * t,
+                           stops[s].blue() + (stops[s+1].blue() - stops[s].blue()) * t);
+    }
+
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+QSize Waterfall::sizeHint() const
+{
+    return QSize(400, 200);
+}
+
+void Waterfall::clear()
+{
+    image = QImage();
+    head = 0;
+    update();
+}
+
+void Waterfall::setRange(double min, double max)
+{
+    rangeMin = min;
+    rangeMax = max;
+}
+
+void Waterfall::addRow(const double* values, unsigned size)
+{
+    if (size == 0) return;
+
+    if (size != rowSize || image.isNull())
+    {
+        rowSize = size;
+        int cols = qMin(size, (unsigned) MAX_COLUMNS);
+        image = QImage(cols, HISTORY, QImage::Format_RGB32);
+        image.fill(colorMap[0]);
+        head = 0;
+    }
+
+    // newest row is written above the previous one
+    head = (head + HISTORY - 1) % HISTORY;
+
+    QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(head));
+    const int cols = image.width();
+    const double scale = rangeMax > rangeMin ? (NUM_COLORS - 1) / (rangeMax - rangeMin) : 0;
+    for (int c = 0; c < cols; c++)
+    {
+        unsigned start = quint64(c) * size / cols;
+        unsigned end = qMax(unsigned(quint64(c + 1) * size / cols), start + 1);
+        double v = values[start];
+        for (unsigned i = start + 1; i < end; i++)
+        {
+            v = qMax(v, values[i]);
+        }
+        int ci = int((v - rangeMin) * scale);
+        line[c] = colorMap[qBound(0, ci, NUM_COLORS - 1)];
+    }
+
+    update();
+}
+
+void Waterfall::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    if (image.isNull())
+    {
+        painter.fillRect(rect(), colorMap[0]);
+        return;
+    }
+
+    // image is drawn in two parts: [head, HISTORY) on top, then [0, head)
+    const double rowHeight = double(height()) / HISTORY;
+    const int topRows = HISTORY - head;
+    QRectF top(0, 0, width(), topRows * rowHeight);
+    QRectF bottom(0, top.bottom(), width(), head * rowHeight);
+
+    painter.drawImage(top, image, QRectF(0, head, image.width(), topRows));
+    if (head > 0)
+    {
+        painter.drawImage(bottom, image, QRectF(0, 0, image.width(), head));
+    }
+}
@@ -0,0 +1,76 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WATERFALL_H
+#define WATERFALL_H
+
+#include <QWidget>
+#include <QImage>
+#include <QVector>
+
+/**
+ * Spectrogram display.
+ *
+ * Rows are written into a fixed size circular image. Each new row
+ * is colorized once, when it's added; older rows are never touched
+ * again. Display scrolls by changing the row where the image is
+ * split while drawing, so drawing cost doesn't depend on history
+ * length. Newest row is at the top.
+ */
+class Waterfall : public QWidget
+{
+    Q_OBJECT
+
+public:
+    /// Maximum number of columns, wider rows are reduced to this
+    static const int MAX_COLUMNS = 1024;
+    /// Number of rows kept in history
+    static const int HISTORY = 2048;
+
+    explicit Waterfall(QWidget* parent = 0);
+
+    QSize sizeHint() const override;
+
+public slots:
+    /**
+     * Adds a new row to the top. Values are reduced to image width
+     * by taking the maximum of each column. Image is cleared if row
+     * length is different than the previous row.
+     *
+     * @param values values in dB
+     * @param size number of values
+     */
+    void addRow(const double* values, unsigned size);
+    /// Sets the value range mapped to colors
+    void setRange(double min, double max);
+    /// Clears history
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QImage image;
+    int head;               ///< row index of newest row
+    unsigned rowSize;       ///< length of last added row
+    double rangeMin, rangeMax;
+    QVector<QRgb> colorMap;
+};
+
+#endif // WATERFALL_H
@@ -0,0 +1,153 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <QtGlobal>
+
+#include "alignmentdetector.h"
+
+#include "catch.hpp"
+
+template <typename T>
+static void put(std::vector<uchar>& v, T value)
+{
+    uchar b[sizeof(T)];
+    memcpy(b, &value, sizeof(T)); // assumes little endian host
+    v.insert(v.end(), b, b + sizeof(T));
+}
+
+/// Generates `n` packages of `nc` int16 sine channels with different amplitudes
+static std::vector<uchar> sineInt16(unsigned n, unsigned nc)
+{
+    std::vector<uchar> v;
+    for (unsigned i = 0; i < n; i++)
+    {
+        for (unsigned c = 0; c < nc; c++)
+        {
+            put<qint16>(v, 1000 * (c + 1) * sin(i * 0.05 + c));
+        }
+    }
+    return v;
+}
+
+TEST_CASE("aligned data locks without skipping", "[align]")
+{
+    FrameLayout layout(3, NumberFormat_int16);
+    auto data = sineInt16(200, 3);
+
+    AlignmentDetector detector;
+    REQUIRE(detector.isCheckDue());
+    REQUIRE(detector.check(layout, data.data(), data.size()) == 0);
+    REQUIRE(detector.isLocked());
+    REQUIRE(detector.confidence() > 0.5);
+    // once locked checks are periodic
+    REQUIRE(!detector.isCheckDue());
+}
+
+TEST_CASE("misaligned bytes are detected", "[align]")
+{
+    FrameLayout layout(3, NumberFormat_int16);
+    auto data = sineInt16(200, 3);
+
+    AlignmentDetector detector;
+    // stream starts in the middle of a sample
+    for (unsigned skip : {1, 3, 5})
+    {
+        detector.reset();
+        unsigned offset = detector.check(layout, data.data() + skip, data.size() - skip);
+        REQUIRE((skip + offset) % 2 == 0);
+        REQUIRE(offset != 0);
+        REQUIRE(detector.isLocked());
+    }
+}
+
+TEST_CASE("misaligned floats are detected", "[align]")
+{
+    FrameLayout layout(2, NumberFormat_float);
+    std::vector<uchar> data;
+    for (unsigned i = 0; i < 100; i++)
+    {
+        put<float>(data, sin(i * 0.1));
+        put<float>(data, 10 * cos(i * 0.03));
+    }
+
+    AlignmentDetector detector;
+    unsigned offset = detector.check(layout, data.data() + 2, data.size() - 2);
+    REQUIRE((offset + 2) % 4 == 0);
+    REQUIRE(detector.confidence() > 0.5);
+}
+
+TEST_CASE("channel order is fixed for mixed layouts", "[align]")
+{
+    FrameLayout layout;
+    REQUIRE(layout.parse("int16 raw; float temp"));
+    std::vector<uchar> data;
+    for (unsigned i = 0; i < 100; i++)
+    {
+        put<qint16>(data, 3000 * sin(i * 0.07));
+        put<float>(data, 20 + cos(i * 0.02));
+    }
+
+    AlignmentDetector detector;
+    // starts at `temp`
+    unsigned offset = detector.check(layout, data.data() + 2, data.size() - 2);
+    REQUIRE(offset == 4);
+    REQUIRE(detector.isLocked());
+}
+
+TEST_CASE("channel rotation of same types is kept", "[align]")
+{
+    FrameLayout layout(4, NumberFormat_int16);
+    auto data = sineInt16(200, 4);
+
+    AlignmentDetector detector;
+    // starts at channel 1, indistinguishable from channel 0
+    REQUIRE(detector.check(layout, data.data() + 2, data.size() - 2) == 0);
+    REQUIRE(detector.isLocked());
+}
+
+TEST_CASE("noise doesn't lock", "[align]")
+{
+    FrameLayout layout(2, NumberFormat_uint16);
+    std::vector<uchar> data;
+    quint32 x = 12345;
+    for (unsigned i = 0; i < 1000; i++)
+    {
+        x = x * 1103515245 + 12345;
+        data.push_back(x >> 16);
+    }
+
+    AlignmentDetector detector;
+    REQUIRE(detector.check(layout, data.data(), data.size()) == 0);
+    REQUIRE(!detector.isLocked());
+    REQUIRE(detector.isCheckDue());
+}
+
+TEST_CASE("too little data isn't checked", "[align]")
+{
+    FrameLayout layout(2, NumberFormat_int16);
+    auto data = sineInt16(AlignmentDetector::MIN_PACKAGES, 2);
+
+    AlignmentDetector detector;
+    REQUIRE(detector.check(layout, data.data(), data.size()) == 0);
+    REQUIRE(!detector.isLocked());
+    REQUIRE(detector.confidence() == 0);
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+
+#include "bytestuffing.h"
+
+#include "catch.hpp"
+
+static QByteArray bytes(std::initializer_list<int> list)
+{
+    QByteArray r;
+    for (int b : list) r.append(char(b));
+    return r;
+}
+
+/// Decodes an encoded packet including the delimiter
+static QByteArray decode(QByteArray packet, bool cobs)
+{
+    packet.chop(1);
+    uchar* data = (uchar*) packet.data();
+    int n = cobs ? cobsDecode(data, packet.size()) : slipDecode(data, packet.size());
+    if (n < 0) return QByteArray("error");
+    return packet.left(n);
+}
+
+static QByteArray randomPacket(unsigned size, quint32& seed)
+{
+    QByteArray r;
+    for (unsigned i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        // plenty of special bytes
+        static const int special[] = {0x00, 0xC0, 0xDB, 0xDC, 0xDD};
+        int v = seed >> 16;
+        r.append(char((v & 3) == 0 ? special[(v >> 2) % 5] : v >> 8));
+    }
+    return r;
+}
+
+TEST_CASE("COBS encoding", "[bytestuffing]")
+{
+    REQUIRE(cobsEncode(bytes({})) == bytes({0x01, 0x00}));
+    REQUIRE(cobsEncode(bytes({0x00})) == bytes({0x01, 0x01, 0x00}));
+    REQUIRE(cobsEncode(bytes({0x00, 0x00})) == bytes({0x01, 0x01, 0x01, 0x00}));
+    REQUIRE(cobsEncode(bytes({0x11, 0x22, 0x00, 0x33})) == bytes({0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+    REQUIRE(cobsEncode(bytes({0x11, 0x00, 0x00, 0x00})) == bytes({0x02, 0x11, 0x01, 0x01, 0x01, 0x00}));
+
+    // maximum block length
+    QByteArray run;
+    for (int i = 1; i <= 254; i++) run.append(char(i));
+    QByteArray encoded = cobsEncode(run);
+    REQUIRE(encoded.size() == 256);
+    REQUIRE(uchar(encoded[0]) == 0xFF);
+    REQUIRE(encoded.mid(1, 254) == run);
+    REQUIRE(encoded[255] == char(0));
+
+    encoded = cobsEncode(run + bytes({0xFF}));
+    REQUIRE(encoded.size() == 258);
+    REQUIRE(encoded.mid(255) == bytes({0x02, 0xFF, 0x00}));
+}
+
+TEST_CASE("SLIP encoding", "[bytestuffing]")
+{
+    REQUIRE(slipEncode(bytes({})) == bytes({0xC0}));
+    REQUIRE(slipEncode(bytes({0x01, 0xC0, 0x02, 0xDB})) ==
+            bytes({0x01, 0xDB, 0xDC, 0x02, 0xDB, 0xDD, 0xC0}));
+}
+
+TEST_CASE("COBS and SLIP round trip", "[bytestuffing]")
+{
+    quint32 seed = 1;
+    for (unsigned size = 0; size < 600; size += (size < 20 ? 1 : 37))
+    {
+        QByteArray packet = randomPacket(size, seed);
+
+        QByteArray cobs = cobsEncode(packet);
+        REQUIRE(memchr(cobs.constData(), COBS_DELIMITER, cobs.size() - 1) == nullptr);
+        REQUIRE(decode(cobs, true) == packet);
+
+        QByteArray slip = slipEncode(packet);
+        REQUIRE(memchr(slip.constData(), SLIP_END, slip.size() - 1) == nullptr);
+        REQUIRE(decode(slip, false) == packet);
+    }
+}
+
+TEST_CASE("invalid COBS and SLIP packets", "[bytestuffing]")
+{
+    // block is longer than the packet
+    REQUIRE(decode(bytes({0x05, 0x11, 0x22, 0x00}), true) == "error");
+    // zero inside packet
+    REQUIRE(decode(bytes({0x02, 0x11, 0x00, 0x01, 0x00}), true) == "error");
+
+    // invalid escape
+    REQUIRE(decode(bytes({0x11, 0xDB, 0x22, 0xC0}), false) == "error");
+    // escape at the end
+    REQUIRE(decode(bytes({0x11, 0xDB, 0xC0}), false) == "error");
+}
@@ -0,0 +1,139 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <QVector>
+
+#include "calibration.h"
+
+#include "catch.hpp"
+
+TEST_CASE("disabled calibration doesn't change data", "[calibration]")
+{
+    Calibration cal;
+    REQUIRE_FALSE(cal.isEnabled());
+
+    double data[3] = {1.5, -2, 1e9};
+    cal.apply(data, 3);
+    REQUIRE(data[0] == 1.5);
+    REQUIRE(data[1] == -2);
+    REQUIRE(data[2] == 1e9);
+}
+
+TEST_CASE("polynomial calibration", "[calibration]")
+{
+    // 1 + 2x - 0.5x^3
+    auto cal = Calibration::polynomial({1, 2, 0, -0.5});
+    REQUIRE(cal.type() == Calibration::Polynomial);
+
+    // more samples than a single block
+    const unsigned ns = 1000;
+    QVector<double> data(ns);
+    for (unsigned i = 0; i < ns; i++) data[i] = i * 0.01 - 5;
+
+    cal.apply(data.data(), ns);
+    for (unsigned i = 0; i < ns; i++)
+    {
+        double x = i * 0.01 - 5;
+        REQUIRE(data[i] == Approx(1 + 2*x - 0.5*x*x*x));
+    }
+
+    // constant
+    REQUIRE(Calibration::polynomial({3}).value(100) == 3);
+}
+
+TEST_CASE("table calibration interpolates and extrapolates", "[calibration]")
+{
+    auto cal = Calibration::table({0, 10, 20}, {0, 100, 150});
+    REQUIRE(cal.type() == Calibration::Table);
+
+    REQUIRE(cal.value(0) == 0);
+    REQUIRE(cal.value(5) == Approx(50));
+    REQUIRE(cal.value(10) == Approx(100));
+    REQUIRE(cal.value(15.5) == Approx(127.5));
+    REQUIRE(cal.value(20) == Approx(150));
+
+    // extrapolation with end segments
+    REQUIRE(cal.value(-1) == Approx(-10));
+    REQUIRE(cal.value(30) == Approx(200));
+
+    REQUIRE(std::isnan(cal.value(NAN)));
+}
+
+TEST_CASE("table integer fast path matches interpolation", "[calibration]")
+{
+    // 16 bit range with non-integer break points
+    auto cal = Calibration::table({-0.5, 1000.25, 40000.75, 65535},
+                                  {-1, 3, 7, 20});
+
+    QVector<double> ints, fracs;
+    for (int i = -2; i < 65540; i += 3)
+    {
+        ints.append(i);
+        fracs.append(i + 0.5);
+    }
+    QVector<double> intsOut = ints, fracsOut = fracs;
+    cal.apply(intsOut.data(), intsOut.size());
+    cal.apply(fracsOut.data(), fracsOut.size());
+
+    auto reference = [](double x)
+        {
+            const double xs[] = {-0.5, 1000.25, 40000.75, 65535};
+            const double ys[] = {-1, 3, 7, 20};
+            int s = 0;
+            while (s < 2 && x >= xs[s+1]) s++;
+            return ys[s] + (x - xs[s]) * (ys[s+1] - ys[s]) / (xs[s+1] - xs[s]);
+        };
+
+    for (int i = 0; i < ints.size(); i++)
+    {
+        REQUIRE(intsOut[i] == Approx(reference(ints[i])));
+        REQUIRE(fracsOut[i] == Approx(reference(fracs[i])));
+    }
+}
+
+TEST_CASE("calibration text representation", "[calibration]")
+{
+    Calibration cal;
+    QString error;
+
+    REQUIRE(Calibration::parse("poly: 1, 2.5, -3e-2", &cal));
+    REQUIRE(cal == Calibration::polynomial({1, 2.5, -3e-2}));
+
+    Calibration parsed;
+    REQUIRE(Calibration::parse(cal.toString(), &parsed));
+    REQUIRE(parsed == cal);
+
+    REQUIRE(Calibration::parse(" Table: 0=1, 255 = 3.3 ", &cal));
+    REQUIRE(cal == Calibration::table({0, 255}, {1, 3.3}));
+    REQUIRE(Calibration::parse(cal.toString(), &parsed));
+    REQUIRE(parsed == cal);
+
+    REQUIRE(Calibration::parse("  ", &cal));
+    REQUIRE_FALSE(cal.isEnabled());
+    REQUIRE(cal.toString().isEmpty());
+
+    REQUIRE_FALSE(Calibration::parse("1, 2", &cal, &error));
+    REQUIRE_FALSE(error.isEmpty());
+    REQUIRE_FALSE(Calibration::parse("poly: 1, x", &cal));
+    REQUIRE_FALSE(Calibration::parse("table: 0=1", &cal));
+    REQUIRE_FALSE(Calibration::parse("table: 0=1, 0=2", &cal));
+    REQUIRE_FALSE(Calibration::parse("table: 0=1, 1", &cal));
+    REQUIRE_FALSE(Calibration::parse("spline: 0=1, 1=2", &cal));
+}
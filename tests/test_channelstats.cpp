@@ -0,0 +1,143 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <QVector>
+
+#include "channelstats.h"
+
+#include "catch.hpp"
+
+/// Calculates statistics of given samples by scanning
+static ChannelStats::Summary scan(const double* data, unsigned n)
+{
+    ChannelStats::Summary r = {n, 0, 0, data[0], data[0], 0};
+    double sumSq = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+        r.mean += data[i];
+        sumSq += data[i] * data[i];
+        r.min = qMin(r.min, data[i]);
+        r.max = qMax(r.max, data[i]);
+    }
+    r.mean /= n;
+    r.rms = sqrt(sumSq / n);
+    double var = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+        var += (data[i] - r.mean) * (data[i] - r.mean);
+    }
+    r.stdDev = sqrt(var / n);
+    return r;
+}
+
+static void requireEqual(const ChannelStats::Summary& a, const ChannelStats::Summary& b)
+{
+    REQUIRE(a.count == b.count);
+    REQUIRE(a.mean == Approx(b.mean));
+    REQUIRE(a.rms == Approx(b.rms));
+    REQUIRE(a.min == b.min);
+    REQUIRE(a.max == b.max);
+    REQUIRE(a.stdDev == Approx(b.stdDev));
+}
+
+TEST_CASE("channel stats of all samples", "[stats]")
+{
+    ChannelStats stats;
+
+    REQUIRE(stats.total().count == 0);
+
+    double data[] = {1, 2, 3, 4, 10, -2};
+    stats.add(data, 3);
+    requireEqual(stats.total(), scan(data, 3));
+    stats.add(data + 3, 3);
+    requireEqual(stats.total(), scan(data, 6));
+    REQUIRE(stats.total().peakToPeak() == 12);
+
+    stats.clear();
+    REQUIRE(stats.total().count == 0);
+}
+
+TEST_CASE("channel stats of sliding window", "[stats]")
+{
+    const unsigned window = 7;
+    ChannelStats stats(window);
+
+    QVector<double> data;
+    for (unsigned i = 0; i < 100; i++)
+    {
+        data.append(sin(i * 0.7) * 10 + (i % 5));
+    }
+
+    // add in irregular chunks, check after each chunk
+    unsigned added = 0;
+    unsigned chunk = 1;
+    while (added < (unsigned) data.size())
+    {
+        unsigned n = qMin(chunk, data.size() - added);
+        stats.add(data.constData() + added, n);
+        added += n;
+        chunk = chunk % 9 + 2;
+
+        unsigned wn = qMin(added, window);
+        requireEqual(stats.windowed(), scan(data.constData() + added - wn, wn));
+        requireEqual(stats.total(), scan(data.constData(), added));
+    }
+}
+
+TEST_CASE("channel stats window of monotonic data", "[stats]")
+{
+    ChannelStats stats(3);
+    double up[] = {1, 2, 3, 4, 5};
+    stats.add(up, 5);
+    REQUIRE(stats.windowed().min == 3);
+    REQUIRE(stats.windowed().max == 5);
+
+    double down[] = {4, 3, 2, 1};
+    stats.add(down, 4);
+    REQUIRE(stats.windowed().min == 1);
+    REQUIRE(stats.windowed().max == 3);
+}
+
+TEST_CASE("channel stats window longer than queue capacity", "[stats]")
+{
+    ChannelStats stats(100);
+    QVector<double> data;
+    for (int i = 0; i < 250; i++) data.append(i < 150 ? i : 300 - i);
+
+    stats.add(data.constData(), data.size());
+    requireEqual(stats.windowed(), scan(data.constData() + 150, 100));
+}
+
+TEST_CASE("channel stats window is capped", "[stats]")
+{
+    ChannelStats stats(1000000000);
+    REQUIRE(stats.window() == ChannelStats::MAX_WINDOW);
+
+    stats.setWindow(10);
+    REQUIRE(stats.window() == 10);
+    stats.setWindow(ChannelStats::MAX_WINDOW + 1);
+    REQUIRE(stats.window() == ChannelStats::MAX_WINDOW);
+
+    QVector<double> data;
+    for (unsigned i = 0; i < ChannelStats::MAX_WINDOW + 10; i++) data.append(i);
+    stats.add(data.constData(), data.size());
+    REQUIRE(stats.windowed().count == ChannelStats::MAX_WINDOW);
+    REQUIRE(stats.windowed().min == 10);
+}
@@ -0,0 +1,126 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "catch.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include "checksum.h"
+
+static const uchar check[] = "123456789";
+
+/// Bit by bit reference implementation of CRC-32
+static quint32 crc32Ref(const uchar* data, unsigned n)
+{
+    quint32 crc = 0xFFFFFFFF;
+    for (unsigned i = 0; i < n; i++)
+    {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+static std::vector<uchar> randomBytes(unsigned n)
+{
+    std::vector<uchar> data(n);
+    quint32 x = 12345;
+    for (auto& d : data)
+    {
+        x = x * 1103515245 + 12345;
+        d = x >> 16;
+    }
+    return data;
+}
+
+TEST_CASE("checksum check values", "[checksum]")
+{
+    REQUIRE(calcChecksum(ChecksumType_Sum8, check, 9) == 0xDD);
+    REQUIRE(calcChecksum(ChecksumType_CRC8, check, 9) == 0xF4);
+    REQUIRE(calcChecksum(ChecksumType_CRC16_CCITT, check, 9) == 0x29B1);
+    REQUIRE(calcChecksum(ChecksumType_CRC16_XMODEM, check, 9) == 0x31C3);
+    REQUIRE(calcChecksum(ChecksumType_CRC32, check, 9) == 0xCBF43926);
+    REQUIRE(calcChecksum(ChecksumType_None, check, 9) == 0);
+
+    REQUIRE(checksumSize(ChecksumType_None) == 0);
+    REQUIRE(checksumSize(ChecksumType_CRC8) == 1);
+    REQUIRE(checksumSize(ChecksumType_CRC16_CCITT) == 2);
+    REQUIRE(checksumSize(ChecksumType_CRC32) == 4);
+}
+
+TEST_CASE("checksum type strings", "[checksum]")
+{
+    for (int i = ChecksumType_None; i < ChecksumType_INVALID; i++)
+    {
+        auto type = static_cast<ChecksumType>(i);
+        REQUIRE(strToChecksumType(checksumTypeToStr(type)) == type);
+    }
+    REQUIRE(strToChecksumType("nonsense") == ChecksumType_INVALID);
+}
+
+TEST_CASE("CRC-32 matches reference at all lengths and alignments", "[checksum]")
+{
+    auto data = randomBytes(100);
+    for (unsigned offset = 0; offset < 8; offset++)
+    {
+        for (unsigned n = 0; n <= 90; n++)
+        {
+            REQUIRE(crc32(data.data() + offset, n) ==
+                    crc32Ref(data.data() + offset, n));
+        }
+    }
+}
+
+TEST_CASE("CRC-32 can be calculated in parts", "[checksum]")
+{
+    auto data = randomBytes(1000);
+    quint32 crc = crc32(data.data(), 333);
+    crc = crc32(data.data() + 333, 667, crc);
+    REQUIRE(crc == crc32(data.data(), 1000));
+}
+
+TEST_CASE("checksum throughput", "[checksum, benchmark]")
+{
+    // 32 MB in 256 byte frames, about 130k frames
+    const unsigned frameSize = 256;
+    const unsigned numFrames = 128 * 1024;
+    auto data = randomBytes(frameSize * numFrames);
+
+    for (auto type : {ChecksumType_CRC8, ChecksumType_CRC16_CCITT, ChecksumType_CRC32})
+    {
+        quint32 result = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < numFrames; i++)
+        {
+            result += calcChecksum(type, data.data() + i * frameSize, frameSize);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double mbps = data.size() / elapsed.count() / 1e6;
+        WARN(checksumTypeToStr(type).toStdString() << ": " << mbps << " MB/s, "
+             << numFrames / elapsed.count() << " frames/s (" << result << ")");
+
+        // well above what any serial port or USB CDC device can deliver
+        REQUIRE(mbps > 20);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <QVector>
+
+#include "expression.h"
+
+#include "catch.hpp"
+
+/// Evaluates expression over given input columns
+static QVector<double> eval(const char* text, QVector<QVector<double>> inputs)
+{
+    Expression e;
+    QString error;
+    REQUIRE(e.compile(text, inputs.size(), &error));
+    REQUIRE(error.isEmpty());
+
+    unsigned ns = inputs.isEmpty() ? 1 : inputs[0].size();
+    QVector<const double*> columns;
+    for (auto& in : inputs) columns.append(in.constData());
+
+    QVector<double> out(ns);
+    e.evaluate(columns.constData(), ns, out.data());
+    return out;
+}
+
+TEST_CASE("expression arithmetic", "[expression]")
+{
+    QVector<double> ch1({1, 2, 3});
+    QVector<double> ch2({4, 5, 6});
+
+    REQUIRE(eval("ch1", {ch1}) == ch1);
+    REQUIRE(eval("ch1 - ch2", {ch1, ch2}) == QVector<double>({-3, -3, -3}));
+    REQUIRE(eval("ch1 + ch2 * 2", {ch1, ch2}) == QVector<double>({9, 12, 15}));
+    REQUIRE(eval("(ch1 + ch2) * 2", {ch1, ch2}) == QVector<double>({10, 14, 18}));
+    REQUIRE(eval("ch2 / ch1", {ch1, ch2}) == QVector<double>({4, 2.5, 2}));
+    REQUIRE(eval("-ch1^2", {ch1}) == QVector<double>({-1, -4, -9}));
+    REQUIRE(eval("2^3^2", {}) == QVector<double>({512}));
+    REQUIRE(eval("1.5e1 + .5", {}) == QVector<double>({15.5}));
+    REQUIRE(eval("CH1 * 0 + 1", {ch1}) == QVector<double>({1, 1, 1}));
+}
+
+TEST_CASE("expression functions", "[expression]")
+{
+    QVector<double> ch1({3, 0, -6});
+    QVector<double> ch2({4, 2, 8});
+
+    REQUIRE(eval("sqrt(ch1^2 + ch2^2)", {ch1, ch2}) == QVector<double>({5, 2, 10}));
+    REQUIRE(eval("abs(ch1)", {ch1}) == QVector<double>({3, 0, 6}));
+    REQUIRE(eval("max(ch1, ch2 - 4)", {ch1, ch2}) == QVector<double>({3, 0, 4}));
+    REQUIRE(eval("min(ch1, 1)", {ch1}) == QVector<double>({1, 0, -6}));
+    REQUIRE(eval("pow(ch1, 2)", {ch2}) == QVector<double>({16, 4, 64}));
+    REQUIRE(eval("cos(pi)", {})[0] == Approx(-1));
+    REQUIRE(eval("atan2(1, 1)", {})[0] == Approx(M_PI / 4));
+    REQUIRE(eval("log10(1000) + log(exp(2))", {})[0] == Approx(5));
+}
+
+TEST_CASE("expression should reuse temporaries", "[expression]")
+{
+    // deeply nested expression, results must not overwrite each other
+    QVector<double> ch1({1, 2});
+    REQUIRE(eval("(ch1 + 1) * (ch1 + 2) - (ch1 + 3) * (ch1 + 4)", {ch1}) ==
+            QVector<double>({2*3 - 4*5, 3*4 - 5*6}));
+}
+
+TEST_CASE("invalid expressions", "[expression]")
+{
+    Expression e;
+    QString error;
+
+    REQUIRE_FALSE(e.compile("ch3", 2, &error));
+    REQUIRE_FALSE(error.isEmpty());
+    REQUIRE_FALSE(e.isValid());
+
+    for (const char* text : {"", "ch1 +", "(ch1", "foo(ch1)", "sqrt ch1",
+                             "max(ch1)", "ch1 ch2", "1..2", "#"})
+    {
+        REQUIRE_FALSE(e.compile(text, 2));
+    }
+}
+
+TEST_CASE("expression size and nesting limits", "[expression]")
+{
+    Expression e;
+    QString error;
+
+    // deep nesting fails instead of overflowing the stack
+    REQUIRE_FALSE(e.compile(QString(100000, '-') + "ch1", 1, &error));
+    REQUIRE(error == "Expression too deeply nested");
+    REQUIRE_FALSE(e.compile(QString(100000, '(') + "ch1", 1, &error));
+    REQUIRE(error == "Expression too deeply nested");
+    REQUIRE(e.compile(QString(100, '(') + "ch1" + QString(100, ')'), 1));
+
+    // too many constants for register indexes
+    QString sum = "0";
+    for (int i = 1; i <= 0x4000; i++) sum += QString("+%1").arg(i);
+    REQUIRE_FALSE(e.compile(sum, 1, &error));
+    REQUIRE(error == "Too many constants");
+}
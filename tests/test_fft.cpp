@@ -0,0 +1,107 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <QVector>
+
+#include "fft.h"
+
+#include "catch.hpp"
+
+/// Naive DFT for reference
+static void dft(const QVector<double>& in, QVector<double>& re, QVector<double>& im)
+{
+    int n = in.size();
+    re.fill(0, n/2 + 1);
+    im.fill(0, n/2 + 1);
+    for (int k = 0; k <= n/2; k++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            double a = -2 * M_PI * k * i / n;
+            re[k] += in[i] * cos(a);
+            im[k] += in[i] * sin(a);
+        }
+    }
+}
+
+TEST_CASE("fft size validation", "[fft]")
+{
+    REQUIRE(FFT::isValidSize(4));
+    REQUIRE(FFT::isValidSize(1024));
+    REQUIRE(FFT::isValidSize(1 << 20));
+    REQUIRE_FALSE(FFT::isValidSize(0));
+    REQUIRE_FALSE(FFT::isValidSize(2));
+    REQUIRE_FALSE(FFT::isValidSize(100));
+}
+
+TEST_CASE("fft should match dft", "[fft]")
+{
+    for (unsigned n : {4u, 8u, 16u, 256u, 1024u})
+    {
+        QVector<double> in(n);
+        for (unsigned i = 0; i < n; i++)
+        {
+            in[i] = sin(i * 0.37) + 0.5 * cos(i * 1.9) + (i % 7) * 0.1;
+        }
+
+        FFT fft(n);
+        REQUIRE(fft.numBins() == n/2 + 1);
+
+        QVector<double> re(fft.numBins()), im(fft.numBins());
+        fft.transform(in.constData(), re.data(), im.data());
+
+        QVector<double> dre, dim;
+        dft(in, dre, dim);
+
+        for (unsigned k = 0; k < fft.numBins(); k++)
+        {
+            REQUIRE(re[k] == Approx(dre[k]).margin(1e-9 * n));
+            REQUIRE(im[k] == Approx(dim[k]).margin(1e-9 * n));
+        }
+    }
+}
+
+TEST_CASE("fft of a sine should peak at its frequency", "[fft]")
+{
+    const unsigned n = 4096;
+    const unsigned bin = 100;
+    QVector<double> in(n);
+    for (unsigned i = 0; i < n; i++)
+    {
+        in[i] = 2 * sin(2 * M_PI * bin * i / n);
+    }
+
+    FFT fft(n);
+    QVector<double> re(fft.numBins()), im(fft.numBins());
+    fft.transform(in.constData(), re.data(), im.data());
+
+    for (unsigned k = 0; k < fft.numBins(); k++)
+    {
+        double mag = sqrt(re[k] * re[k] + im[k] * im[k]);
+        if (k == bin)
+        {
+            REQUIRE(mag == Approx(n));
+        }
+        else
+        {
+            REQUIRE(mag == Approx(0).margin(1e-6));
+        }
+    }
+}
@@ -0,0 +1,213 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <QVector>
+
+#include "filter.h"
+#include "stream.h"
+
+#include "catch.hpp"
+#include "test_helpers.h"
+
+/// Collects received samples of the first channel
+class CollectingSink : public Sink
+{
+public:
+    QVector<double> received;
+
+protected:
+    void feedIn(const SamplePack& data) override
+        {
+            for (unsigned i = 0; i < data.numSamples(); i++)
+            {
+                received.append(data.data(0)[i]);
+            }
+            Sink::feedIn(data);
+        };
+};
+
+/// Feeds given values in packs of varying sizes
+static void feedInPacks(TestSource& source, const QVector<double>& values)
+{
+    int pos = 0;
+    unsigned size = 1;
+    while (pos < values.size())
+    {
+        unsigned n = qMin((int) size, values.size() - pos);
+        SamplePack pack(n, 1);
+        for (unsigned i = 0; i < n; i++)
+        {
+            pack.data(0)[i] = values[pos + i];
+        }
+        source._feed(pack);
+        pos += n;
+        size = size % 7 + 1;
+    }
+}
+
+TEST_CASE("disabled filter should pass data through", "[filter]")
+{
+    TestSource source(1, false);
+    Filter filter;
+    CollectingSink out;
+    source.connectSink(&filter);
+    filter.connectSink(&out);
+
+    filter.setFir({0.5, 0.5}, 2);
+    feedInPacks(source, {1, 2, 3, 4});
+    REQUIRE(out.received == QVector<double>({1, 2, 3, 4}));
+}
+
+TEST_CASE("filter should decimate across packs", "[filter]")
+{
+    TestSource source(1, false);
+    Filter filter;
+    CollectingSink out, raw;
+    source.connectSink(&filter);
+    filter.connectSink(&out);
+    filter.connectFollower(&raw);
+
+    filter.setEnabled(true);
+    filter.setFir({}, 3);
+
+    QVector<double> input;
+    for (int i = 0; i < 20; i++) input.append(i);
+    feedInPacks(source, input);
+
+    REQUIRE(out.received == QVector<double>({0, 3, 6, 9, 12, 15, 18}));
+    // followers get the unfiltered data
+    REQUIRE(raw.received == input);
+}
+
+TEST_CASE("filter should apply gain and offset before filtering", "[filter, stream]")
+{
+    Stream stream(1, false, 4);
+    auto model = stream.infoModel();
+    REQUIRE(model->setData(model->index(0, ChannelInfoModel::COLUMN_GAIN), 2.0));
+    REQUIRE(model->setData(model->index(0, ChannelInfoModel::COLUMN_GAIN), Qt::Checked, Qt::CheckStateRole));
+    REQUIRE(model->setData(model->index(0, ChannelInfoModel::COLUMN_OFFSET), 1.0));
+    REQUIRE(model->setData(model->index(0, ChannelInfoModel::COLUMN_OFFSET), Qt::Checked, Qt::CheckStateRole));
+
+    TestSource source(1, false);
+    Filter filter;
+    CollectingSink raw;
+    filter.setInfoModel(model);
+    stream.setApplyGainOffset(false);
+    source.connectSink(&filter);
+    filter.connectSink(&stream);
+    filter.connectFollower(&raw);
+
+    filter.setEnabled(true);
+    filter.setFir({}, 2);
+    feedInPacks(source, {0, 1, 2, 3, 4, 5, 6, 7});
+
+    // followers get processed data at the input rate
+    REQUIRE(raw.received == QVector<double>({1, 3, 5, 7, 9, 11, 13, 15}));
+    // stream doesn't apply gain and offset again
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(stream.channel(0)->yData()->sample(i) == Approx(4 * i + 1));
+    }
+}
+
+TEST_CASE("decimating FIR should match direct convolution", "[filter]")
+{
+    TestSource source(1, false);
+    Filter filter;
+    CollectingSink out;
+    source.connectSink(&filter);
+    filter.connectSink(&out);
+
+    const QVector<double> taps({0.1, 0.2, 0.3, 0.15, 0.1, 0.05, 0.05, 0.05});
+    const unsigned decimation = 2;
+    filter.setEnabled(true);
+    filter.setFir(taps, decimation);
+
+    QVector<double> input;
+    for (int i = 0; i < 50; i++) input.append(sin(i * 0.3) + i % 3);
+    feedInPacks(source, input);
+
+    QVector<double> expected;
+    for (int n = 0; n < input.size(); n += decimation)
+    {
+        double y = 0;
+        for (int j = 0; j < taps.size(); j++)
+        {
+            if (n - j >= 0) y += taps[j] * input[n - j];
+        }
+        expected.append(y);
+    }
+
+    REQUIRE(out.received.size() == expected.size());
+    for (int i = 0; i < expected.size(); i++)
+    {
+        REQUIRE(out.received[i] == Approx(expected[i]));
+    }
+}
+
+TEST_CASE("butterworth filters", "[filter]")
+{
+    REQUIRE(Filter::butterworth(Filter::IirNone, 4, 0.1).isEmpty());
+    REQUIRE(Filter::butterworth(Filter::IirLowPass, 4, 0.1).size() == 2);
+    REQUIRE(Filter::butterworth(Filter::IirLowPass, 3, 0.1).size() == 2);
+
+    QVector<double> dc(500, 1.0);
+
+    // low pass should settle to DC value
+    {
+        TestSource source(1, false);
+        Filter filter;
+        CollectingSink out;
+        source.connectSink(&filter);
+        filter.connectSink(&out);
+        filter.setEnabled(true);
+        filter.setIir(Filter::butterworth(Filter::IirLowPass, 4, 0.05));
+        feedInPacks(source, dc);
+        REQUIRE(out.received.last() == Approx(1.0).margin(1e-6));
+    }
+
+    // high pass should remove DC
+    {
+        TestSource source(1, false);
+        Filter filter;
+        CollectingSink out;
+        source.connectSink(&filter);
+        filter.connectSink(&out);
+        filter.setEnabled(true);
+        filter.setIir(Filter::butterworth(Filter::IirHighPass, 2, 0.05));
+        feedInPacks(source, dc);
+        REQUIRE(out.received.last() == Approx(0.0).margin(1e-6));
+    }
+}
+
+TEST_CASE("low pass FIR design", "[filter]")
+{
+    auto taps = Filter::lowPassFir(31, 0.1);
+    REQUIRE(taps.size() == 31);
+
+    double sum = 0;
+    for (auto t : taps) sum += t;
+    REQUIRE(sum == Approx(1.0));
+    // symmetric
+    for (int i = 0; i < 15; i++)
+    {
+        REQUIRE(taps[i] == Approx(taps[30 - i]));
+    }
+}
@@ -0,0 +1,296 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include <QtGlobal>
+
+#include "framelayout.h"
+
+#include "catch.hpp"
+
+TEST_CASE("uniform frame layout", "[layout]")
+{
+    FrameLayout layout(3, NumberFormat_int16);
+    REQUIRE(layout.numChannels() == 3);
+    REQUIRE(layout.size() == 6);
+    REQUIRE(layout.fieldSize(2) == 2);
+
+    const uchar data[] = {0x01, 0x00, 0xFF, 0xFF, 0x00, 0x01,
+                          0x02, 0x00, 0xFE, 0xFF, 0x00, 0x02};
+    SamplePack samples(2, 3);
+    layout.decode(data, 2, &samples);
+    REQUIRE(samples.data(0)[0] == 1);
+    REQUIRE(samples.data(1)[0] == -1);
+    REQUIRE(samples.data(2)[0] == 256);
+    REQUIRE(samples.data(0)[1] == 2);
+    REQUIRE(samples.data(1)[1] == -2);
+    REQUIRE(samples.data(2)[1] == 512);
+
+    layout.setEndianness(BigEndian);
+    layout.decode(data, 2, &samples);
+    REQUIRE(samples.data(0)[0] == 256);
+    REQUIRE(samples.data(2)[0] == 1);
+    REQUIRE(samples.data(1)[1] == -257);
+}
+
+TEST_CASE("parsing frame layout", "[layout]")
+{
+    FrameLayout layout;
+    QString error;
+
+    REQUIRE(layout.parse("uint32 ts; int16 ax, ay, az; pad 2; float temp", &error));
+    REQUIRE(layout.numChannels() == 5);
+    REQUIRE(layout.size() == 4 + 3*2 + 2 + 4);
+    REQUIRE(layout.fieldSize(0) == 4);
+    REQUIRE(layout.fieldSize(1) == 2);
+    REQUIRE(layout.fieldSize(4) == 4);
+
+    REQUIRE(layout.parse("struct imu {\n  uint8_t id;\n  pad;\n  int16_t acc[3];\n  double t;\n};"));
+    REQUIRE(layout.numChannels() == 5);
+    REQUIRE(layout.size() == 1 + 1 + 6 + 8);
+
+    REQUIRE(layout.parse("float; float; uint8"));
+    REQUIRE(layout.numChannels() == 3);
+    REQUIRE(layout.size() == 9);
+
+    // invalid descriptions don't change the layout
+    REQUIRE_FALSE(layout.parse("int33 x", &error));
+    REQUIRE_FALSE(error.isEmpty());
+    REQUIRE_FALSE(layout.parse("int16 1x"));
+    REQUIRE_FALSE(layout.parse("int16 x[0]"));
+    REQUIRE_FALSE(layout.parse("pad -1; int8 a"));
+    REQUIRE_FALSE(layout.parse("pad 4"));
+    REQUIRE_FALSE(layout.parse(""));
+    REQUIRE_FALSE(layout.parse("uint8 a[100]"));
+    // huge and overflowing counts are rejected before allocation
+    REQUIRE_FALSE(layout.parse("uint8 a[999999999]", &error));
+    REQUIRE(error.startsWith("Too many channels"));
+    REQUIRE_FALSE(layout.parse("uint8 a[4294967295], b[2]"));
+    REQUIRE_FALSE(layout.parse("uint8 a[60]; int16 b[3], c[2]"));
+    REQUIRE(layout.parse("uint8 a[60]; int16 b[3], c"));
+    REQUIRE(layout.numChannels() == 64);
+    REQUIRE(layout.parse("float; float; uint8"));
+    // layout size is limited, pad size can't wrap around
+    REQUIRE_FALSE(layout.parse("pad 536870911; uint8 a", &error));
+    REQUIRE(error.startsWith("Layout is too large"));
+    REQUIRE_FALSE(layout.parse("pad 100000000; uint8 a"));
+    REQUIRE_FALSE(layout.parse("pad 65536; uint8 a"));
+    REQUIRE_FALSE(layout.parse("pad 4294967295; pad 4294967295; uint8 a"));
+    REQUIRE(layout.parse("pad 65535; uint8 a"));
+    REQUIRE(layout.size() == FrameLayout::MAX_SIZE);
+    REQUIRE(layout.parse("float; float; uint8"));
+    REQUIRE_FALSE(layout.parse("uint0 a"));
+    REQUIRE_FALSE(layout.parse("uint4 a; float b"));
+    REQUIRE(layout.numChannels() == 3);
+    REQUIRE(layout.size() == 9);
+}
+
+/// Appends `value` to `data` in little endian
+template <typename T> static void put(std::vector<uchar>& data, T value)
+{
+    uchar bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    if (Q_BYTE_ORDER == Q_BIG_ENDIAN) std::reverse(bytes, bytes + sizeof(T));
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+TEST_CASE("decoding mixed frame layout", "[layout]")
+{
+    // struct {uint32 ts; int16 ax, ay, az; uint8 pad[2]; float temp}
+    const unsigned n = 10;
+    std::vector<uchar> data;
+    for (unsigned i = 0; i < n; i++)
+    {
+        put<quint32>(data, 1000000 + i);
+        put<qint16>(data, -100 * i);
+        put<qint16>(data, i);
+        put<qint16>(data, 30000);
+        put<quint16>(data, 0xFFFF);
+        put<float>(data, 20.5f + i);
+    }
+
+    FrameLayout layout;
+    REQUIRE(layout.parse("uint32 ts; int16 ax, ay, az; pad 2; float temp"));
+    REQUIRE(layout.size() * n == data.size());
+
+    // decode into the middle of a pack
+    SamplePack samples(n + 2, 5);
+    layout.decode(data.data(), n, &samples, 2);
+    for (unsigned i = 0; i < n; i++)
+    {
+        REQUIRE(samples.data(0)[i+2] == 1000000 + i);
+        REQUIRE(samples.data(1)[i+2] == -100 * (int) i);
+        REQUIRE(samples.data(2)[i+2] == i);
+        REQUIRE(samples.data(3)[i+2] == 30000);
+        REQUIRE(samples.data(4)[i+2] == 20.5 + i);
+    }
+}
+
+TEST_CASE("parsing bit packed frame layout", "[layout]")
+{
+    FrameLayout layout;
+
+    REQUIRE(layout.parse("uint12 a, b"));
+    REQUIRE(layout.numChannels() == 2);
+    REQUIRE(layout.size() == 3);
+    REQUIRE(layout.fieldSize(0) == 2);
+
+    REQUIRE(layout.parse("int24_t x[2]"));
+    REQUIRE(layout.size() == 6);
+    REQUIRE(layout.fieldSize(1) == 3);
+
+    // size is rounded up
+    REQUIRE(layout.parse("uint12 a[3]"));
+    REQUIRE(layout.size() == 5);
+
+    REQUIRE(layout.parse("uint1 flag; uint7 level; pad 1; float f"));
+    REQUIRE(layout.size() == 6);
+
+    // uniform sets that aren't whole bytes are read in pairs
+    REQUIRE(FrameLayout(3, NumberFormat_int12).size() == 9);
+    REQUIRE(FrameLayout(3, NumberFormat_int12).setsPerPackage() == 2);
+    REQUIRE(FrameLayout(1, NumberFormat_uint12).size() == 3);
+    REQUIRE(FrameLayout(2, NumberFormat_uint12).setsPerPackage() == 1);
+    REQUIRE(FrameLayout(2, NumberFormat_uint24).size() == 6);
+    REQUIRE(layout.setsPerPackage() == 1);
+}
+
+TEST_CASE("decoding 12 and 24 bit samples", "[layout]")
+{
+    // 0x123 and 0xABC packed LSB first, then MSB first
+    const uchar pairLE[] = {0x23, 0xC1, 0xAB};
+    const uchar pairBE[] = {0x12, 0x3A, 0xBC};
+
+    FrameLayout layout(2, NumberFormat_uint12);
+    SamplePack samples(1, 2);
+    layout.decode(pairLE, 1, &samples);
+    REQUIRE(samples.data(0)[0] == 0x123);
+    REQUIRE(samples.data(1)[0] == 0xABC);
+
+    layout.setEndianness(BigEndian);
+    layout.decode(pairBE, 1, &samples);
+    REQUIRE(samples.data(0)[0] == 0x123);
+    REQUIRE(samples.data(1)[0] == 0xABC);
+
+    layout = FrameLayout(2, NumberFormat_int12, BigEndian);
+    layout.decode(pairBE, 1, &samples);
+    REQUIRE(samples.data(0)[0] == 0x123);
+    REQUIRE(samples.data(1)[0] == 0xABC - 0x1000);
+
+    const uchar int24[] = {0xFE, 0xFF, 0xFF, 0x00, 0x00, 0x80};
+    layout = FrameLayout(2, NumberFormat_int24);
+    layout.decode(int24, 1, &samples);
+    REQUIRE(samples.data(0)[0] == -2);
+    REQUIRE(samples.data(1)[0] == -8388608);
+
+    layout.setEndianness(BigEndian);
+    layout.decode(int24, 1, &samples);
+    REQUIRE(samples.data(0)[0] == -65537);
+    REQUIRE(samples.data(1)[0] == 128);
+}
+
+TEST_CASE("bit packed frame layout round trip", "[layout]")
+{
+    const unsigned widths[] = {12, 12, 5, 16, 1, 32, 7, 24, 3};
+    const bool sign[] = {false, true, true, false, false, true, false, true, true};
+    const unsigned nc = sizeof(widths) / sizeof(widths[0]);
+    const unsigned n = 20;
+
+    QString desc;
+    for (unsigned c = 0; c < nc; c++)
+    {
+        desc += QString("%1int%2 c%3;").arg(sign[c] ? "" : "u").arg(widths[c]).arg(c);
+    }
+
+    for (bool bigEndian : {false, true})
+    {
+        FrameLayout layout;
+        REQUIRE(layout.parse(desc));
+        layout.setEndianness(bigEndian ? BigEndian : LittleEndian);
+        REQUIRE(layout.size() == 14);
+
+        // pack known values
+        std::vector<uchar> data(layout.size() * n, 0x5A);
+        std::vector<qint64> expected;
+        quint32 x = 1;
+        for (unsigned i = 0; i < n; i++)
+        {
+            unsigned offset = i * layout.size() * 8;
+            for (unsigned c = 0; c < nc; c++)
+            {
+                x = x * 1664525 + 1013904223;
+                quint32 value = widths[c] < 32 ? x & ((1u << widths[c]) - 1) : x;
+                qint64 v = value;
+                if (sign[c] && (value >> (widths[c] - 1))) v -= qint64(1) << widths[c];
+                expected.push_back(v);
+
+                packBits(value, &data[offset / 8], offset % 8, widths[c], bigEndian);
+                offset += widths[c];
+            }
+        }
+
+        SamplePack samples(n, nc);
+        layout.decode(data.data(), n, &samples);
+        for (unsigned i = 0; i < n; i++)
+        {
+            for (unsigned c = 0; c < nc; c++)
+            {
+                REQUIRE(samples.data(c)[i] == expected[i * nc + c]);
+            }
+        }
+    }
+}
+
+TEST_CASE("uniform 12 bit layout round trip", "[layout]")
+{
+    const unsigned n = 10;
+
+    for (unsigned nc : {1u, 3u})
+    {
+        for (bool bigEndian : {false, true})
+        {
+            FrameLayout layout(nc, NumberFormat_uint12, bigEndian ? BigEndian : LittleEndian);
+            REQUIRE(layout.setsPerPackage() == 2);
+            REQUIRE(layout.size() == nc * 3);
+
+            // samples are packed without gaps, 2 samples in 3 bytes
+            std::vector<uchar> data(layout.size() * n, 0);
+            std::vector<quint32> expected;
+            for (unsigned i = 0; i < 2 * n * nc; i++)
+            {
+                quint32 value = (i * 397 + 11) & 0xFFF;
+                expected.push_back(value);
+                packBits(value, &data[i * 12 / 8], i * 12 % 8, 12, bigEndian);
+            }
+
+            // decode into the middle of a pack
+            SamplePack samples(2 * n + 1, nc);
+            layout.decode(data.data(), n, &samples, 1);
+            for (unsigned i = 0; i < 2 * n; i++)
+            {
+                for (unsigned c = 0; c < nc; c++)
+                {
+                    REQUIRE(samples.data(c)[i + 1] == expected[i * nc + c]);
+                }
+            }
+        }
+    }
+}
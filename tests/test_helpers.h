@@ -1,9 +1,35 @@
 #ifndef TEST_HELPERS_H
 #define TEST_HELPERS_H
 
+#include <functional>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
 #include "source.h"
 #include "sink.h"
 
+/// Default timeout of `waitUntil()` in milliseconds
+static const int WAIT_TIMEOUT = 5000;
+
+/// Processes events until `done` returns true or timeout
+static inline bool waitUntil(std::function<bool()> done, int timeout = WAIT_TIMEOUT)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done())
+    {
+        if (timer.elapsed() > timeout) return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+/// Returns throughput in MB/s
+static inline double throughput(qint64 bytes, qint64 ms)
+{
+    return bytes / 1e6 / (qMax(ms, qint64(1)) / 1000.);
+}
+
 class TestSink : public Sink
 {
 public:
@@ -0,0 +1,161 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "keyvalueparser.h"
+
+#include "catch.hpp"
+
+/// Returns value of a channel in last parsed line, -1000 if not present
+static double valueOf(const KeyValueParser& parser, int n, unsigned channel)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if (parser.value(i).channel == channel) return parser.value(i).value;
+    }
+    return -1000;
+}
+
+TEST_CASE("key value pairs", "[keyvalue]")
+{
+    KeyValueParser parser(10);
+
+    int n = parser.parse("a=1, b=2.5,c=-3");
+    REQUIRE(n == 3);
+    REQUIRE(parser.numChannels() == 3);
+    REQUIRE(parser.keys() == QStringList({"a", "b", "c"}));
+    REQUIRE(valueOf(parser, n, 0) == 1);
+    REQUIRE(valueOf(parser, n, 1) == 2.5);
+    REQUIRE(valueOf(parser, n, 2) == -3);
+
+    // arduino style labels, different order
+    n = parser.parse("c:7 a:8");
+    REQUIRE(n == 2);
+    REQUIRE(valueOf(parser, n, 0) == 8);
+    REQUIRE(valueOf(parser, n, 1) == -1000);
+    REQUIRE(valueOf(parser, n, 2) == 7);
+
+    // new key creates a channel
+    n = parser.parse("d = 1e3; a = 0x10");
+    REQUIRE(n == 2);
+    REQUIRE(parser.numChannels() == 4);
+    REQUIRE(valueOf(parser, n, 3) == 1000);
+    REQUIRE(valueOf(parser, n, 0) == 16);
+}
+
+TEST_CASE("json lines", "[keyvalue]")
+{
+    KeyValueParser parser(10);
+
+    int n = parser.parse("{\"temp\": 21.5, \"hum\":40, \"ok\": true, \"id\": \"dev 1\", \"err\": null}");
+    REQUIRE(n == 3);
+    REQUIRE(parser.keys() == QStringList({"temp", "hum", "ok"}));
+    REQUIRE(valueOf(parser, n, 0) == 21.5);
+    REQUIRE(valueOf(parser, n, 1) == 40);
+    REQUIRE(valueOf(parser, n, 2) == 1);
+
+    n = parser.parse("{\"hum\":-1.25}");
+    REQUIRE(n == 1);
+    REQUIRE(valueOf(parser, n, 1) == -1.25);
+}
+
+TEST_CASE("predefined keys", "[keyvalue]")
+{
+    KeyValueParser parser(3);
+    parser.setKeys({"y", " x ", ""});
+    REQUIRE(parser.numChannels() == 2);
+
+    int n = parser.parse("x=1 y=2 z=3 w=4");
+    REQUIRE(n == 3);
+    REQUIRE(valueOf(parser, n, 0) == 2);
+    REQUIRE(valueOf(parser, n, 1) == 1);
+    REQUIRE(valueOf(parser, n, 2) == 3);
+    // channel limit reached, `w` is ignored
+    REQUIRE(parser.numChannels() == 3);
+
+    parser.setKeys({});
+    REQUIRE(parser.numChannels() == 0);
+}
+
+TEST_CASE("many keys", "[keyvalue]")
+{
+    KeyValueParser parser(1000);
+    QString line;
+    for (int i = 0; i < 500; i++)
+    {
+        line += QString("k%1=%2 ").arg(i).arg(i * 2);
+    }
+
+    for (int repeat = 0; repeat < 2; repeat++)
+    {
+        int n = parser.parse(line);
+        REQUIRE(n == 500);
+        REQUIRE(parser.numChannels() == 500);
+        for (int i = 0; i < n; i++)
+        {
+            REQUIRE(parser.value(i).channel == (unsigned) i);
+            REQUIRE(parser.value(i).value == i * 2);
+        }
+    }
+}
+
+TEST_CASE("hex values", "[keyvalue]")
+{
+    KeyValueParser parser(10);
+    parser.setHex(true);
+    int n = parser.parse("a=ff b=10");
+    REQUIRE(n == 2);
+    REQUIRE(valueOf(parser, n, 0) == 255);
+    REQUIRE(valueOf(parser, n, 1) == 16);
+}
+
+TEST_CASE("invalid key value lines", "[keyvalue]")
+{
+    KeyValueParser parser(10);
+    REQUIRE(parser.parse("") == 0);
+    REQUIRE(parser.parse("a") == -1);
+    REQUIRE(parser.parse("a=") == -1);
+    REQUIRE(parser.parse("a=1x") == -1);
+    REQUIRE(parser.parse("a=1 =2") == -1);
+    REQUIRE(parser.parse("{\"a\": 1, \"b") == -1);
+    REQUIRE(parser.parse("{\"a\": {\"b\": 1}}") == -1);
+    REQUIRE(parser.parse("1, 2, 3") == -1);
+}
+
+TEST_CASE("invalid lines don't add keys", "[keyvalue]")
+{
+    KeyValueParser parser(3);
+    REQUIRE(parser.parse("x=1") == 1);
+
+    REQUIRE(parser.parse("y=2 z=3 x=bad") == -1);
+    REQUIRE(parser.numChannels() == 1);
+    REQUIRE(parser.parse("{\"w\": 1, \"v") == -1);
+    REQUIRE(parser.numChannels() == 1);
+
+    // repeated new key gets a single channel, channel limit holds
+    REQUIRE(parser.parse("y=2 z=3 y=4 w=5") == 3);
+    REQUIRE(parser.keys() == QStringList({"x", "y", "z"}));
+    REQUIRE(parser.value(0).channel == 1);
+    REQUIRE(parser.value(1).channel == 2);
+    REQUIRE(parser.value(2).channel == 1);
+    REQUIRE(parser.value(2).value == 4);
+
+    // new keys are found after being added
+    REQUIRE(parser.parse("z=6") == 1);
+    REQUIRE(parser.value(0).channel == 2);
+}
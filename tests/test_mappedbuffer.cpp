@@ -0,0 +1,178 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QVector>
+
+#include "mappedbuffer.h"
+#include "ringbuffer.h"
+
+#include "catch.hpp"
+
+TEST_CASE("MappedBuffer sizing and initial values", "[memory, buffer, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    MappedBuffer buf(10, dir.path() + "/a.spbuf");
+    REQUIRE(buf.isMapped());
+    REQUIRE(buf.size() == 10);
+    REQUIRE(buf.numValid() == 0);
+    for (unsigned i = 0; i < 10; i++)
+    {
+        REQUIRE(buf.sample(i) == 0);
+    }
+
+    buf.resize(5);
+    REQUIRE(buf.size() == 5);
+    buf.resize(20);
+    REQUIRE(buf.size() == 20);
+}
+
+TEST_CASE("MappedBuffer file is aligned", "[memory, buffer, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString fileName = dir.path() + "/a.spbuf";
+
+    MappedBuffer buf(1000, fileName);
+    REQUIRE(QFile(fileName).size() % MappedBuffer::FILE_ALIGNMENT == 0);
+}
+
+TEST_CASE("MappedBuffer behaves like RingBuffer", "[memory, buffer, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    MappedBuffer mbuf(10, dir.path() + "/a.spbuf");
+    RingBuffer rbuf(10);
+
+    auto check = [&mbuf, &rbuf]()
+        {
+            REQUIRE(mbuf.size() == rbuf.size());
+            for (unsigned i = 0; i < rbuf.size(); i++)
+            {
+                REQUIRE(mbuf.sample(i) == rbuf.sample(i));
+            }
+            REQUIRE(mbuf.limits().start == rbuf.limits().start);
+            REQUIRE(mbuf.limits().end == rbuf.limits().end);
+        };
+
+    // a deterministic mix of writes that wrap around and resizes
+    double value = 1;
+    QVector<double> samples;
+    const unsigned writes[] = {3, 5, 4, 1, 9, 10, 12, 2, 7, 30, 6};
+    const unsigned sizes[] = {10, 15, 15, 4, 9, 9, 20, 20, 5, 12, 12};
+    for (unsigned k = 0; k < sizeof(writes) / sizeof(writes[0]); k++)
+    {
+        samples.resize(writes[k]);
+        for (auto& s : samples) s = value++;
+
+        mbuf.addSamples(samples.data(), samples.size());
+        rbuf.addSamples(samples.data(), samples.size());
+        check();
+
+        if (sizes[k] != rbuf.size())
+        {
+            mbuf.resize(sizes[k]);
+            rbuf.resize(sizes[k]);
+            check();
+        }
+    }
+
+    mbuf.clear();
+    rbuf.clear();
+    check();
+    REQUIRE(mbuf.numValid() == 0);
+}
+
+TEST_CASE("MappedBuffer can be re-opened", "[memory, buffer, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString fileName = dir.path() + "/a.spbuf";
+
+    {
+        MappedBuffer buf(5, fileName);
+        double samples[] = {1, 2, 3, 4, 5, 6, 7};
+        buf.addSamples(samples, 3);
+        buf.addSamples(samples + 3, 4);
+        REQUIRE(buf.numValid() == 5);
+    }
+
+    QString error;
+    MappedBuffer* buf = MappedBuffer::open(fileName, &error);
+    REQUIRE(buf != nullptr);
+    REQUIRE(error.isEmpty());
+    REQUIRE(buf->size() == 5);
+    REQUIRE(buf->numValid() == 5);
+    for (unsigned i = 0; i < 5; i++)
+    {
+        REQUIRE(buf->sample(i) == i + 3);
+    }
+    REQUIRE(buf->limits().start == 3);
+    REQUIRE(buf->limits().end == 7);
+
+    // re-opened buffer keeps working
+    double more[] = {8};
+    buf->addSamples(more, 1);
+    REQUIRE(buf->sample(4) == 8);
+    delete buf;
+}
+
+TEST_CASE("MappedBuffer only opens valid files", "[memory, buffer, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString fileName = dir.path() + "/invalid.spbuf";
+
+    QString error;
+    REQUIRE(MappedBuffer::open(fileName, &error) == nullptr);
+    REQUIRE_FALSE(error.isEmpty());
+
+    QFile file(fileName);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(2 * MappedBuffer::DATA_OFFSET, 'x'));
+    file.close();
+
+    error.clear();
+    REQUIRE(MappedBuffer::open(fileName, &error) == nullptr);
+    REQUIRE(error == "not a buffer file");
+}
+
+TEST_CASE("MappedBuffer sync", "[memory, buffer, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    MappedBuffer buf(1000, dir.path() + "/a.spbuf");
+    REQUIRE(buf.sync());
+
+    QVector<double> samples(300, 1.5);
+    for (int i = 0; i < 5; i++) // wraps around
+    {
+        buf.addSamples(samples.data(), samples.size());
+        REQUIRE(buf.sync());
+    }
+    buf.resize(500);
+    REQUIRE(buf.sync());
+    buf.clear();
+    REQUIRE(buf.sync());
+}
@@ -0,0 +1,181 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <QVector>
+
+#include "merger.h"
+
+#include "catch.hpp"
+#include "test_helpers.h"
+
+/// Collects received samples of all channels
+class CollectingSink : public Sink
+{
+public:
+    unsigned nc = 0;
+    QVector<QVector<double>> received;
+
+protected:
+    void setNumChannels(unsigned nc, bool x) override
+        {
+            this->nc = nc;
+            received.fill(QVector<double>(), nc);
+            Sink::setNumChannels(nc, x);
+        };
+
+    void feedIn(const SamplePack& data) override
+        {
+            REQUIRE(data.numChannels() == nc);
+            for (unsigned ci = 0; ci < nc; ci++)
+            {
+                for (unsigned i = 0; i < data.numSamples(); i++)
+                {
+                    received[ci].append(data.data(ci)[i]);
+                }
+            }
+            Sink::feedIn(data);
+        };
+};
+
+/// Creates a pack where every channel has `ns` samples of `value`
+static SamplePack makePack(unsigned ns, unsigned nc, double value)
+{
+    SamplePack pack(ns, nc);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        for (unsigned i = 0; i < ns; i++)
+        {
+            pack.data(ci)[i] = value + i;
+        }
+    }
+    return pack;
+}
+
+TEST_CASE("merger passes single input through", "[merger]")
+{
+    Merger merger;
+    TestSource source(2, false);
+    CollectingSink sink;
+
+    source.connectSink(merger.input(0));
+    merger.connectSink(&sink);
+    REQUIRE(merger.numChannels() == 2);
+    REQUIRE(sink.nc == 2);
+
+    // an input without channels doesn't change anything
+    merger.addInput();
+    REQUIRE(merger.numChannels() == 2);
+
+    source._feed(makePack(5, 2, 10));
+    REQUIRE(sink.received[0].size() == 5);
+    REQUIRE(sink.received[1][4] == 14);
+}
+
+TEST_CASE("merger concatenates channels and aligns samples", "[merger]")
+{
+    Merger merger;
+    TestSource s1(1, false), s2(2, false);
+    CollectingSink sink;
+
+    auto in2 = merger.addInput();
+    s1.connectSink(merger.input(0));
+    s2.connectSink(in2);
+    merger.setInputActive(in2, true);
+    merger.connectSink(&sink);
+
+    REQUIRE(merger.numChannels() == 3);
+    REQUIRE(merger.channelOffset(merger.input(0)) == 0);
+    REQUIRE(merger.channelOffset(in2) == 1);
+
+    // nothing is output until both inputs have data
+    s1._feed(makePack(4, 1, 0));
+    REQUIRE(sink.received[0].size() == 0);
+
+    s2._feed(makePack(3, 2, 100));
+    REQUIRE(sink.received[0] == QVector<double>({0, 1, 2}));
+    REQUIRE(sink.received[1] == QVector<double>({100, 101, 102}));
+    REQUIRE(sink.received[2] == QVector<double>({100, 101, 102}));
+
+    s2._feed(makePack(2, 2, 103));
+    REQUIRE(sink.received[0] == QVector<double>({0, 1, 2, 3}));
+    REQUIRE(sink.received[1] == QVector<double>({100, 101, 102, 103}));
+}
+
+TEST_CASE("merger doesn't wait for stalled or inactive inputs", "[merger]")
+{
+    Merger merger;
+    TestSource s1(1, false), s2(1, false);
+    CollectingSink sink;
+
+    auto in2 = merger.addInput();
+    s1.connectSink(merger.input(0));
+    s2.connectSink(in2);
+    merger.connectSink(&sink);
+    REQUIRE(merger.numChannels() == 2);
+
+    // inactive input is filled with NaN
+    s1._feed(makePack(3, 1, 0));
+    REQUIRE(sink.received[0] == QVector<double>({0, 1, 2}));
+    REQUIRE(sink.received[1].size() == 3);
+    REQUIRE(std::isnan(sink.received[1][0]));
+
+    // data of inactive input is ignored
+    s2._feed(makePack(3, 1, 0));
+    REQUIRE(sink.received[0].size() == 3);
+
+    // stalled input is filled with NaN after max skew
+    merger.setInputActive(in2, true);
+    merger.setMaxSkew(4);
+    s2._feed(makePack(2, 1, 50));
+    s1._feed(makePack(8, 1, 10));
+    // 2 aligned samples, then samples that exceed the skew
+    REQUIRE(sink.received[0].size() == 3 + 4);
+    REQUIRE(sink.received[1][3] == 50);
+    REQUIRE(sink.received[1][4] == 51);
+    REQUIRE(std::isnan(sink.received[1][5]));
+    REQUIRE(sink.received[0][6] == 13);
+
+    // deactivating the stalled input releases queued samples
+    merger.setInputActive(in2, false);
+    REQUIRE(sink.received[0].size() == 3 + 8);
+    REQUIRE(sink.received[0][10] == 17);
+}
+
+TEST_CASE("removing a merger input", "[merger]")
+{
+    Merger merger;
+    TestSource s1(1, false), s2(2, false);
+    CollectingSink sink;
+
+    auto in2 = merger.addInput();
+    s1.connectSink(merger.input(0));
+    s2.connectSink(in2);
+    merger.connectSink(&sink);
+    REQUIRE(sink.nc == 3);
+
+    merger.removeInput(in2);
+    REQUIRE(merger.numInputs() == 1);
+    REQUIRE(sink.nc == 1);
+
+    // sink is disconnected from source
+    s2._feed(makePack(1, 2, 0));
+    s1._feed(makePack(2, 1, 0));
+    REQUIRE(sink.received[0].size() == 2);
+}
@@ -0,0 +1,200 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// This tells Catch to provide a main() - only do this in one cpp file per executable
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <string.h>
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUdpSocket>
+
+#include "binarystreamreader.h"
+#include "asciireader.h"
+#include "udpdevice.h"
+
+#include "test_helpers.h"
+
+static const int NETWORK_TIMEOUT = 5000; // milliseconds
+
+TEST_CASE("reader should follow device change", "[reader, network]")
+{
+    QBuffer dev1, dev2;
+    BinaryStreamReader bs(&dev1);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    dev1.open(QIODevice::ReadWrite);
+    dev2.open(QIODevice::ReadWrite);
+
+    bs.setDevice(&dev2);
+
+    dev1.write("\x01\x02", 2);
+    dev1.seek(0);
+    dev2.write("\x01\x02\x03", 3);
+    dev2.seek(0);
+
+    REQUIRE(waitUntil([&sink]{return sink.totalFed >= 3;}, 100));
+    // dev1 isn't read anymore
+    REQUIRE(dev1.bytesAvailable() == 2);
+}
+
+TEST_CASE("UdpDevice presents datagrams as a byte stream", "[network, udp]")
+{
+    UdpDevice device;
+    REQUIRE(device.bind(0, QHostAddress::LocalHost));
+    REQUIRE(device.isOpen());
+    REQUIRE(device.localPort() != 0);
+
+    QUdpSocket sender;
+    sender.writeDatagram("abc", 3, QHostAddress::LocalHost, device.localPort());
+    sender.writeDatagram("defg", 4, QHostAddress::LocalHost, device.localPort());
+
+    QByteArray received;
+    REQUIRE(waitUntil([&]
+                      {
+                          received += device.readAll();
+                          return received.size() >= 7;
+                      }));
+    REQUIRE(received == "abcdefg");
+    REQUIRE(device.datagramsReceived() == 2);
+    REQUIRE(device.bytesAvailable() == 0);
+
+    device.close();
+    REQUIRE_FALSE(device.isOpen());
+}
+
+TEST_CASE("reading ASCII lines over UDP", "[network, udp, ascii]")
+{
+    UdpDevice device;
+    REQUIRE(device.bind(0, QHostAddress::LocalHost));
+
+    AsciiReader reader(&device);
+    reader.enable(true);
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    // first line is dropped by the reader, last one is split in two datagrams
+    QUdpSocket sender;
+    for (const char* text : {"skipped\n1,2\n", "3,4\n5,", "6\n"})
+    {
+        sender.writeDatagram(text, strlen(text), QHostAddress::LocalHost, device.localPort());
+    }
+
+    REQUIRE(waitUntil([&sink]{return sink.totalFed >= 3;}));
+    REQUIRE(sink.totalFed == 3);
+    REQUIRE(sink._numChannels == 2);
+    REQUIRE(device.bytesAvailable() == 0);
+}
+
+TEST_CASE("reading UDP datagrams from a loopback device", "[network, udp, throughput]")
+{
+    UdpDevice device;
+    REQUIRE(device.bind(0, QHostAddress::LocalHost));
+
+    BinaryStreamReader bs(&device);
+    bs.enable(true);
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    // stand-in device
+    const int datagramSize = 1024;
+    const int numDatagrams = 4000;
+    const int batchSize = 50; // stay well below the socket buffer
+    QByteArray datagram(datagramSize, 0x55);
+    QUdpSocket sender;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < numDatagrams; i += batchSize)
+    {
+        for (int j = 0; j < batchSize; j++)
+        {
+            sender.writeDatagram(datagram, QHostAddress::LocalHost, device.localPort());
+        }
+        QCoreApplication::processEvents();
+    }
+
+    // UDP has no flow control, datagrams may be dropped on a busy machine
+    const int total = datagramSize * numDatagrams;
+    waitUntil([&sink, total]{return sink.totalFed >= total;});
+    qint64 elapsed = timer.elapsed();
+    REQUIRE(device.datagramsReceived() > 0);
+    REQUIRE(device.bytesAvailable() == 0);
+    REQUIRE(sink.totalFed == (int) device.datagramsReceived() * datagramSize);
+
+    WARN("UDP loopback throughput: " << throughput(sink.totalFed, elapsed) << " MB/s, "
+         << numDatagrams - (int) device.datagramsReceived() << " datagrams lost");
+}
+
+TEST_CASE("reading from a TCP loopback device", "[network, tcp, throughput]")
+{
+    QTcpServer server;
+    REQUIRE(server.listen(QHostAddress::LocalHost, 0));
+
+    QTcpSocket client;
+    BinaryStreamReader bs(&client);
+    bs.enable(true);
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    client.connectToHost(QHostAddress::LocalHost, server.serverPort(), QIODevice::ReadOnly);
+    REQUIRE(server.waitForNewConnection(NETWORK_TIMEOUT));
+    QTcpSocket* standIn = server.nextPendingConnection();
+    REQUIRE(standIn != nullptr);
+    REQUIRE(waitUntil([&client]{return client.state() == QAbstractSocket::ConnectedState;}));
+
+    const int chunkSize = 64 * 1024;
+    const int numChunks = 256; // 16 MB
+    QByteArray chunk(chunkSize, 0x33);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < numChunks; i++)
+    {
+        standIn->write(chunk);
+        // don't let the stand-in buffer everything in memory
+        if (standIn->bytesToWrite() > 4 * chunkSize)
+        {
+            QCoreApplication::processEvents();
+        }
+    }
+
+    const int total = chunkSize * numChunks;
+    REQUIRE(waitUntil([&sink, total]{return sink.totalFed >= total;}));
+    REQUIRE(sink.totalFed == total);
+
+    WARN("TCP loopback throughput: " << throughput(total, timer.elapsed()) << " MB/s");
+}
+
+// Note: this is added because `QApplication` must be created for widgets
+#include <QApplication>
+int main(int argc, char* argv[])
+{
+    QApplication a(argc, argv);
+
+    int result = Catch::Session().run( argc, argv );
+
+    return result;
+}
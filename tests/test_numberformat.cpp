@@ -0,0 +1,115 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <QtGlobal>
+
+#include "numberformat.h"
+
+#include "catch.hpp"
+
+TEST_CASE("number format names", "[numberformat]")
+{
+    for (int i = 0; i < NumberFormat_INVALID; i++)
+    {
+        NumberFormat nf = (NumberFormat) i;
+        REQUIRE(strToNumberFormat(numberFormatToStr(nf)) == nf);
+    }
+    REQUIRE(strToNumberFormat("int7") == NumberFormat_INVALID);
+
+    REQUIRE(numberFormatBits(NumberFormat_uint12) == 12);
+    REQUIRE(numberFormatSize(NumberFormat_uint12) == 0);
+    REQUIRE(numberFormatBits(NumberFormat_int24) == 24);
+    REQUIRE(numberFormatSize(NumberFormat_int24) == 3);
+    REQUIRE(numberFormatIsSigned(NumberFormat_int12));
+    REQUIRE_FALSE(numberFormatIsSigned(NumberFormat_uint24));
+
+    unsigned bits;
+    bool isSigned;
+    REQUIRE(strToBitFormat("uint10", &bits, &isSigned));
+    REQUIRE(bits == 10);
+    REQUIRE_FALSE(isSigned);
+    REQUIRE(strToBitFormat("int1", &bits, &isSigned));
+    REQUIRE(bits == 1);
+    REQUIRE(isSigned);
+    REQUIRE_FALSE(strToBitFormat("int0", &bits, &isSigned));
+    REQUIRE_FALSE(strToBitFormat("uint33", &bits, &isSigned));
+    REQUIRE_FALSE(strToBitFormat("float", &bits, &isSigned));
+}
+
+TEST_CASE("bit pack and unpack round trip", "[numberformat]")
+{
+    const unsigned n = 33;
+    const unsigned stride = 6;
+    quint32 x = 7;
+
+    for (bool bigEndian : {false, true})
+    for (unsigned bits = 1; bits <= 32; bits++)
+    for (unsigned shift = 0; shift < 8; shift++)
+    {
+        // neighbouring bits must survive packing
+        std::vector<uchar> data(n * stride, 0xA5);
+        std::vector<quint32> values;
+        for (unsigned i = 0; i < n; i++)
+        {
+            x = x * 1664525 + 1013904223;
+            quint32 v = bits < 32 ? x & ((1u << bits) - 1) : x;
+            // include extremes
+            if (i == 0) v = 0;
+            if (i == 1) v = bits < 32 ? (1u << bits) - 1 : 0xFFFFFFFF;
+            values.push_back(v);
+            packBits(v, &data[i * stride], shift, bits, bigEndian);
+        }
+
+        std::vector<double> unsignedOut(n), signedOut(n);
+        unpackBits(data.data(), stride, n, shift, bits, false, bigEndian, unsignedOut.data());
+        unpackBits(data.data(), stride, n, shift, bits, true, bigEndian, signedOut.data());
+
+        for (unsigned i = 0; i < n; i++)
+        {
+            REQUIRE(unsignedOut[i] == values[i]);
+            double expected = values[i];
+            if (values[i] >> (bits - 1)) expected -= double(quint64(1) << bits);
+            REQUIRE(signedOut[i] == expected);
+
+            // bytes outside of the value are untouched
+            unsigned last = (shift + bits - 1) / 8;
+            for (unsigned b = last + 1; b < stride; b++)
+            {
+                REQUIRE(data[i * stride + b] == 0xA5);
+            }
+        }
+    }
+}
+
+TEST_CASE("bit packing order", "[numberformat]")
+{
+    uchar data[2] = {0, 0};
+    packBits(0x5, data, 2, 3, false);
+    REQUIRE(data[0] == 0x14);
+    // overlapping bits are replaced
+    packBits(0x5, data, 2, 3, true);
+    REQUIRE(data[0] == (0x04 | 0x28));
+
+    // 10 bits crossing a byte boundary
+    uchar be[2] = {0, 0};
+    packBits(0x3FF, be, 4, 10, true);
+    REQUIRE(be[0] == 0x0F);
+    REQUIRE(be[1] == 0xFC);
+}
@@ -0,0 +1,193 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// This tells Catch to provide a main() - only do this in one cpp file per executable
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QFile>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+#include "binarystreamreader.h"
+#include "asciireader.h"
+#include "pipedevice.h"
+
+#include "test_helpers.h"
+
+static bool writeFile(QString fileName, const QByteArray& data, bool append = false)
+{
+    QFile file(fileName);
+    if (!file.open(append ? QIODevice::Append : QIODevice::WriteOnly)) return false;
+    return file.write(data) == data.size();
+}
+
+TEST_CASE("PipeDevice fails for non existing path", "[pipe]")
+{
+    PipeDevice device;
+    REQUIRE_FALSE(device.openPath("/this/path/does/not/exist"));
+    REQUIRE_FALSE(device.isOpen());
+    REQUIRE_FALSE(device.errorString().isEmpty());
+}
+
+TEST_CASE("PipeDevice reads and follows a regular file", "[pipe, file]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString fileName = dir.path() + "/input.bin";
+
+    QByteArray data;
+    for (int i = 0; i < 100000; i++) data.append(char(i));
+    REQUIRE(writeFile(fileName, data));
+
+    PipeDevice device;
+    REQUIRE(device.openPath(fileName));
+    REQUIRE(device.isOpen());
+    REQUIRE(device.isSequential());
+
+    QByteArray received;
+    REQUIRE(waitUntil([&]
+                      {
+                          received += device.readAll();
+                          return received.size() >= data.size();
+                      }));
+    REQUIRE(received == data);
+
+    // appended data is read as well
+    REQUIRE(writeFile(fileName, "tail", true));
+    received.clear();
+    REQUIRE(waitUntil([&]
+                      {
+                          received += device.readAll();
+                          return received.size() >= 4;
+                      }));
+    REQUIRE(received == "tail");
+    REQUIRE_FALSE(device.atInputEnd());
+
+    device.close();
+    REQUIRE_FALSE(device.isOpen());
+    REQUIRE(device.bytesAvailable() == 0);
+}
+
+#ifdef Q_OS_UNIX
+TEST_CASE("PipeDevice reads from a FIFO across writers", "[pipe, fifo]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QByteArray fifoName = (dir.path() + "/input.fifo").toLocal8Bit();
+    REQUIRE(mkfifo(fifoName.constData(), 0600) == 0);
+
+    PipeDevice device;
+    REQUIRE(device.openPath(QString::fromLocal8Bit(fifoName)));
+
+    // no writer yet, device should just wait
+    QCoreApplication::processEvents();
+    REQUIRE(device.bytesAvailable() == 0);
+    REQUIRE_FALSE(device.atInputEnd());
+
+    for (const char* text : {"first", "second"})
+    {
+        int writer = open(fifoName.constData(), O_WRONLY | O_NONBLOCK);
+        REQUIRE(writer >= 0);
+        REQUIRE(write(writer, text, strlen(text)) == (ssize_t) strlen(text));
+        close(writer);
+
+        QByteArray received;
+        REQUIRE(waitUntil([&]
+                          {
+                              received += device.readAll();
+                              return received.size() >= (int) strlen(text);
+                          }));
+        REQUIRE(received == text);
+        REQUIRE_FALSE(device.atInputEnd());
+    }
+}
+#endif
+
+TEST_CASE("reading lines from a file with AsciiReader", "[pipe, file, ascii]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString fileName = dir.path() + "/input.csv";
+
+    // first line is dropped by the reader as it may be partial
+    QByteArray data = "partial\n";
+    for (int i = 0; i < 1000; i++) data += QByteArray::number(i) + ",1,2\n";
+    REQUIRE(writeFile(fileName, data));
+
+    PipeDevice device;
+    AsciiReader reader(&device);
+    reader.enable(true);
+    TestSink sink;
+    reader.connectSink(&sink);
+
+    REQUIRE(device.openPath(fileName));
+    REQUIRE(waitUntil([&sink]{return sink.totalFed >= 1000;}));
+    REQUIRE(sink.totalFed == 1000);
+    REQUIRE(sink._numChannels == 3);
+
+    // a line is read only when it's complete
+    REQUIRE(writeFile(fileName, "5,6", true));
+    REQUIRE(waitUntil([&device]{return device.bytesAvailable() == 3;}));
+    REQUIRE_FALSE(device.canReadLine());
+    REQUIRE(writeFile(fileName, ",7\n", true));
+    REQUIRE(waitUntil([&sink]{return sink.totalFed == 1001;}));
+}
+
+TEST_CASE("reading a file with a reader", "[pipe, file, throughput]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString fileName = dir.path() + "/input.bin";
+
+    const int total = 64 * 1024 * 1024;
+    REQUIRE(writeFile(fileName, QByteArray(total, 0x55)));
+
+    PipeDevice device;
+    BinaryStreamReader bs(&device);
+    bs.enable(true);
+    TestSink sink;
+    bs.connectSink(&sink);
+
+    QElapsedTimer timer;
+    timer.start();
+    REQUIRE(device.openPath(fileName));
+
+    REQUIRE(waitUntil([&sink, total]{return sink.totalFed >= total;}, 60000));
+    REQUIRE(sink.totalFed == total);
+
+    WARN("File input throughput: " << throughput(total, timer.elapsed()) << " MB/s");
+}
+
+// Note: this is added because `QApplication` must be created for widgets
+#include <QApplication>
+int main(int argc, char* argv[])
+{
+    QApplication a(argc, argv);
+
+    int result = Catch::Session().run( argc, argv );
+
+    return result;
+}
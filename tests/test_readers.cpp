@@ -23,10 +23,17 @@
 
 #include <QSignalSpy>
 #include <QBuffer>
+#include <QSettings>
+#include <QTemporaryFile>
+#include <QElapsedTimer>
 #include "binarystreamreader.h"
 #include "asciireader.h"
 #include "framedreader.h"
 #include "demoreader.h"
+#include "packetreader.h"
+#include "bytestuffing.h"
+#include "checksum.h"
+#include "setting_defines.h"
 
 #include "test_helpers.h"
 
@@ -76,6 +83,34 @@ TEST_CASE("disabled BinaryStreamReader shouldn't read", "[reader]")
     REQUIRE(sink.totalFed == 0);
 }
 
+TEST_CASE("BinaryStreamReader with mixed type layout", "[reader, layout]")
+{
+    QBuffer bufferDev;
+    BinaryStreamReader bs(&bufferDev);
+
+    QTemporaryFile file;
+    REQUIRE(file.open());
+    QSettings settings(file.fileName(), QSettings::IniFormat);
+    settings.beginGroup(SettingGroup_Binary);
+    settings.setValue(SG_Binary_Layout, "uint8 a; pad 1; int16 b");
+    settings.endGroup();
+    bs.loadSettings(&settings);
+    bs.enable(true);
+
+    TestSink sink;
+    bs.connectSink(&sink);
+    REQUIRE(sink._numChannels == 2);
+
+    bufferDev.open(QIODevice::ReadWrite);
+    const uint8_t data[] = {0x01, 0xFF, 0x02, 0x00, 0x03, 0xFF, 0xFE, 0xFF, 0x04};
+    bufferDev.write((const char*) data, 9);
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(sink.totalFed == 2);   // last byte is left
+}
+
 TEST_CASE("reading data with AsciiReader", "[reader, ascii]")
 {
     QBuffer bufferDev;
@@ -100,6 +135,37 @@ TEST_CASE("reading data with AsciiReader", "[reader, ascii]")
     REQUIRE(sink.totalFed == 3);
 }
 
+TEST_CASE("reading key/value lines with AsciiReader", "[reader, ascii]")
+{
+    QBuffer bufferDev;
+    AsciiReader reader(&bufferDev);
+
+    QTemporaryFile file;
+    REQUIRE(file.open());
+    QSettings settings(file.fileName(), QSettings::IniFormat);
+    settings.beginGroup(SettingGroup_ASCII);
+    settings.setValue(SG_ASCII_KeyValue, true);
+    settings.setValue(SG_ASCII_Keys, "b");
+    settings.endGroup();
+    reader.loadSettings(&settings);
+    reader.enable(true);
+
+    TestSink sink;
+    reader.connectSink(&sink);
+    REQUIRE(sink._numChannels == 1);
+
+    // first line is skipped as it may be partial
+    bufferDev.open(QIODevice::ReadWrite);
+    bufferDev.write("=1\na=1 b=2\nc:3\n{\"a\": 4}\ninvalid\n");
+    bufferDev.seek(0);
+
+    QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+    REQUIRE(spy.wait(READYREAD_TIMEOUT));
+    REQUIRE(reader.numChannels() == 3);
+    REQUIRE(sink._numChannels == 3);
+    REQUIRE(sink.totalFed == 3);
+}
+
 TEST_CASE("AsciiReader shouldn't read when disabled", "[reader, ascii]")
 {
     QBuffer bufferDev;
@@ -166,6 +232,159 @@ TEST_CASE("FramedReader shouldn't read when disabled", "[reader]")
     REQUIRE(sink.totalFed == 0);
 }
 
+/// Makes a frame with default sync word, 1 byte size field and little endian checksum
+static QByteArray checksumFrame(QByteArray payload, ChecksumType type)
+{
+    QByteArray frame("\xAA\xBB", 2);
+    frame.append(char(payload.size()));
+    frame.append(payload);
+
+    quint32 cs = calcChecksum(type, (const uchar*) payload.constData(), payload.size());
+    for (unsigned i = 0; i < checksumSize(type); i++)
+    {
+        frame.append(char(cs >> (8 * i)));
+    }
+    return frame;
+}
+
+static void setChecksumType(FramedReader* reader, ChecksumType type)
+{
+    QTemporaryFile file;
+    REQUIRE(file.open());
+    QSettings settings(file.fileName(), QSettings::IniFormat);
+    settings.beginGroup(SettingGroup_CustomFrame);
+    settings.setValue(SG_CustomFrame_ChecksumType, checksumTypeToStr(type));
+    settings.endGroup();
+    reader->loadSettings(&settings);
+}
+
+TEST_CASE("FramedReader checks checksums", "[reader, checksum]")
+{
+    for (int t = ChecksumType_Sum8; t < ChecksumType_INVALID; t++)
+    {
+        auto type = static_cast<ChecksumType>(t);
+        INFO("checksum: " << checksumTypeToStr(type).toStdString());
+
+        QBuffer bufferDev;
+        FramedReader reader(&bufferDev);
+        setChecksumType(&reader, type);
+        reader.enable(true);
+
+        TestSink sink;
+        reader.connectSink(&sink);
+
+        QByteArray good = checksumFrame(QByteArray("\x01\x02\x03\x04", 4), type);
+        QByteArray bad = checksumFrame(QByteArray("\x05\x06\x07\x08", 4), type);
+        bad[4] = bad[4] + 1;    // corrupt payload
+
+        bufferDev.open(QIODevice::ReadWrite);
+        bufferDev.write(good + bad + good);
+        bufferDev.seek(0);
+
+        QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+        REQUIRE(spy.wait(READYREAD_TIMEOUT));
+        REQUIRE(sink.totalFed == 8);
+    }
+}
+
+TEST_CASE("FramedReader throughput with checksum", "[reader, checksum, benchmark]")
+{
+    const int numFrames = 20000;
+    QByteArray payload(64, 0);
+    for (int i = 0; i < payload.size(); i++) payload[i] = i;
+
+    double rate[2];
+    ChecksumType types[2] = {ChecksumType_None, ChecksumType_CRC32};
+    for (int t = 0; t < 2; t++)
+    {
+        QBuffer bufferDev;
+        FramedReader reader(&bufferDev);
+        setChecksumType(&reader, types[t]);
+        reader.enable(true);
+
+        TestSink sink;
+        reader.connectSink(&sink);
+
+        QByteArray frame = checksumFrame(payload, types[t]);
+        bufferDev.open(QIODevice::ReadWrite);
+        bufferDev.write(frame.repeated(numFrames));
+        bufferDev.seek(0);
+
+        QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+        QElapsedTimer timer;
+        timer.start();
+        REQUIRE(spy.wait(1000));
+        rate[t] = numFrames / (timer.nsecsElapsed() / 1e9);
+        REQUIRE(sink.totalFed == numFrames * payload.size());
+
+        WARN(checksumTypeToStr(types[t]).toStdString() << ": " << rate[t] << " frames/s");
+    }
+
+    // checksum shouldn't be the bottleneck
+    REQUIRE(rate[1] > rate[0] / 2);
+}
+
+/// Makes a packet with little endian checksum appended before encoding
+static QByteArray encodedPacket(QByteArray payload, ChecksumType type, bool cobs)
+{
+    quint32 cs = calcChecksum(type, (const uchar*) payload.constData(), payload.size());
+    for (unsigned i = 0; i < checksumSize(type); i++)
+    {
+        payload.append(char(cs >> (8 * i)));
+    }
+    return cobs ? cobsEncode(payload) : slipEncode(payload);
+}
+
+TEST_CASE("reading packets with PacketReader", "[reader, packet]")
+{
+    for (auto encoding : {"cobs", "slip"})
+    {
+        bool cobs = QString(encoding) == "cobs";
+        INFO("encoding: " << encoding);
+
+        QBuffer bufferDev;
+        PacketReader reader(&bufferDev);
+
+        QTemporaryFile file;
+        REQUIRE(file.open());
+        QSettings settings(file.fileName(), QSettings::IniFormat);
+        settings.beginGroup(SettingGroup_Packet);
+        settings.setValue(SG_Packet_Encoding, encoding);
+        settings.setValue(SG_Packet_Layout, "uint8 a; int16 b");
+        settings.setValue(SG_Packet_Checksum, checksumTypeToStr(ChecksumType_CRC16_CCITT));
+        settings.endGroup();
+        reader.loadSettings(&settings);
+        reader.enable(true);
+
+        TestSink sink;
+        reader.connectSink(&sink);
+        REQUIRE(sink._numChannels == 2);
+
+        // payloads contain delimiter and escape bytes
+        QByteArray one("\x00\xC0\xDB", 3);
+        QByteArray two("\xC0\x00\x00\x01\xDB\xC0", 6);
+        QByteArray bad = encodedPacket(one, ChecksumType_CRC16_CCITT, cobs);
+        bad[1] = bad[1] ^ 0x01;
+
+        QByteArray stream;
+        stream.append(QByteArray("\x11\x22\x33", 3));    // partial packet, skipped
+        stream.append(cobs ? '\x00' : '\xC0');
+        stream.append(encodedPacket(one, ChecksumType_CRC16_CCITT, cobs));
+        stream.append(bad);
+        stream.append(encodedPacket(two, ChecksumType_CRC16_CCITT, cobs));
+        stream.append(encodedPacket(two.left(4), ChecksumType_CRC16_CCITT, cobs)); // wrong size
+        stream.append(encodedPacket(one, ChecksumType_CRC16_CCITT, cobs).left(3)); // incomplete
+
+        bufferDev.open(QIODevice::ReadWrite);
+        bufferDev.write(stream);
+        bufferDev.seek(0);
+
+        QSignalSpy spy(&bufferDev, SIGNAL(readyRead()));
+        REQUIRE(spy.wait(READYREAD_TIMEOUT));
+        REQUIRE(sink.totalFed == 3);
+    }
+}
+
 TEST_CASE("Generating data with DemoReader", "[reader, demo]")
 {
     QBuffer bufferDev;          // not actually used
@@ -105,3 +105,39 @@ TEST_CASE("test recording multiple channels", "[recorder]")
     // cleanup
     if (QFile::exists(fileName)) QFile::remove(fileName);
 }
+
+TEST_CASE("test recording summary", "[recorder]")
+{
+    DataRecorder rec;
+    rec.writeSummary = true;
+    rec.setDecimals(2);
+    TestSource source(2, false);
+
+    auto fileName = QDir::tempPath() + QString("/" TEST_FILE_NAME);
+    auto summaryName = DataRecorder::summaryFileName(fileName);
+    REQUIRE(summaryName == QDir::tempPath() + "/sp_test_recording_summary.csv");
+    if (QFile::exists(fileName)) QFile::remove(fileName);
+    if (QFile::exists(summaryName)) QFile::remove(summaryName);
+
+    source.connectSink(&rec);
+
+    SamplePack samples(4, 2);
+    for (int i = 0; i < 4; i++)
+    {
+        samples.data(0)[i] = i+1;   // 1, 2, 3, 4
+        samples.data(1)[i] = -2;
+    }
+
+    rec.startRecording(fileName, ",", QStringList({"A", "B"}), DataRecorder::TimestampOption::disabled);
+    source._feed(samples);
+    rec.stopRecording();
+
+    QFile summaryFile(summaryName);
+    REQUIRE(summaryFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    REQUIRE((summaryFile.readLine() == "channel,count,mean,rms,min,max,std_dev,peak_to_peak\n"));
+    REQUIRE((summaryFile.readLine() == "A,4,2.50,2.74,1.00,4.00,1.12,3.00\n"));
+    REQUIRE((summaryFile.readLine() == "B,4,-2.00,2.00,-2.00,-2.00,0.00,0.00\n"));
+
+    if (QFile::exists(fileName)) QFile::remove(fileName);
+    if (QFile::exists(summaryName)) QFile::remove(summaryName);
+}
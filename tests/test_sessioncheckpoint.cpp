@@ -0,0 +1,182 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// This tells Catch to provide a main() - only do this in one cpp file per executable
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <QTemporaryDir>
+#include <QFileInfo>
+#include <QDir>
+#include <QCoreApplication>
+
+#include "stream.h"
+#include "mappedbuffer.h"
+#include "sessioncheckpoint.h"
+
+#include "test_helpers.h"
+
+static void feed(TestSource* source, unsigned nc, unsigned ns, double start)
+{
+    SamplePack pack(ns, nc, false);
+    for (unsigned ci = 0; ci < nc; ci++)
+    {
+        for (unsigned i = 0; i < ns; i++)
+        {
+            pack.data(ci)[i] = ci * 1000 + start + i;
+        }
+    }
+    source->_feed(pack);
+}
+
+/// Returns true if buffer file contents matches the stream channel
+static bool matches(QString fileName, const Stream& stream, unsigned ci)
+{
+    QString error;
+    MappedBuffer* buf = MappedBuffer::open(fileName, &error);
+    if (buf == nullptr) return false;
+
+    const FrameBuffer* y = stream.channel(ci)->yData();
+    bool equal = buf->size() == y->size();
+    for (unsigned i = 0; equal && i < y->size(); i++)
+    {
+        equal = buf->sample(i) == y->sample(i);
+    }
+    delete buf;
+    return equal;
+}
+
+TEST_CASE("session checkpoint follows the stream", "[session, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString file0 = dir.path() + "/channel_0.spbuf";
+    QString file1 = dir.path() + "/channel_1.spbuf";
+    QString file2 = dir.path() + "/channel_2.spbuf";
+
+    Stream stream(2, false, 100);
+    TestSource source(2, false);
+    source.connectSink(&stream);
+
+    SessionCheckpoint cp(&stream, dir.path());
+    REQUIRE(cp.lastSessionFiles().isEmpty());
+    cp.start();
+    REQUIRE(cp.isActive());
+
+    feed(&source, 2, 30, 0);
+    cp.checkpoint();
+    cp.waitForFinished();
+    REQUIRE(matches(file0, stream, 0));
+    REQUIRE(matches(file1, stream, 1));
+
+    // incremental, wraps around
+    feed(&source, 2, 90, 30);
+    cp.checkpoint();
+    cp.waitForFinished();
+    REQUIRE(matches(file0, stream, 0));
+    REQUIRE(matches(file1, stream, 1));
+
+    // number of channels and buffer size changes
+    source._setNumChannels(3, false);
+    stream.setNumSamples(150);
+    feed(&source, 3, 10, 200);
+    cp.checkpoint();
+    cp.waitForFinished();
+    for (unsigned ci = 0; ci < 3; ci++)
+    {
+        REQUIRE(matches(QString("%1/channel_%2.spbuf").arg(dir.path()).arg(ci), stream, ci));
+    }
+
+    source._setNumChannels(1, false);
+    feed(&source, 1, 10, 300);
+    cp.checkpoint();
+    cp.waitForFinished();
+    REQUIRE(matches(file0, stream, 0));
+    REQUIRE_FALSE(QFileInfo(file1).exists());
+
+    // files are removed when stopped properly
+    cp.stop();
+    REQUIRE_FALSE(cp.isActive());
+    REQUIRE_FALSE(QFileInfo(file0).exists());
+    REQUIRE_FALSE(QFileInfo(file2).exists());
+}
+
+TEST_CASE("session files are left after an unfinished session", "[session, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    Stream stream(2, false, 100);
+    TestSource source(2, false);
+    source.connectSink(&stream);
+
+    {
+        SessionCheckpoint cp(&stream, dir.path());
+        cp.start();
+        feed(&source, 2, 50, 0);
+        cp.checkpoint();
+        cp.waitForFinished();
+
+        // another instance can't use the same directory
+        SessionCheckpoint other(&stream, dir.path());
+        REQUIRE(other.lastSessionFiles().isEmpty());
+        other.start();
+        REQUIRE_FALSE(other.isActive());
+
+        // simulate a crash: copy the files before they are removed
+        REQUIRE(QDir().mkpath(dir.path() + "/crash"));
+        for (unsigned ci = 0; ci < 2; ci++)
+        {
+            QString name = QString("/channel_%1.spbuf").arg(ci);
+            REQUIRE(QFile::copy(dir.path() + name, dir.path() + "/crash" + name));
+        }
+    }
+
+    SessionCheckpoint next(&stream, dir.path() + "/crash");
+    QStringList files = next.lastSessionFiles();
+    REQUIRE(files.size() == 2);
+
+    // restored files are moved out of the way of new checkpoints
+    files = next.takeLastSessionFiles();
+    REQUIRE(files.size() == 2);
+    REQUIRE(QFileInfo(files[0]).dir().dirName() == SessionCheckpoint::RESTORED_DIR);
+    REQUIRE(next.lastSessionFiles().isEmpty());
+
+    MappedBuffer* buf = MappedBuffer::open(files[1]);
+    REQUIRE(buf != nullptr);
+
+    next.start();
+    next.checkpoint();
+    next.waitForFinished();
+
+    // still intact while new checkpoints are taken
+    REQUIRE(QFileInfo(files[1]).isFile());
+    REQUIRE(buf->numValid() == 50);
+    REQUIRE(buf->sample(99) == 1049);
+    delete buf;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    int result = Catch::Session().run( argc, argv );
+
+    return result;
+}
@@ -17,7 +17,12 @@
   along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+
 #include "stream.h"
+#include "mappedbuffer.h"
 
 #include "catch.hpp"
 #include "test_helpers.h"
@@ -64,6 +69,64 @@ TEST_CASE("changing stream number of channels via sink", "[memory, stream, sink]
         REQUIRE(c->index() == i);
     }
 
+TEST_CASE("file backed buffers of previous session are kept", "[memory, stream, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    QString marker = QString("%1/%2").arg(dir.path()).arg(Stream::OPEN_MARKER_FILE);
+
+    auto runSession = [&dir, &marker]()
+        {
+            Stream s(2, false, 10);
+            s.setBufferDirectory(dir.path());
+            REQUIRE(QFile::exists(marker));
+
+            SamplePack pack(5, 2, false);
+            for (unsigned i = 0; i < 5; i++)
+            {
+                pack.data(0)[i] = i;
+                pack.data(1)[i] = -1;
+            }
+            TestSource so(2, false);
+            so.connectSink(&s);
+            so._feed(pack);
+        };
+
+    runSession();
+    // stream was destroyed normally
+    REQUIRE_FALSE(QFile::exists(marker));
+
+    {
+        // buffers of a clean session are overwritten
+        Stream s(2, false, 10);
+        s.setBufferDirectory(dir.path());
+        REQUIRE(s.previousBufferFiles().isEmpty());
+        REQUIRE(s.channel(0)->yData()->sample(9) == 0);
+    }
+
+    runSession();
+    // simulate a session that didn't end properly
+    {
+        QFile f(marker);
+        REQUIRE(f.open(QIODevice::WriteOnly));
+    }
+
+    // restart with the same directory
+    Stream s(2, false, 10);
+    s.setBufferDirectory(dir.path());
+    QStringList files = s.previousBufferFiles();
+    REQUIRE(files.size() == 2);
+
+    MappedBuffer* buf = MappedBuffer::open(files[0]);
+    REQUIRE(buf != nullptr);
+    REQUIRE(buf->numValid() == 5);
+    REQUIRE(buf->sample(9) == 4);
+    delete buf;
+
+    // new buffers start empty
+    REQUIRE(s.channel(0)->yData()->sample(9) == 0);
+}
+
 // TODO: enable test when `Stream` supports X channel
 #if 0
     // increase nc value, add X
@@ -130,6 +193,47 @@ TEST_CASE("adding data to a stream with no X", "[memory, stream, data, sink]")
     }
 }
 
+TEST_CASE("stream with file backed buffers", "[memory, stream, data, mapped]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    Stream s(2, false, 10);
+    s.setBufferDirectory(dir.path());
+    REQUIRE(s.bufferDirectory() == dir.path());
+
+    SamplePack pack(5, 2, false);
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        for (unsigned i = 0; i < 5; i++)
+        {
+            pack.data(ci)[i] = ci * 10 + i;
+        }
+    }
+
+    TestSource so(2, false);
+    so.connectSink(&s);
+    so._feed(pack);
+
+    // new channels use files as well
+    so._setNumChannels(3, false);
+    REQUIRE(QFileInfo(dir.path() + "/channel_2.spbuf").isFile());
+
+    s.setNumSamples(20);
+    for (unsigned ci = 0; ci < 2; ci++)
+    {
+        const FrameBuffer* y = s.channel(ci)->yData();
+        REQUIRE(y->size() == 20);
+        for (unsigned i = 0; i < 5; i++)
+        {
+            REQUIRE(y->sample(15 + i) == ci * 10 + i);
+        }
+    }
+
+    s.clear();
+    REQUIRE(s.channel(0)->yData()->sample(19) == 0);
+}
+
 // TODO: enable test when `Stream` supports X channel
 #if 0
 TEST_CASE("adding data to a stream with X", "[memory, stream, data, sink]")
@@ -185,6 +289,95 @@ TEST_CASE("adding data to a stream with X", "[memory, stream, data, sink]")
 }
 #endif
 
+TEST_CASE("stream should count added samples", "[memory, stream, data, sink]")
+{
+    Stream s(3, false, 10);
+    SamplePack pack(5, 3, false);
+
+    TestSource so(3, false);
+    so.connectSink(&s);
+
+    REQUIRE(s.totalSamples() == 0);
+    so._feed(pack);
+    REQUIRE(s.totalSamples() == 5);
+    so._feed(pack);
+    REQUIRE(s.totalSamples() == 10);
+
+    // paused stream doesn't count
+    s.pause(true);
+    so._feed(pack);
+    REQUIRE(s.totalSamples() == 10);
+}
+
+TEST_CASE("stream should calculate channel statistics", "[stream, stats]")
+{
+    Stream s(2, false, 4);
+    SamplePack pack(6, 2, false);
+    for (unsigned i = 0; i < 6; i++)
+    {
+        pack.data(0)[i] = i;
+        pack.data(1)[i] = -1;
+    }
+
+    TestSource so(2, false);
+    so.connectSink(&s);
+    so._feed(pack);
+
+    // total statistics include all samples, window is the buffer
+    REQUIRE(s.stats(0).total().count == 6);
+    REQUIRE(s.stats(0).total().mean == Approx(2.5));
+    REQUIRE(s.stats(0).windowed().count == 4);
+    REQUIRE(s.stats(0).windowed().min == 2);
+    REQUIRE(s.stats(0).windowed().max == 5);
+    REQUIRE(s.stats(0).windowed().mean == Approx(3.5));
+    REQUIRE(s.stats(1).windowed().rms == Approx(1));
+
+    // statistics are published to info model
+    auto model = s.infoModel();
+    REQUIRE(model->data(model->index(0, ChannelInfoModel::COLUMN_NUM_SAMPLES)).toString() == "6");
+    REQUIRE(model->data(model->index(0, ChannelInfoModel::COLUMN_PEAK_TO_PEAK)).toString() == "3");
+
+    s.clear();
+    REQUIRE(s.stats(0).total().count == 0);
+}
+
+TEST_CASE("stream should apply calibration before gain and offset", "[stream, calibration]")
+{
+    Stream s(2, false, 4);
+    auto model = s.infoModel();
+    REQUIRE_FALSE(model->calibrationEn());
+
+    // x^2 on first channel, doubled with gain
+    REQUIRE(model->setData(model->index(0, ChannelInfoModel::COLUMN_CALIBRATION), "poly: 0, 0, 1"));
+    REQUIRE(model->setData(model->index(0, ChannelInfoModel::COLUMN_GAIN), 2.0));
+    REQUIRE(model->setData(model->index(0, ChannelInfoModel::COLUMN_GAIN), Qt::Checked, Qt::CheckStateRole));
+    // table on second channel
+    REQUIRE(model->setData(model->index(1, ChannelInfoModel::COLUMN_CALIBRATION), "table: 0=0, 10=100"));
+    // invalid calibration is rejected
+    REQUIRE_FALSE(model->setData(model->index(1, ChannelInfoModel::COLUMN_CALIBRATION), "table: 0=0"));
+    REQUIRE(model->calibrationEn());
+
+    SamplePack pack(4, 2, false);
+    for (unsigned i = 0; i < 4; i++)
+    {
+        pack.data(0)[i] = i;
+        pack.data(1)[i] = i + 0.5;
+    }
+
+    TestSource so(2, false);
+    so.connectSink(&s);
+    so._feed(pack);
+
+    for (unsigned i = 0; i < 4; i++)
+    {
+        REQUIRE(s.channel(0)->yData()->sample(i) == Approx(2 * i * i));
+        REQUIRE(s.channel(1)->yData()->sample(i) == Approx(10 * (i + 0.5)));
+    }
+
+    model->resetCalibrations();
+    REQUIRE_FALSE(model->calibrationEn());
+}
+
 TEST_CASE("paused stream shouldn't store data", "[memory, stream, pause]")
 {
     Stream s(3, false, 10);
@@ -0,0 +1,207 @@
+/*
+  Copyright © 2022 Hasan Yavuz Özderya
+
+  This file is part of serialplot.
+
+  serialplot is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  serialplot is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with serialplot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QVector>
+
+#include "trigger.h"
+#include "stream.h"
+
+#include "catch.hpp"
+#include "test_helpers.h"
+
+/// Makes a single channel pack from given values
+static SamplePack makePack(QVector<double> values)
+{
+    SamplePack pack(values.size(), 1);
+    for (int i = 0; i < values.size(); i++)
+    {
+        pack.data(0)[i] = values[i];
+    }
+    return pack;
+}
+
+static QVector<double> frameData(const SamplePack* frame)
+{
+    QVector<double> r;
+    for (unsigned i = 0; i < frame->numSamples(); i++)
+    {
+        r.append(frame->data(0)[i]);
+    }
+    return r;
+}
+
+TEST_CASE("trigger on rising edge", "[trigger]")
+{
+    Trigger t;
+    t.setMode(Trigger::Normal);
+    t.setLevel(0.5);
+    t.setDepth(2, 3);
+
+    auto frame = t.feed(makePack({0, 0, 0, 0, 1, 1, 1, 1, 0, 0}));
+    REQUIRE(frame != nullptr);
+    REQUIRE(frameData(frame) == QVector<double>({0, 0, 1, 1, 1}));
+}
+
+TEST_CASE("trigger on falling edge", "[trigger]")
+{
+    Trigger t;
+    t.setMode(Trigger::Normal);
+    t.setEdge(Trigger::Falling);
+    t.setLevel(0.5);
+    t.setDepth(1, 2);
+
+    // rising edge shouldn't trigger
+    REQUIRE(t.feed(makePack({0, 0, 1, 1})) == nullptr);
+
+    auto frame = t.feed(makePack({1, 0, 0}));
+    REQUIRE(frame != nullptr);
+    REQUIRE(frameData(frame) == QVector<double>({1, 0, 0}));
+}
+
+TEST_CASE("trigger should wait for post trigger samples", "[trigger]")
+{
+    Trigger t;
+    t.setMode(Trigger::Normal);
+    t.setLevel(0.5);
+    t.setDepth(2, 3);
+
+    REQUIRE(t.feed(makePack({0, 0, 0, 0, 1})) == nullptr);
+    REQUIRE(t.feed(makePack({2})) == nullptr);
+
+    auto frame = t.feed(makePack({3, 0}));
+    REQUIRE(frame != nullptr);
+    REQUIRE(frameData(frame) == QVector<double>({0, 0, 1, 2, 3}));
+}
+
+TEST_CASE("trigger with no post trigger samples", "[trigger]")
+{
+    Trigger t;
+    t.setMode(Trigger::Normal);
+    t.setLevel(0.5);
+    t.setDepth(2, 0);
+
+    auto frame = t.feed(makePack({0, 0, 1, 1, 0, 1}));
+    REQUIRE(frame != nullptr);
+    // last crossing wins
+    REQUIRE(frameData(frame) == QVector<double>({1, 0}));
+    REQUIRE(t.feed(makePack({1, 1})) == nullptr);
+}
+
+TEST_CASE("trigger should ignore crossing without pre trigger history", "[trigger]")
+{
+    Trigger t;
+    t.setMode(Trigger::Normal);
+    t.setLevel(0.5);
+    t.setDepth(3, 1);
+
+    REQUIRE(t.feed(makePack({0, 1, 1, 1})) == nullptr);
+
+    auto frame = t.feed(makePack({0, 0, 1}));
+    REQUIRE(frame != nullptr);
+    REQUIRE(frameData(frame) == QVector<double>({1, 0, 0, 1}));
+}
+
+TEST_CASE("trigger should find crossings in long packs", "[trigger]")
+{
+    Trigger t;
+    t.setMode(Trigger::Normal);
+    t.setLevel(10.5);
+    t.setDepth(1, 1);
+
+    // crossings at 11, 51 and 90
+    QVector<double> data;
+    for (int i = 0; i < 100; i++) data.append(i % 40 + (i / 40) * 0.25);
+
+    // latest frame is returned
+    auto frame = t.feed(makePack(data));
+    REQUIRE(frame != nullptr);
+    REQUIRE(frameData(frame) == QVector<double>({9.5, 10.5}));
+}
+
+TEST_CASE("single trigger mode", "[trigger]")
+{
+    Trigger t;
+    t.setMode(Trigger::Single);
+    t.setLevel(0.5);
+    t.setDepth(1, 2);
+
+    REQUIRE(t.isArmed());
+    auto frame = t.feed(makePack({0, 0, 1, 2, 0, 0, 1, 3}));
+    REQUIRE(frame != nullptr);
+    REQUIRE(frameData(frame) == QVector<double>({0, 1, 2}));
+    REQUIRE(!t.isArmed());
+
+    REQUIRE(t.feed(makePack({0, 1, 4, 0})) == nullptr);
+
+    t.arm();
+    frame = t.feed(makePack({0, 1, 5, 0}));
+    REQUIRE(frame != nullptr);
+    REQUIRE(frameData(frame) == QVector<double>({0, 1, 5}));
+}
+
+TEST_CASE("auto trigger mode", "[trigger]")
+{
+    Trigger t;
+    t.setLevel(0.5);
+    t.setDepth(1, 2);
+
+    SECTION("normal mode doesn't publish without trigger")
+    {
+        t.setMode(Trigger::Normal);
+        REQUIRE(t.feed(makePack({0, 0, 0, 0, 0})) == nullptr);
+    }
+
+    SECTION("auto mode publishes latest samples without trigger")
+    {
+        t.setMode(Trigger::Auto);
+        REQUIRE(t.feed(makePack({0, 0})) == nullptr);
+        auto frame = t.feed(makePack({-1, -2, -3}));
+        REQUIRE(frame != nullptr);
+        REQUIRE(frameData(frame) == QVector<double>({-1, -2, -3}));
+    }
+}
+
+TEST_CASE("stream should add only triggered frames", "[trigger, stream]")
+{
+    Stream s(1, false, 4);
+    TestSource so(1, false);
+    so.connectSink(&s);
+
+    TestSink follower;
+    s.connectFollower(&follower);
+
+    s.trigger()->setMode(Trigger::Normal);
+    s.trigger()->setLevel(0.5);
+    s.trigger()->setDepth(1, 3);
+    s.setTriggerEnabled(true);
+
+    so._feed(makePack({0, 0, 0}));
+    REQUIRE(s.totalSamples() == 0);
+    REQUIRE(follower.totalFed == 3);
+
+    so._feed(makePack({1, 2, 3, 0}));
+    REQUIRE(s.totalSamples() == 4);
+    REQUIRE(follower.totalFed == 7);
+
+    const FrameBuffer* y = s.channel(0)->yData();
+    REQUIRE(y->sample(0) == 0);
+    REQUIRE(y->sample(1) == 1);
+    REQUIRE(y->sample(2) == 2);
+    REQUIRE(y->sample(3) == 3);
+}